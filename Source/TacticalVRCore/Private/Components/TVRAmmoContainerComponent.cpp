@@ -0,0 +1,185 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#include "Components/TVRAmmoContainerComponent.h"
+
+#include "GripMotionControllerComponent.h"
+#include "Net/UnrealNetwork.h"
+#include "Player/TVRCharacter.h"
+#include "Weapon/TVRCartridge.h"
+
+namespace TVRAmmoContainer
+{
+	/** Radius of the overlap test that finds a container at a release location */
+	constexpr float FindRadius = 1.f;
+}
+
+UTVRAmmoContainerComponent::UTVRAmmoContainerComponent(const FObjectInitializer& OI) : Super(OI)
+{
+	SetIsReplicatedByDefault(true);
+
+	// the container is never really held, the grip is only used to hand out a cartridge on the server
+	VRGripInterfaceSettings.MovementReplicationType = EGripMovementReplicationSettings::ForceServerSideMovement;
+	VRGripInterfaceSettings.SecondaryGripType = ESecondaryGripType::SG_None;
+	VRGripInterfaceSettings.FreeDefaultGripType = EGripCollisionType::CustomGrip;
+	VRGripInterfaceSettings.SlotDefaultGripType = EGripCollisionType::CustomGrip;
+	VRGripInterfaceSettings.bSimulateOnDrop = false;
+	VRGripInterfaceSettings.bAllowMultipleGrips = true;
+
+	Capacity = 0;
+}
+
+void UTVRAmmoContainerComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	DOREPLIFETIME(UTVRAmmoContainerComponent, Contents);
+}
+
+void UTVRAmmoContainerComponent::OnGrip_Implementation(UGripMotionControllerComponent* GrippingHand,
+	const FBPActorGripInformation& GripInfo)
+{
+	Super::OnGrip_Implementation(GrippingHand, GripInfo);
+
+	if(GetOwner()->HasAuthority())
+	{
+		const TWeakObjectPtr<UGripMotionControllerComponent> WeakHand = GrippingHand;
+		GetWorld()->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &UTVRAmmoContainerComponent::HandOutCartridge, WeakHand));
+	}
+}
+
+void UTVRAmmoContainerComponent::HandOutCartridge(TWeakObjectPtr<UGripMotionControllerComponent> Hand)
+{
+	if(!Hand.IsValid())
+	{
+		return;
+	}
+	Hand->DropObjectByInterface(this, 0, FVector::ZeroVector, FVector::ZeroVector);
+	TakeCartridge(Hand.Get());
+}
+
+ATVRCartridge* UTVRAmmoContainerComponent::TakeCartridge(UGripMotionControllerComponent* Hand)
+{
+	if(Hand == nullptr || !GetOwner()->HasAuthority())
+	{
+		return nullptr;
+	}
+
+	const int32 EntryIdx = Contents.FindLastByPredicate([](const FTVRAmmoCount& Entry)
+	{
+		return Entry.CartridgeClass != nullptr && Entry.Count > 0;
+	});
+	if(EntryIdx == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	ATVRCartridge* Cartridge = GetWorld()->SpawnActor<ATVRCartridge>(Contents[EntryIdx].CartridgeClass, Hand->GetComponentTransform(), SpawnParams);
+	if(Cartridge == nullptr)
+	{
+		return nullptr;
+	}
+	Contents[EntryIdx].Count--;
+	OnRep_Contents();
+
+	if(ATVRCharacter* HandChar = Cast<ATVRCharacter>(Hand->GetOwner()))
+	{
+		FHitResult Hit;
+		Hit.ImpactPoint = Hand->GetComponentLocation();
+		Hit.Component = Cartridge->GetStaticMeshComponent();
+		HandChar->AttemptToGripObject(Cartridge, Hand, HandChar->GetOtherControllerHand(Hand), Hit);
+	}
+	return Cartridge;
+}
+
+bool UTVRAmmoContainerComponent::TryAbsorbCartridge(ATVRCartridge* Cartridge)
+{
+	if(Cartridge == nullptr || Cartridge->IsPendingKill() || Cartridge->bIsSpent || !GetOwner()->HasAuthority())
+	{
+		return false;
+	}
+	if(AddRounds(Cartridge->GetClass(), 1) == 0)
+	{
+		return false;
+	}
+	Cartridge->Destroy();
+	return true;
+}
+
+int32 UTVRAmmoContainerComponent::AddRounds(TSubclassOf<ATVRCartridge> CartridgeClass, int32 Num)
+{
+	if(!GetOwner()->HasAuthority() || !IsAllowedCartridge(CartridgeClass))
+	{
+		return 0;
+	}
+
+	const int32 NumToAdd = Capacity > 0 ? FMath::Min(Num, Capacity - GetRoundCount()) : Num;
+	if(NumToAdd <= 0)
+	{
+		return 0;
+	}
+
+	FTVRAmmoCount* Entry = Contents.FindByPredicate([CartridgeClass](const FTVRAmmoCount& TestEntry)
+	{
+		return TestEntry.CartridgeClass == CartridgeClass;
+	});
+	if(Entry)
+	{
+		Entry->Count += NumToAdd;
+	}
+	else
+	{
+		Contents.Add(FTVRAmmoCount(CartridgeClass, NumToAdd));
+	}
+	OnRep_Contents();
+	return NumToAdd;
+}
+
+bool UTVRAmmoContainerComponent::IsAllowedCartridge(TSubclassOf<ATVRCartridge> CartridgeClass) const
+{
+	if(CartridgeClass == nullptr)
+	{
+		return false;
+	}
+	return AllowedCartridges.Num() == 0 || AllowedCartridges.Contains(CartridgeClass);
+}
+
+int32 UTVRAmmoContainerComponent::GetRoundCount() const
+{
+	int32 Count = 0;
+	for(const FTVRAmmoCount& Entry: Contents)
+	{
+		Count += Entry.Count;
+	}
+	return Count;
+}
+
+UTVRAmmoContainerComponent* UTVRAmmoContainerComponent::FindContainerAt(const UObject* WorldContext, const FVector& Location)
+{
+	const UWorld* World = WorldContext ? WorldContext->GetWorld() : nullptr;
+	if(World == nullptr)
+	{
+		return nullptr;
+	}
+
+	TArray<FOverlapResult> Overlaps;
+	World->OverlapMultiByObjectType(Overlaps, Location, FQuat::Identity,
+		FCollisionObjectQueryParams(FCollisionObjectQueryParams::AllObjects),
+		FCollisionShape::MakeSphere(TVRAmmoContainer::FindRadius));
+	for(const FOverlapResult& Overlap: Overlaps)
+	{
+		if(UTVRAmmoContainerComponent* Container = Cast<UTVRAmmoContainerComponent>(Overlap.GetComponent()))
+		{
+			return Container;
+		}
+	}
+	return nullptr;
+}
+
+void UTVRAmmoContainerComponent::OnRep_Contents()
+{
+	if(EventOnContentsChanged.IsBound())
+	{
+		EventOnContentsChanged.Broadcast();
+	}
+}
@@ -2,6 +2,7 @@
 
 
 #include "Components/TVRGunHapticsComponent.h"
+#include "GameFramework/PlayerController.h"
 
 
 // Sets default values for this component's properties
@@ -35,6 +36,36 @@ APlayerController* UTVRGunHapticsComponent::GetOwnerPlayerController() const
 	return Cast<APlayerController>(GetOwner());
 }
 
+bool UTVRGunHapticsComponent::IsLocalOwner() const
+{
+	const APlayerController* PC = GetOwnerPlayerController();
+	return PC && PC->IsLocalController();
+}
+
+void UTVRGunHapticsComponent::PlayButtstockKick(uint8 Strength, float Duration)
+{
+	if(IsLocalOwner())
+	{
+		ButtstockKick(Strength, Duration);
+	}
+	else
+	{
+		ClientButtstockKick(Strength, Duration);
+	}
+}
+
+void UTVRGunHapticsComponent::PlayPistolKick(uint8 Strength, float Duration, ETVRLeftRight Type)
+{
+	if(IsLocalOwner())
+	{
+		PistolKick(Strength, Duration, Type);
+	}
+	else
+	{
+		ClientPistolKick(Strength, Duration, Type);
+	}
+}
+
 void UTVRGunHapticsComponent::ClientButtstockKick_Implementation(uint8 Strength, float Duration)
 {
 	ButtstockKick(Strength, Duration);
@@ -0,0 +1,145 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#include "Components/TVRHapticsMixerComponent.h"
+
+#include "GameFramework/PlayerController.h"
+
+namespace TVRHapticsMixer
+{
+	/** Changes below this are not sent to the device */
+	constexpr float ChangeTolerance = 0.005f;
+}
+
+UTVRHapticsMixerComponent::UTVRHapticsMixerComponent(const FObjectInitializer& OI) : Super(OI)
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	// mix after the sources have submitted their requests for this frame
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork;
+}
+
+void UTVRHapticsMixerComponent::TickComponent(float DeltaTime, ELevelTick TickType,
+	FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	APlayerController* PC = Cast<APlayerController>(GetOwner());
+	if(PC == nullptr || !PC->IsLocalController())
+	{
+		SetComponentTickEnabled(false);
+		return;
+	}
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	bool bAnyActive = false;
+	for(FHapticChannel& Channel: Channels)
+	{
+		bAnyActive |= UpdateChannel(Channel, PC, Now);
+	}
+	if(!bAnyActive)
+	{
+		SetComponentTickEnabled(false);
+	}
+}
+
+UTVRHapticsMixerComponent* UTVRHapticsMixerComponent::FindOrCreate(APlayerController* PC)
+{
+	if(PC == nullptr)
+	{
+		return nullptr;
+	}
+	UTVRHapticsMixerComponent* Mixer = PC->FindComponentByClass<UTVRHapticsMixerComponent>();
+	if(Mixer == nullptr)
+	{
+		Mixer = NewObject<UTVRHapticsMixerComponent>(PC, FName(TEXT("HapticsMixer")));
+		Mixer->RegisterComponent();
+	}
+	return Mixer;
+}
+
+void UTVRHapticsMixerComponent::SubmitHaptics(EControllerHand Hand, float Amplitude, float Frequency, float Duration,
+	uint8 Priority, FName Source)
+{
+	FHapticChannel& Channel = GetChannel(Hand);
+	FHapticRequest* Request = nullptr;
+	if(Source != NAME_None)
+	{
+		Request = Channel.Requests.FindByPredicate([Source](const FHapticRequest& Entry)
+		{
+			return Entry.Source == Source;
+		});
+	}
+	if(Request == nullptr)
+	{
+		Request = &Channel.Requests.AddDefaulted_GetRef();
+		Request->Source = Source;
+	}
+
+	Request->Amplitude = FMath::Clamp(Amplitude, 0.f, 1.f);
+	Request->Frequency = FMath::Clamp(Frequency, 0.f, 1.f);
+	Request->EndTime = Duration > 0.f ? GetWorld()->GetTimeSeconds() + Duration : -1.f;
+	Request->Priority = Priority;
+	SetComponentTickEnabled(true);
+}
+
+void UTVRHapticsMixerComponent::ClearHaptics(EControllerHand Hand, FName Source)
+{
+	FHapticChannel& Channel = GetChannel(Hand);
+	Channel.Requests.RemoveAll([Source](const FHapticRequest& Entry)
+	{
+		return Entry.Source == Source;
+	});
+	// the channel may need to be silenced
+	SetComponentTickEnabled(true);
+}
+
+UTVRHapticsMixerComponent::FHapticChannel& UTVRHapticsMixerComponent::GetChannel(EControllerHand Hand)
+{
+	for(FHapticChannel& Channel: Channels)
+	{
+		if(Channel.Hand == Hand)
+		{
+			return Channel;
+		}
+	}
+	FHapticChannel& NewChannel = Channels.AddDefaulted_GetRef();
+	NewChannel.Hand = Hand;
+	NewChannel.SubmittedAmplitude = 0.f;
+	NewChannel.SubmittedFrequency = 0.f;
+	return NewChannel;
+}
+
+bool UTVRHapticsMixerComponent::UpdateChannel(FHapticChannel& Channel, APlayerController* PC, float Now)
+{
+	Channel.Requests.RemoveAll([Now](const FHapticRequest& Entry)
+	{
+		return Entry.EndTime >= 0.f && Entry.EndTime < Now;
+	});
+
+	const FHapticRequest* Strongest = nullptr;
+	for(const FHapticRequest& Request: Channel.Requests)
+	{
+		if(Strongest == nullptr || Request.Priority > Strongest->Priority
+			|| (Request.Priority == Strongest->Priority && Request.Amplitude > Strongest->Amplitude))
+		{
+			Strongest = &Request;
+		}
+	}
+	const float Amplitude = Strongest ? Strongest->Amplitude : 0.f;
+	const float Frequency = Strongest ? Strongest->Frequency : 0.f;
+
+	if(!FMath::IsNearlyEqual(Amplitude, Channel.SubmittedAmplitude, TVRHapticsMixer::ChangeTolerance)
+		|| !FMath::IsNearlyEqual(Frequency, Channel.SubmittedFrequency, TVRHapticsMixer::ChangeTolerance))
+	{
+		PC->SetHapticsByValue(Frequency, Amplitude, Channel.Hand);
+		Channel.SubmittedAmplitude = Amplitude;
+		Channel.SubmittedFrequency = Frequency;
+	}
+
+	// requests without duration were only meant for this frame
+	Channel.Requests.RemoveAll([](const FHapticRequest& Entry)
+	{
+		return Entry.EndTime < 0.f;
+	});
+	return Channel.Requests.Num() > 0 || Channel.SubmittedAmplitude > 0.f;
+}
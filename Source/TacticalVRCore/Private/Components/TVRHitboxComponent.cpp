@@ -0,0 +1,93 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#include "Components/TVRHitboxComponent.h"
+
+#include "Components/SkinnedMeshComponent.h"
+#include "Subsystems/TVRHitboxSubsystem.h"
+#include "TacticalTraceChannels.h"
+
+UTVRHitboxComponent::UTVRHitboxComponent(const FObjectInitializer& OI) : Super(OI)
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	PhysicalMaterial = nullptr;
+	bIgnoreWeaponTraceChannel = true;
+	HitboxMesh = nullptr;
+
+	DamageMultipliers.Add(ETVRHitZone::Head, 4.f);
+	DamageMultipliers.Add(ETVRHitZone::Torso, 1.f);
+	DamageMultipliers.Add(ETVRHitZone::Arm, 0.75f);
+	DamageMultipliers.Add(ETVRHitZone::Leg, 0.75f);
+}
+
+void UTVRHitboxComponent::BeginPlay()
+{
+	Super::BeginPlay();
+	if(HitboxMesh == nullptr)
+	{
+		HitboxMesh = GetOwner()->FindComponentByClass<USkinnedMeshComponent>();
+	}
+
+	if(bIgnoreWeaponTraceChannel)
+	{
+		TInlineComponentArray<UPrimitiveComponent*> Primitives(GetOwner());
+		for(UPrimitiveComponent* Prim: Primitives)
+		{
+			Prim->SetCollisionResponseToChannel(ECC_WeaponTraceChannel, ECR_Ignore);
+		}
+	}
+
+	if(UTVRHitboxSubsystem* Hitboxes = GetWorld()->GetSubsystem<UTVRHitboxSubsystem>())
+	{
+		Hitboxes->RegisterHitboxes(this);
+	}
+}
+
+void UTVRHitboxComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if(UTVRHitboxSubsystem* Hitboxes = GetWorld()->GetSubsystem<UTVRHitboxSubsystem>())
+	{
+		Hitboxes->UnregisterHitboxes(this);
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
+void UTVRHitboxComponent::SetHitboxMesh(USkinnedMeshComponent* NewMesh)
+{
+	HitboxMesh = NewMesh;
+}
+
+float UTVRHitboxComponent::GetDamageMultiplier(ETVRHitZone Zone) const
+{
+	if(const float* Multiplier = DamageMultipliers.Find(Zone))
+	{
+		return *Multiplier;
+	}
+	return 1.f;
+}
+
+ETVRHitZone UTVRHitboxComponent::GetHitZone(const FHitResult& Hit)
+{
+	if(AActor* HitActor = Hit.GetActor())
+	{
+		if(const UTVRHitboxComponent* HitboxComp = HitActor->FindComponentByClass<UTVRHitboxComponent>())
+		{
+			// hitbox hits store the capsule index in MyItem, which physics traces leave unset
+			if(HitboxComp->Capsules.IsValidIndex(Hit.MyItem) && HitboxComp->Capsules[Hit.MyItem].BoneName == Hit.BoneName)
+			{
+				return HitboxComp->Capsules[Hit.MyItem].Zone;
+			}
+			// MyItem does not survive replication of the hit, so fall back to the bone
+			if(Hit.BoneName != NAME_None)
+			{
+				for(const FTVRHitboxCapsule& Capsule: HitboxComp->Capsules)
+				{
+					if(Capsule.BoneName == Hit.BoneName)
+					{
+						return Capsule.Zone;
+					}
+				}
+			}
+		}
+	}
+	return ETVRHitZone::None;
+}
@@ -0,0 +1,72 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#include "Net/TVRNetRelevancyPolicy.h"
+#include "VRGripInterface.h"
+
+void FTVRNetRelevancyPolicy::Apply(AActor* Actor) const
+{
+	Actor->NetCullDistanceSquared = FMath::Square(LooseNetCullDistance);
+	if(!bDormantWhenIdle && Actor->NetDormancy > DORM_Awake)
+	{
+		Actor->SetNetDormancy(DORM_Awake);
+	}
+}
+
+bool FTVRNetRelevancyPolicy::IsNetRelevantFor(const AActor* Actor, const AActor* RealViewer, const AActor* ViewTarget,
+	const FVector& SrcLocation) const
+{
+	if(Actor->bAlwaysRelevant || Actor->IsOwnedBy(ViewTarget) || Actor->IsOwnedBy(RealViewer) || Actor == ViewTarget)
+	{
+		return true;
+	}
+	
+	if(bFollowOwnerRelevancy && !IsLoose(Actor))
+	{
+		if(const AActor* AttachParent = Actor->GetAttachParentActor())
+		{
+			return AttachParent->IsNetRelevantFor(RealViewer, ViewTarget, SrcLocation);
+		}
+		if(const AActor* Owner = Actor->GetOwner())
+		{
+			return Owner->IsNetRelevantFor(RealViewer, ViewTarget, SrcLocation);
+		}
+	}
+
+	if(Actor->IsHidden() && (!Actor->GetRootComponent() || !Actor->GetRootComponent()->IsCollisionEnabled()))
+	{
+		return false;
+	}
+	return FVector::DistSquared(SrcLocation, Actor->GetActorLocation()) < Actor->NetCullDistanceSquared;
+}
+
+void FTVRNetRelevancyPolicy::Wake(AActor* Actor) const
+{
+	if(Actor->HasAuthority() && Actor->NetDormancy > DORM_Awake)
+	{
+		Actor->SetNetDormancy(DORM_Awake);
+	}
+}
+
+void FTVRNetRelevancyPolicy::TrySleep(AActor* Actor) const
+{
+	if(bDormantWhenIdle && Actor->HasAuthority() && IsLoose(Actor))
+	{
+		Actor->SetNetDormancy(DORM_DormantAll);
+	}
+}
+
+bool FTVRNetRelevancyPolicy::IsLoose(const AActor* Actor)
+{
+	if(Actor->GetAttachParentActor())
+	{
+		return false;
+	}
+	if(Actor->GetClass()->ImplementsInterface(UVRGripInterface::StaticClass()))
+	{
+		TArray<FBPGripPair> HoldingControllers;
+		bool bIsHeld = false;
+		IVRGripInterface::Execute_IsHeld(const_cast<AActor*>(Actor), HoldingControllers, bIsHeld);
+		return !bIsHeld;
+	}
+	return true;
+}
@@ -0,0 +1,48 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#include "Net/TVRReplicationGraphNode_Grippables.h"
+
+void UTVRReplicationGraphNode_Grippables::NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo)
+{
+	GrippableActors.AddUnique(ActorInfo.Actor);
+}
+
+bool UTVRReplicationGraphNode_Grippables::NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound)
+{
+	const bool bRemoved = GrippableActors.RemoveSwap(ActorInfo.Actor) > 0;
+	if(!bRemoved && bWarnIfNotFound)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Tried to remove %s from grippable node, but it was not found"), *GetNameSafe(ActorInfo.Actor));
+	}
+	return bRemoved;
+}
+
+void UTVRReplicationGraphNode_Grippables::NotifyResetAllNetworkActors()
+{
+	GrippableActors.Reset();
+}
+
+void UTVRReplicationGraphNode_Grippables::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	RelevantActorList.Reset();
+	for(AActor* Actor : GrippableActors)
+	{
+		if(Actor == nullptr || Actor->IsPendingKill())
+		{
+			continue;
+		}
+		for(const FNetViewer& Viewer : Params.Viewers)
+		{
+			if(Actor->IsNetRelevantFor(Viewer.InViewer, Viewer.ViewTarget, Viewer.ViewLocation))
+			{
+				RelevantActorList.Add(Actor);
+				break;
+			}
+		}
+	}
+	
+	if(RelevantActorList.Num() > 0)
+	{
+		Params.OutGatheredReplicationLists.AddReplicationActorList(RelevantActorList);
+	}
+}
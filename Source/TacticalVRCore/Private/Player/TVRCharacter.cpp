@@ -548,11 +548,19 @@ void ATVRCharacter::OnAxisMoveY(float Value)
 void ATVRCharacter::OnTriggerAxisL(float Value)
 {
 	TriggerAxisL = FMath::Clamp(Value, 0.f, 1.f);
+	if(OnTriggerAxisSample.IsBound())
+	{
+		OnTriggerAxisSample.Broadcast(EControllerHand::Left, TriggerAxisL, FPlatformTime::Seconds());
+	}
 }
 
 void ATVRCharacter::OnTriggerAxisR(float Value)
 {
 	TriggerAxisR = FMath::Clamp(Value, 0.f, 1.f);
+	if(OnTriggerAxisSample.IsBound())
+	{
+		OnTriggerAxisSample.Broadcast(EControllerHand::Right, TriggerAxisR, FPlatformTime::Seconds());
+	}
 }
 
 void ATVRCharacter::StartSnapTurn(ETurnDirection TurnDir)
@@ -3,7 +3,10 @@
 #include "Player/TVRPlayerController.h"
 
 #include "Settings/TVRCoreGameplaySettings.h"
+#include "Settings/TVRCoreWeaponSettings.h"
 #include "Components/TVRGunHapticsComponent.h"
+#include "Subsystems/TVRFlyBySubsystem.h"
+#include "Weapon/Component/TVRGunFireComponent.h"
 
 
 void ATVRPlayerController::BeginPlay()
@@ -17,3 +20,54 @@ UTVRGunHapticsComponent* ATVRPlayerController::GetGunHapticsComponent_Implementa
 {
 	return FindComponentByClass<UTVRGunHapticsComponent>();
 }
+
+void ATVRPlayerController::ClientSimulateGunFire_Implementation(UTVRGunFireComponent* FiringComponent,
+	FVector_NetQuantize Location, TSubclassOf<AActor> WeaponClass)
+{
+	if(FiringComponent)
+	{
+		FiringComponent->ReceiveSimulateFire();
+	}
+	else if(OnDistantGunfire.IsBound())
+	{
+		// the gun is dormant or not relevant for us, so we can only play the location based event
+		OnDistantGunfire.Broadcast(Location, WeaponClass);
+	}
+}
+
+void ATVRPlayerController::ClientSimulateGunHit_Implementation(UTVRGunFireComponent* FiringComponent,
+	const FHitResult& Hit, TSubclassOf<ATVRCartridge> Cartridge)
+{
+	if(Cartridge == nullptr)
+	{
+		return;
+	}
+	
+	if(FiringComponent)
+	{
+		FiringComponent->ReceiveSimulateHit(Hit, Cartridge);
+	}
+	else
+	{
+		// the gun is dormant or not relevant for us, the hit carries everything needed for the effects
+		if(UTVRFlyBySubsystem* FlyBy = GetWorld()->GetSubsystem<UTVRFlyBySubsystem>())
+		{
+			FlyBy->AddShotSegment(Hit.TraceStart, Hit.ImpactPoint, Cartridge, nullptr);
+		}
+		UTVRGunFireComponent::SimulateImpact(GetWorld(), Hit, Cartridge);
+	}
+}
+
+void ATVRPlayerController::ClientDistantGunfire_Implementation(FVector_NetQuantize Location, TSubclassOf<AActor> WeaponClass)
+{
+	if(OnDistantGunfire.IsBound())
+	{
+		OnDistantGunfire.Broadcast(Location, WeaponClass);
+	}
+}
+
+bool ATVRPlayerController::ConsumeWeaponRpcToken()
+{
+	const UTVRCoreWeaponSettings* Settings = UTVRCoreWeaponSettings::Get();
+	return WeaponRpcBucket.TryConsume(GetWorld()->GetRealTimeSeconds(), Settings->MaxWeaponRpcsPerSecond, Settings->WeaponRpcBurst);
+}
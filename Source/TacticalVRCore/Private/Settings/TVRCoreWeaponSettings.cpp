@@ -0,0 +1,42 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#include "Settings/TVRCoreWeaponSettings.h"
+
+UTVRCoreWeaponSettings::UTVRCoreWeaponSettings(const FObjectInitializer& OI) : Super(OI)
+{
+	ProjectileFixedStep = 1.f / 60.f;
+	MaxProjectileStepsPerFrame = 4;
+	ProjectileBatchSize = 64;
+	MaxProjectiles = 8192;
+	bAggregateDamage = true;
+	MaxImpactDecals = 128;
+	MaxImpactEffectsPerFrame = 8;
+	ImpactMergeRadius = 5.f;
+	ImpactMergeTime = 0.1f;
+	MaxImpactEffectDistance = 5000.f;
+	ImpactDecalFadeScreenSize = 0.0025f;
+	MaxImpactVoices = 16;
+	MaxImpactVoicesPerSurface = 4;
+	MaxImpactAudioDistance = 4000.f;
+	CasingClinkMinInterval = 0.08f;
+	CasingClinkPriorityScale = 0.5f;
+	MaxFlyBysPerListener = 2;
+	MaxWeaponRpcsPerSecond = 120.f;
+	WeaponRpcBurst = 60.f;
+	bValidateClientHits = true;
+	HitReportBurstShots = 2.f;
+	HitReportDelayTolerance = 1.f;
+	HitReportDistanceTolerance = 300.f;
+	bTimeSliceGunWarmup = true;
+	GunWarmupBudgetMs = 2.f;
+	MaxPooledGunsPerClass = 8;
+	ProxyHydrateRadius = 75.f;
+	ProxyDehydrateDelay = 60.f;
+	MaxLooseMagazines = 24;
+	MaxRecycledMagazinesPerClass = 4;
+}
+
+UTVRCoreWeaponSettings* UTVRCoreWeaponSettings::Get()
+{
+	return GetMutableDefault<UTVRCoreWeaponSettings>();
+}
@@ -0,0 +1,199 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#include "Subsystems/TVRBallisticsSubsystem.h"
+
+#include "Async/ParallelFor.h"
+#include "Settings/TVRCoreWeaponSettings.h"
+#include "Subsystems/TVRHitboxSubsystem.h"
+#include "TacticalTraceChannels.h"
+#include "Weapon/Component/TVRGunFireComponent.h"
+
+namespace TVRBallistics
+{
+	enum EStepFlags : uint8
+	{
+		None = 0,
+		Hit = 1,
+		Expired = 2
+	};
+}
+
+UTVRBallisticsSubsystem::UTVRBallisticsSubsystem()
+{
+	TimeAccumulator = 0.f;
+}
+
+void UTVRBallisticsSubsystem::Deinitialize()
+{
+	Positions.Empty();
+	Velocities.Empty();
+	DragCoefficients.Empty();
+	GravityScales.Empty();
+	LifeTimes.Empty();
+	FiringComponents.Empty();
+	Cartridges.Empty();
+	IgnoredActors.Empty();
+	Shooters.Empty();
+	StepShooters.Empty();
+	StepHits.Empty();
+	StepFlags.Empty();
+	Super::Deinitialize();
+}
+
+bool UTVRBallisticsSubsystem::IsTickable() const
+{
+	return !HasAnyFlags(RF_ClassDefaultObject) && Positions.Num() > 0;
+}
+
+TStatId UTVRBallisticsSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTVRBallisticsSubsystem, STATGROUP_Tickables);
+}
+
+bool UTVRBallisticsSubsystem::LaunchProjectile(const FTVRProjectileLaunchParams& Params)
+{
+	if(Positions.Num() >= UTVRCoreWeaponSettings::Get()->MaxProjectiles)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("Projectile limit reached, projectile was not launched"));
+		return false;
+	}
+	
+	if(Positions.Num() == 0)
+	{
+		TimeAccumulator = 0.f;
+	}
+	
+	Positions.Add(Params.Origin);
+	Velocities.Add(Params.Velocity);
+	DragCoefficients.Add(Params.DragCoefficient);
+	GravityScales.Add(Params.GravityScale);
+	LifeTimes.Add(Params.LifeTime);
+	FiringComponents.Add(Params.FiringComponent);
+	Cartridges.Add(Params.Cartridge);
+	IgnoredActors.Add(Params.IgnoredActors);
+	Shooters.Add(Params.Shooter);
+	return true;
+}
+
+void UTVRBallisticsSubsystem::Tick(float DeltaTime)
+{
+	const UTVRCoreWeaponSettings* Settings = UTVRCoreWeaponSettings::Get();
+	const float FixedStep = FMath::Max(Settings->ProjectileFixedStep, 0.001f);
+	
+	TimeAccumulator += DeltaTime;
+	int32 NumSteps = 0;
+	while(TimeAccumulator >= FixedStep && NumSteps < Settings->MaxProjectileStepsPerFrame && Positions.Num() > 0)
+	{
+		StepSimulation(FixedStep);
+		TimeAccumulator -= FixedStep;
+		NumSteps++;
+	}
+	
+	if(NumSteps >= Settings->MaxProjectileStepsPerFrame)
+	{
+		// we could not catch up, drop the remaining time instead of spiraling
+		TimeAccumulator = FMath::Min(TimeAccumulator, FixedStep);
+	}
+}
+
+void UTVRBallisticsSubsystem::StepSimulation(float StepTime)
+{
+	UWorld* World = GetWorld();
+	const int32 NumProjectiles = Positions.Num();
+	const int32 BatchSize = FMath::Max(UTVRCoreWeaponSettings::Get()->ProjectileBatchSize, 1);
+	const int32 NumBatches = FMath::DivideAndRoundUp(NumProjectiles, BatchSize);
+	const FVector Gravity(0.f, 0.f, World->GetGravityZ());
+
+	StepHits.SetNum(NumProjectiles, false);
+	StepFlags.SetNumUninitialized(NumProjectiles, false);
+
+	// the hitbox BVH is built lazily on the first query of a frame, after that raycasts are read only
+	UTVRHitboxSubsystem* Hitboxes = World->GetSubsystem<UTVRHitboxSubsystem>();
+	const bool bTestHitboxes = Hitboxes && Hitboxes->HasHitboxes();
+	if(bTestHitboxes)
+	{
+		Hitboxes->PrepareQueries();
+		StepShooters.SetNumUninitialized(NumProjectiles, false);
+		for(int32 i = 0; i < NumProjectiles; i++)
+		{
+			StepShooters[i] = Shooters[i].Get();
+		}
+	}
+
+	// Scene queries are read only, so the traces can run from the worker threads just like async traces do
+	ParallelFor(NumBatches, [&](int32 BatchIdx)
+	{
+		const int32 Start = BatchIdx * BatchSize;
+		const int32 End = FMath::Min(Start + BatchSize, NumProjectiles);
+		for(int32 i = Start; i < End; i++)
+		{
+			const FVector PrevPosition = Positions[i];
+			FVector& Velocity = Velocities[i];
+			const FVector Drag = Velocity * (-DragCoefficients[i] * Velocity.Size());
+			Velocity += (Gravity * GravityScales[i] + Drag) * StepTime;
+			const FVector NewPosition = PrevPosition + Velocity * StepTime;
+			Positions[i] = NewPosition;
+			LifeTimes[i] -= StepTime;
+
+			FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(TVRProjectileTrace), true);
+			QueryParams.bReturnPhysicalMaterial = true;
+			for(const uint32 IgnoredActorId : IgnoredActors[i])
+			{
+				QueryParams.AddIgnoredActor(IgnoredActorId);
+			}
+			
+			// test the hitboxes first, the physics scene only needs to be traced up to the hitbox
+			FHitResult& Hit = StepHits[i];
+			const bool bHitHitbox = bTestHitboxes && Hitboxes->RaycastHitboxes(Hit, PrevPosition, NewPosition, QueryParams, StepShooters[i]);
+			const FVector TraceEnd = bHitHitbox ? FVector(Hit.ImpactPoint) : NewPosition;
+			FHitResult PhysicsHit;
+			if(World->LineTraceSingleByChannel(PhysicsHit, PrevPosition, TraceEnd, ECC_WeaponTraceChannel, QueryParams))
+			{
+				Hit = PhysicsHit;
+				StepFlags[i] = TVRBallistics::Hit;
+			}
+			else if(bHitHitbox)
+			{
+				StepFlags[i] = TVRBallistics::Hit;
+			}
+			else
+			{
+				StepFlags[i] = LifeTimes[i] <= 0.f ? TVRBallistics::Expired : TVRBallistics::None;
+			}
+		}
+	}, NumBatches <= 1);
+
+	// Route hits back through the firing components. This may launch new projectiles, so we only look at the old ones
+	for(int32 i = 0; i < NumProjectiles; i++)
+	{
+		if(StepFlags[i] == TVRBallistics::Hit)
+		{
+			if(UTVRGunFireComponent* FiringComp = FiringComponents[i].Get())
+			{
+				FiringComp->ReceiveProjectileHit(StepHits[i], Cartridges[i]);
+			}
+		}
+	}
+
+	// Remove from the back, so that swapped in projectiles are already processed
+	for(int32 i = NumProjectiles - 1; i >= 0; i--)
+	{
+		if(StepFlags[i] != TVRBallistics::None)
+		{
+			RemoveProjectileAtSwap(i);
+		}
+	}
+}
+
+void UTVRBallisticsSubsystem::RemoveProjectileAtSwap(int32 Index)
+{
+	Positions.RemoveAtSwap(Index, 1, false);
+	Velocities.RemoveAtSwap(Index, 1, false);
+	DragCoefficients.RemoveAtSwap(Index, 1, false);
+	GravityScales.RemoveAtSwap(Index, 1, false);
+	LifeTimes.RemoveAtSwap(Index, 1, false);
+	FiringComponents.RemoveAtSwap(Index, 1, false);
+	Cartridges.RemoveAtSwap(Index, 1, false);
+	IgnoredActors.RemoveAtSwap(Index, 1, false);
+	Shooters.RemoveAtSwap(Index, 1, false);
+}
@@ -0,0 +1,133 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#include "Subsystems/TVRDamageQueueSubsystem.h"
+
+#include "GameFramework/DamageType.h"
+#include "Kismet/GameplayStatics.h"
+#include "Settings/TVRCoreWeaponSettings.h"
+
+void UTVRDamageQueueSubsystem::Deinitialize()
+{
+	PendingDamage.Empty();
+	HeldCausers.Empty();
+	Super::Deinitialize();
+}
+
+void UTVRDamageQueueSubsystem::Tick(float DeltaTime)
+{
+	Flush();
+}
+
+bool UTVRDamageQueueSubsystem::IsTickable() const
+{
+	return !HasAnyFlags(RF_ClassDefaultObject) && PendingDamage.Num() > 0;
+}
+
+TStatId UTVRDamageQueueSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTVRDamageQueueSubsystem, STATGROUP_Tickables);
+}
+
+void UTVRDamageQueueSubsystem::QueuePointDamage(AActor* Victim, float Damage, const FVector& ShotDirection,
+	const FHitResult& Hit, AController* EventInstigator, AActor* DamageCauser, TSubclassOf<UDamageType> DamageTypeClass)
+{
+	if(Victim == nullptr || Damage == 0.f)
+	{
+		return;
+	}
+	
+	if(!UTVRCoreWeaponSettings::Get()->bAggregateDamage)
+	{
+		UGameplayStatics::ApplyPointDamage(Victim, Damage, ShotDirection, Hit, EventInstigator, DamageCauser, DamageTypeClass);
+		return;
+	}
+
+	FPendingDamage* Pending = PendingDamage.FindByPredicate([Victim, DamageCauser](const FPendingDamage& Entry)
+	{
+		return Entry.Victim.Get() == Victim && Entry.DamageCauser.Get() == DamageCauser;
+	});
+	if(Pending == nullptr)
+	{
+		Pending = &PendingDamage.AddDefaulted_GetRef();
+		Pending->Victim = Victim;
+		Pending->EventInstigator = EventInstigator;
+		Pending->DamageCauser = DamageCauser;
+		Pending->Event.DamageTypeClass = DamageTypeClass ? DamageTypeClass : TSubclassOf<UDamageType>(UDamageType::StaticClass());
+		Pending->Event.Damage = 0.f;
+	}
+
+	FTVRDamageHit& DamageHit = Pending->Event.Hits.AddDefaulted_GetRef();
+	DamageHit.Damage = Damage;
+	DamageHit.ShotDirection = ShotDirection;
+	DamageHit.Hit = Hit;
+	Pending->Event.Damage += Damage;
+}
+
+void UTVRDamageQueueSubsystem::HoldDamage(AActor* DamageCauser)
+{
+	if(DamageCauser)
+	{
+		HeldCausers.FindOrAdd(DamageCauser)++;
+	}
+}
+
+void UTVRDamageQueueSubsystem::ReleaseDamage(AActor* DamageCauser)
+{
+	if(int32* NumHolds = HeldCausers.Find(DamageCauser))
+	{
+		if(--(*NumHolds) <= 0)
+		{
+			HeldCausers.Remove(DamageCauser);
+		}
+	}
+}
+
+bool UTVRDamageQueueSubsystem::IsDamageHeld(AActor* DamageCauser) const
+{
+	return DamageCauser && HeldCausers.Contains(DamageCauser);
+}
+
+void UTVRDamageQueueSubsystem::Flush()
+{
+	// causers that were destroyed while holding would keep their damage forever
+	for(auto It = HeldCausers.CreateIterator(); It; ++It)
+	{
+		if(!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+	
+	// reactions to the damage may queue new damage, that will be applied in the next flush
+	TArray<FPendingDamage> DamageToApply = MoveTemp(PendingDamage);
+	PendingDamage.Reset();
+	
+	for(FPendingDamage& Pending: DamageToApply)
+	{
+		if(IsDamageHeld(Pending.DamageCauser.Get()))
+		{
+			PendingDamage.Add(MoveTemp(Pending));
+			continue;
+		}
+		
+		AActor* Victim = Pending.Victim.Get();
+		if(Victim == nullptr || Victim->IsPendingKillPending() || Pending.Event.Damage == 0.f)
+		{
+			continue;
+		}
+
+		// the point damage part of the event describes the strongest hit
+		const FTVRDamageHit* StrongestHit = &Pending.Event.Hits[0];
+		for(const FTVRDamageHit& DamageHit: Pending.Event.Hits)
+		{
+			if(DamageHit.Damage > StrongestHit->Damage)
+			{
+				StrongestHit = &DamageHit;
+			}
+		}
+		Pending.Event.HitInfo = StrongestHit->Hit;
+		Pending.Event.ShotDirection = StrongestHit->ShotDirection;
+		
+		Victim->TakeDamage(Pending.Event.Damage, Pending.Event, Pending.EventInstigator.Get(), Pending.DamageCauser.Get());
+	}
+}
@@ -0,0 +1,90 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#include "Subsystems/TVRFXPreloadSubsystem.h"
+
+#include "Settings/TVRCoreWeaponSettings.h"
+#include "Weapon/TVRCartridge.h"
+#include "Weapon/TVRGunBase.h"
+#include "Weapon/Component/TVRMagazineCompInterface.h"
+
+void UTVRFXPreloadSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	if(!ShouldLoadFX())
+	{
+		return;
+	}
+
+	const UTVRCoreWeaponSettings* Settings = UTVRCoreWeaponSettings::Get();
+	TArray<FSoftObjectPath> FallbackAssets;
+	for(const FSoftObjectPath& Asset: {Settings->FallbackImpactParticle.ToSoftObjectPath(),
+		Settings->FallbackImpactDecal.ToSoftObjectPath(), Settings->FallbackImpactSound.ToSoftObjectPath()})
+	{
+		if(Asset.IsValid())
+		{
+			FallbackAssets.Add(Asset);
+		}
+	}
+	if(FallbackAssets.Num() > 0)
+	{
+		FallbackHandle = StreamableManager.RequestAsyncLoad(FallbackAssets, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+	}
+}
+
+void UTVRFXPreloadSubsystem::Deinitialize()
+{
+	for(const auto& Handle: CartridgeHandles)
+	{
+		if(Handle.Value.IsValid())
+		{
+			Handle.Value->ReleaseHandle();
+		}
+	}
+	CartridgeHandles.Empty();
+	if(FallbackHandle.IsValid())
+	{
+		FallbackHandle->ReleaseHandle();
+		FallbackHandle.Reset();
+	}
+	Super::Deinitialize();
+}
+
+void UTVRFXPreloadSubsystem::RequestCartridgeFX(TSubclassOf<ATVRCartridge> Cartridge)
+{
+	if(Cartridge == nullptr || CartridgeHandles.Contains(Cartridge) || !ShouldLoadFX())
+	{
+		return;
+	}
+
+	TArray<FSoftObjectPath> Assets;
+	GetDefault<ATVRCartridge>(Cartridge)->GetFXAssets(Assets);
+	// an empty bundle is stored as well, so the cartridge is not collected again
+	CartridgeHandles.Add(Cartridge, Assets.Num() > 0 ? StreamableManager.RequestAsyncLoad(Assets) : nullptr);
+}
+
+void UTVRFXPreloadSubsystem::RequestGunFX(const ATVRGunBase* Gun)
+{
+	if(Gun == nullptr || Gun->GetMagInterface() == nullptr)
+	{
+		return;
+	}
+
+	TArray<TSubclassOf<ATVRCartridge>> Cartridges;
+	Gun->GetMagInterface()->GetAllowedCatridges(Cartridges);
+	for(const TSubclassOf<ATVRCartridge>& Cartridge: Cartridges)
+	{
+		RequestCartridgeFX(Cartridge);
+	}
+}
+
+bool UTVRFXPreloadSubsystem::IsCartridgeFXLoaded(TSubclassOf<ATVRCartridge> Cartridge) const
+{
+	const TSharedPtr<FStreamableHandle>* Handle = CartridgeHandles.Find(Cartridge);
+	return Handle && (!Handle->IsValid() || (*Handle)->HasLoadCompleted());
+}
+
+bool UTVRFXPreloadSubsystem::ShouldLoadFX() const
+{
+	const UWorld* World = GetWorld();
+	return World && World->IsGameWorld() && World->GetNetMode() != NM_DedicatedServer;
+}
@@ -0,0 +1,131 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#include "Subsystems/TVRFlyBySubsystem.h"
+
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+#include "Player/TVRCharacter.h"
+#include "Settings/TVRCoreWeaponSettings.h"
+#include "Weapon/TVRCartridge.h"
+
+void UTVRFlyBySubsystem::Deinitialize()
+{
+	PendingSegments.Empty();
+	Candidates.Empty();
+	Super::Deinitialize();
+}
+
+void UTVRFlyBySubsystem::Tick(float DeltaTime)
+{
+	TArray<FListener> Listeners;
+	GatherListeners(Listeners);
+
+	const int32 MaxFlyBys = UTVRCoreWeaponSettings::Get()->MaxFlyBysPerListener;
+	for(const FListener& Listener: Listeners)
+	{
+		Candidates.Reset();
+		const AActor* ListenerPawn = Listener.Pawn.Get();
+		for(int32 SegIdx = 0; SegIdx < PendingSegments.Num(); SegIdx++)
+		{
+			const FShotSegment& Segment = PendingSegments[SegIdx];
+			if(ListenerPawn && Segment.Shooter.Get() == ListenerPawn)
+			{
+				continue;
+			}
+			const ATVRCartridge* CartridgeCDO = GetDefault<ATVRCartridge>(Segment.Cartridge);
+			const float MaxDist = CartridgeCDO->GetFlyByThresholdDistance();
+			const FVector NearestLoc = FMath::ClosestPointOnSegment(Listener.Location, Segment.Start, Segment.End);
+			const float DistSq = FVector::DistSquared(Listener.Location, NearestLoc);
+			if(DistSq <= MaxDist * MaxDist)
+			{
+				Candidates.Add({DistSq, NearestLoc, SegIdx});
+			}
+		}
+		if(Candidates.Num() == 0)
+		{
+			continue;
+		}
+
+		Candidates.Sort([](const FFlyByCandidate& A, const FFlyByCandidate& B)
+		{
+			return A.DistSq < B.DistSq;
+		});
+
+		// pellets of one shell and penetrating hits of one shot are heard as one fly-by
+		TArray<int32, TInlineAllocator<8>> PlayedSegments;
+		for(const FFlyByCandidate& Candidate: Candidates)
+		{
+			if(PlayedSegments.Num() >= MaxFlyBys)
+			{
+				break;
+			}
+			const FShotSegment& Segment = PendingSegments[Candidate.Segment];
+			const bool bAlreadyPlayed = PlayedSegments.ContainsByPredicate([this, &Segment](int32 PlayedIdx)
+			{
+				const FShotSegment& Played = PendingSegments[PlayedIdx];
+				return Played.Shooter == Segment.Shooter && Played.Cartridge == Segment.Cartridge;
+			});
+			if(bAlreadyPlayed)
+			{
+				continue;
+			}
+
+			PlayedSegments.Add(Candidate.Segment);
+			UGameplayStatics::PlaySoundAtLocation(this, GetDefault<ATVRCartridge>(Segment.Cartridge)->GetFlyBySound(),
+				Candidate.Location, FRotator::ZeroRotator, 1.f, 1.f, 0.f,
+				nullptr, nullptr, Listener.Pawn.Get());
+		}
+	}
+	PendingSegments.Reset();
+}
+
+bool UTVRFlyBySubsystem::IsTickable() const
+{
+	return !HasAnyFlags(RF_ClassDefaultObject) && PendingSegments.Num() > 0;
+}
+
+TStatId UTVRFlyBySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTVRFlyBySubsystem, STATGROUP_Tickables);
+}
+
+void UTVRFlyBySubsystem::AddShotSegment(const FVector& Start, const FVector& End, TSubclassOf<ATVRCartridge> Cartridge,
+	const AActor* Shooter)
+{
+	if(Cartridge == nullptr || GetWorld()->GetNetMode() == NM_DedicatedServer)
+	{
+		return;
+	}
+	// a fly-by without its sound loaded yet is skipped, there is no fallback for it
+	if(GetDefault<ATVRCartridge>(Cartridge)->GetFlyBySound() == nullptr)
+	{
+		return;
+	}
+	PendingSegments.Add({Start, End, Cartridge, Shooter});
+}
+
+void UTVRFlyBySubsystem::GatherListeners(TArray<FListener>& OutListeners) const
+{
+	for(FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if(PC == nullptr || !PC->IsLocalController())
+		{
+			continue;
+		}
+
+		FListener& Listener = OutListeners.AddDefaulted_GetRef();
+		Listener.Pawn = PC->GetPawn();
+		if(const ATVRCharacter* VRCharacter = Cast<ATVRCharacter>(PC->GetPawn()))
+		{
+			Listener.Location = VRCharacter->GetVRHeadLocation();
+		}
+		else
+		{
+			// spectators and other pawns hear from the audio listener
+			FVector FrontDir;
+			FVector RightDir;
+			PC->GetAudioListenerPosition(Listener.Location, FrontDir, RightDir);
+		}
+	}
+}
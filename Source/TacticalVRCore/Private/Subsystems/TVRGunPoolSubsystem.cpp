@@ -0,0 +1,62 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#include "Subsystems/TVRGunPoolSubsystem.h"
+
+#include "Settings/TVRCoreWeaponSettings.h"
+#include "Weapon/TVRGunBase.h"
+
+void UTVRGunPoolSubsystem::Deinitialize()
+{
+	PooledGuns.Empty();
+	Super::Deinitialize();
+}
+
+ATVRGunBase* UTVRGunPoolSubsystem::AcquireGun(TSubclassOf<ATVRGunBase> GunClass, const FTransform& Transform, AActor* NewOwner)
+{
+	if(GunClass == nullptr || GetWorld()->GetNetMode() == NM_Client)
+	{
+		return nullptr;
+	}
+
+	if(TArray<TWeakObjectPtr<ATVRGunBase>>* Pool = PooledGuns.Find(GunClass))
+	{
+		while(Pool->Num() > 0)
+		{
+			ATVRGunBase* Gun = Pool->Pop(false).Get();
+			if(Gun && !Gun->IsPendingKill())
+			{
+				Gun->SetOwner(NewOwner);
+				Gun->IssueFromPool(Transform);
+				return Gun;
+			}
+		}
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Owner = NewOwner;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	return GetWorld()->SpawnActor<ATVRGunBase>(GunClass, Transform, SpawnParams);
+}
+
+void UTVRGunPoolSubsystem::ReleaseGun(ATVRGunBase* Gun)
+{
+	if(Gun == nullptr || Gun->IsPooled() || !Gun->HasAuthority())
+	{
+		return;
+	}
+
+	TArray<TWeakObjectPtr<ATVRGunBase>>& Pool = PooledGuns.FindOrAdd(Gun->GetClass());
+	Pool.RemoveAllSwap([](const TWeakObjectPtr<ATVRGunBase>& PooledGun)
+	{
+		return !PooledGun.IsValid();
+	});
+	if(Pool.Num() >= UTVRCoreWeaponSettings::Get()->MaxPooledGunsPerClass)
+	{
+		Gun->Destroy();
+		return;
+	}
+
+	Gun->SetOwner(nullptr);
+	Gun->ReturnToPool();
+	Pool.Add(Gun);
+}
@@ -0,0 +1,90 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#include "Subsystems/TVRGunWarmupSubsystem.h"
+
+#include "GameFramework/PlayerController.h"
+#include "Settings/TVRCoreWeaponSettings.h"
+#include "Weapon/TVRGunBase.h"
+
+void UTVRGunWarmupSubsystem::Deinitialize()
+{
+	PendingGuns.Empty();
+	Super::Deinitialize();
+}
+
+void UTVRGunWarmupSubsystem::Tick(float DeltaTime)
+{
+	PendingGuns.RemoveAllSwap([](const TWeakObjectPtr<ATVRGunBase>& Gun)
+	{
+		// guns that were gripped already completed their warm-up
+		return !Gun.IsValid() || !Gun->IsWarmupPending();
+	});
+	if(PendingGuns.Num() == 0)
+	{
+		return;
+	}
+	SortPendingGuns();
+
+	const double Budget = UTVRCoreWeaponSettings::Get()->GunWarmupBudgetMs * 0.001;
+	const double StartTime = FPlatformTime::Seconds();
+	// at least one step per frame, so warm-up can't stall on slow machines
+	do
+	{
+		ATVRGunBase* Gun = PendingGuns.Last().Get();
+		if(Gun->WarmupStep())
+		{
+			PendingGuns.Pop(false);
+		}
+	}
+	while(PendingGuns.Num() > 0 && FPlatformTime::Seconds() - StartTime < Budget);
+}
+
+bool UTVRGunWarmupSubsystem::IsTickable() const
+{
+	return !HasAnyFlags(RF_ClassDefaultObject) && PendingGuns.Num() > 0;
+}
+
+TStatId UTVRGunWarmupSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTVRGunWarmupSubsystem, STATGROUP_Tickables);
+}
+
+void UTVRGunWarmupSubsystem::RegisterGun(ATVRGunBase* Gun)
+{
+	if(Gun)
+	{
+		PendingGuns.AddUnique(Gun);
+	}
+}
+
+void UTVRGunWarmupSubsystem::SortPendingGuns()
+{
+	TArray<FVector, TInlineAllocator<4>> PlayerLocations;
+	for(FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if(PC && PC->GetPawn())
+		{
+			PlayerLocations.Add(PC->GetPawn()->GetActorLocation());
+		}
+	}
+	if(PlayerLocations.Num() == 0)
+	{
+		return;
+	}
+
+	const auto GetPlayerDistSq = [&PlayerLocations](const TWeakObjectPtr<ATVRGunBase>& Gun)
+	{
+		const FVector GunLocation = Gun->GetActorLocation();
+		float MinDistSq = MAX_flt;
+		for(const FVector& PlayerLocation: PlayerLocations)
+		{
+			MinDistSq = FMath::Min(MinDistSq, FVector::DistSquared(GunLocation, PlayerLocation));
+		}
+		return MinDistSq;
+	};
+	PendingGuns.Sort([&GetPlayerDistSq](const TWeakObjectPtr<ATVRGunBase>& A, const TWeakObjectPtr<ATVRGunBase>& B)
+	{
+		return GetPlayerDistSq(A) > GetPlayerDistSq(B);
+	});
+}
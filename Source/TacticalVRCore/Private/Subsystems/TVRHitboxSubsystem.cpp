@@ -0,0 +1,386 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#include "Subsystems/TVRHitboxSubsystem.h"
+
+#include "Components/SkinnedMeshComponent.h"
+#include "Components/TVRHitboxComponent.h"
+
+namespace TVRHitbox
+{
+	constexpr int32 LeafSize = 4;
+
+	/**
+	 * Slab test of a segment (Start + Dir * T, T in [0, MaxT]) against a box
+	 * @returns true if the segment enters the box before MaxT
+	 */
+	bool SegmentIntersectsBox(const FBox& Box, const FVector& Start, const FVector& InvDir, float MaxT)
+	{
+		float TMin = 0.f;
+		float TMax = MaxT;
+		for(int32 Axis = 0; Axis < 3; Axis++)
+		{
+			const float T0 = (Box.Min[Axis] - Start[Axis]) * InvDir[Axis];
+			const float T1 = (Box.Max[Axis] - Start[Axis]) * InvDir[Axis];
+			TMin = FMath::Max(TMin, FMath::Min(T0, T1));
+			TMax = FMath::Min(TMax, FMath::Max(T0, T1));
+			if(TMin > TMax)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * Exact intersection of a ray with a capsule
+	 * @param Origin origin of the ray
+	 * @param Dir normalized direction of the ray
+	 * @param A start of the capsule segment
+	 * @param B end of the capsule segment
+	 * @param Radius radius of the capsule
+	 * @returns the distance along the ray or a negative value if there is no intersection
+	 */
+	float RayCapsule(const FVector& Origin, const FVector& Dir, const FVector& A, const FVector& B, float Radius)
+	{
+		const FVector BA = B - A;
+		const FVector OA = Origin - A;
+		const float BABA = BA | BA;
+		const float BARD = BA | Dir;
+		const float BAOA = BA | OA;
+		const float RDOA = Dir | OA;
+		const float OAOA = OA | OA;
+		const float RadiusSq = Radius * Radius;
+
+		// cylinder
+		const float QA = BABA - BARD * BARD;
+		if(QA > KINDA_SMALL_NUMBER)
+		{
+			const float QB = BABA * RDOA - BAOA * BARD;
+			const float QC = BABA * OAOA - BAOA * BAOA - RadiusSq * BABA;
+			const float H = QB * QB - QA * QC;
+			if(H < 0.f)
+			{
+				return -1.f;
+			}
+			const float T = (-QB - FMath::Sqrt(H)) / QA;
+			const float Y = BAOA + T * BARD;
+			if(Y > 0.f && Y < BABA)
+			{
+				return T;
+			}
+		}
+
+		// caps
+		float Closest = -1.f;
+		for(const FVector& Center : {A, B})
+		{
+			const FVector OC = Origin - Center;
+			const float SB = Dir | OC;
+			const float SC = (OC | OC) - RadiusSq;
+			const float H = SB * SB - SC;
+			if(H >= 0.f)
+			{
+				const float T = -SB - FMath::Sqrt(H);
+				if(T >= 0.f && (Closest < 0.f || T < Closest))
+				{
+					Closest = T;
+				}
+			}
+		}
+		return Closest;
+	}
+}
+
+UTVRHitboxSubsystem::UTVRHitboxSubsystem()
+{
+	LastUpdateFrame = MAX_uint64;
+}
+
+void UTVRHitboxSubsystem::Deinitialize()
+{
+	HitboxComponents.Empty();
+	WorldCapsules.Empty();
+	SortedCapsules.Empty();
+	Nodes.Empty();
+	Leaves.Empty();
+	Super::Deinitialize();
+}
+
+void UTVRHitboxSubsystem::RegisterHitboxes(UTVRHitboxComponent* HitboxComp)
+{
+	HitboxComponents.AddUnique(HitboxComp);
+	LastUpdateFrame = MAX_uint64;
+}
+
+void UTVRHitboxSubsystem::UnregisterHitboxes(UTVRHitboxComponent* HitboxComp)
+{
+	HitboxComponents.RemoveSwap(HitboxComp);
+	LastUpdateFrame = MAX_uint64;
+}
+
+void UTVRHitboxSubsystem::UpdateHitboxes()
+{
+	if(LastUpdateFrame == GFrameCounter)
+	{
+		return;
+	}
+	LastUpdateFrame = GFrameCounter;
+
+	WorldCapsules.Reset();
+	for(int32 CompIdx = 0; CompIdx < HitboxComponents.Num(); CompIdx++)
+	{
+		const UTVRHitboxComponent* HitboxComp = HitboxComponents[CompIdx];
+		if(HitboxComp == nullptr || !HitboxComp->IsActive())
+		{
+			continue;
+		}
+		const USkinnedMeshComponent* Mesh = HitboxComp->GetHitboxMesh();
+		const TArray<FTVRHitboxCapsule>& Capsules = HitboxComp->GetCapsules();
+		for(int32 CapsuleIdx = 0; CapsuleIdx < Capsules.Num(); CapsuleIdx++)
+		{
+			const FTVRHitboxCapsule& Capsule = Capsules[CapsuleIdx];
+			const FTransform BoneTransform = Mesh ? Mesh->GetSocketTransform(Capsule.BoneName)
+				: HitboxComp->GetOwner()->GetActorTransform();
+			FWorldCapsule& WorldCapsule = WorldCapsules.AddDefaulted_GetRef();
+			WorldCapsule.A = BoneTransform.TransformPosition(Capsule.Start);
+			WorldCapsule.B = BoneTransform.TransformPosition(Capsule.End);
+			WorldCapsule.Radius = Capsule.Radius * BoneTransform.GetMaximumAxisScale();
+			WorldCapsule.ComponentIndex = CompIdx;
+			WorldCapsule.CapsuleIndex = CapsuleIdx;
+		}
+	}
+
+	SortedCapsules.Reset(WorldCapsules.Num());
+	for(int32 i = 0; i < WorldCapsules.Num(); i++)
+	{
+		SortedCapsules.Add(i);
+	}
+	Nodes.Reset();
+	Leaves.Reset();
+	if(WorldCapsules.Num() > 0)
+	{
+		BuildNode(0, WorldCapsules.Num());
+	}
+}
+
+int32 UTVRHitboxSubsystem::BuildNode(int32 First, int32 Num)
+{
+	const int32 NodeIdx = Nodes.AddUninitialized();
+	FBox Bounds(ForceInit);
+	FBox CenterBounds(ForceInit);
+	for(int32 i = First; i < First + Num; i++)
+	{
+		const FWorldCapsule& Capsule = WorldCapsules[SortedCapsules[i]];
+		const FVector Extent(Capsule.Radius);
+		Bounds += FBox(Capsule.A.ComponentMin(Capsule.B) - Extent, Capsule.A.ComponentMax(Capsule.B) + Extent);
+		CenterBounds += (Capsule.A + Capsule.B) * 0.5f;
+	}
+	Nodes[NodeIdx].Bounds = Bounds;
+
+	if(Num <= TVRHitbox::LeafSize)
+	{
+		FCapsuleLeaf& Leaf = Leaves.AddDefaulted_GetRef();
+		for(int32 Lane = 0; Lane < TVRHitbox::LeafSize; Lane++)
+		{
+			if(Lane < Num)
+			{
+				const int32 CapsuleIdx = SortedCapsules[First + Lane];
+				const FWorldCapsule& Capsule = WorldCapsules[CapsuleIdx];
+				Leaf.Ax[Lane] = Capsule.A.X;
+				Leaf.Ay[Lane] = Capsule.A.Y;
+				Leaf.Az[Lane] = Capsule.A.Z;
+				Leaf.Bx[Lane] = Capsule.B.X;
+				Leaf.By[Lane] = Capsule.B.Y;
+				Leaf.Bz[Lane] = Capsule.B.Z;
+				Leaf.RadiusSq[Lane] = FMath::Square(Capsule.Radius);
+				Leaf.Capsule[Lane] = CapsuleIdx;
+			}
+			else
+			{
+				// padding lanes can never pass the distance test
+				Leaf.Ax[Lane] = Leaf.Ay[Lane] = Leaf.Az[Lane] = 0.f;
+				Leaf.Bx[Lane] = Leaf.By[Lane] = Leaf.Bz[Lane] = 0.f;
+				Leaf.RadiusSq[Lane] = -1.f;
+				Leaf.Capsule[Lane] = INDEX_NONE;
+			}
+		}
+		Nodes[NodeIdx].Left = INDEX_NONE;
+		Nodes[NodeIdx].Right = INDEX_NONE;
+		Nodes[NodeIdx].Leaf = Leaves.Num() - 1;
+		return NodeIdx;
+	}
+
+	// median split along the largest axis of the capsule centers
+	const FVector CenterExtent = CenterBounds.GetExtent();
+	const int32 Axis = CenterExtent.X > CenterExtent.Y ? (CenterExtent.X > CenterExtent.Z ? 0 : 2) : (CenterExtent.Y > CenterExtent.Z ? 1 : 2);
+	const TArray<FWorldCapsule>& Capsules = WorldCapsules;
+	Sort(SortedCapsules.GetData() + First, Num, [&Capsules, Axis](const int32 L, const int32 R)
+	{
+		return (Capsules[L].A[Axis] + Capsules[L].B[Axis]) < (Capsules[R].A[Axis] + Capsules[R].B[Axis]);
+	});
+	const int32 NumLeft = Num / 2;
+	const int32 Left = BuildNode(First, NumLeft);
+	const int32 Right = BuildNode(First + NumLeft, Num - NumLeft);
+	Nodes[NodeIdx].Left = Left;
+	Nodes[NodeIdx].Right = Right;
+	Nodes[NodeIdx].Leaf = INDEX_NONE;
+	return NodeIdx;
+}
+
+bool UTVRHitboxSubsystem::RaycastHitboxes(FHitResult& OutHit, const FVector& Start, const FVector& End,
+	const FCollisionQueryParams& QueryParams, const AActor* Shooter)
+{
+	if(HitboxComponents.Num() == 0)
+	{
+		return false;
+	}
+	UpdateHitboxes();
+	if(Nodes.Num() == 0)
+	{
+		return false;
+	}
+
+	const FVector Dir = End - Start;
+	const float Length = Dir.Size();
+	if(Length < KINDA_SMALL_NUMBER)
+	{
+		return false;
+	}
+	const FVector DirNormal = Dir / Length;
+	const FVector InvDir(
+		Dir.X != 0.f ? 1.f / Dir.X : BIG_NUMBER,
+		Dir.Y != 0.f ? 1.f / Dir.Y : BIG_NUMBER,
+		Dir.Z != 0.f ? 1.f / Dir.Z : BIG_NUMBER);
+
+	// segment constants for the SIMD kernel (segment P0 + D1 * S, capsule A + D2 * T, S and T in [0, 1])
+	const float DirSizeSq = Dir.SizeSquared();
+	const VectorRegister P0x = VectorSetFloat1(Start.X);
+	const VectorRegister P0y = VectorSetFloat1(Start.Y);
+	const VectorRegister P0z = VectorSetFloat1(Start.Z);
+	const VectorRegister D1x = VectorSetFloat1(Dir.X);
+	const VectorRegister D1y = VectorSetFloat1(Dir.Y);
+	const VectorRegister D1z = VectorSetFloat1(Dir.Z);
+	const VectorRegister VA = VectorSetFloat1(DirSizeSq);
+	const VectorRegister VInvA = VectorSetFloat1(1.f / DirSizeSq);
+	const VectorRegister VZero = VectorZero();
+	const VectorRegister VOne = VectorOne();
+	const VectorRegister VEpsilon = VectorSetFloat1(KINDA_SMALL_NUMBER);
+
+	const TArray<uint32>& IgnoredActors = QueryParams.GetIgnoredActors();
+	float BestT = 1.f;
+	float BestDistance = -1.f;
+	int32 BestCapsule = INDEX_NONE;
+
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Add(0);
+	while(Stack.Num() > 0)
+	{
+		const FBVHNode& Node = Nodes[Stack.Pop(false)];
+		if(!TVRHitbox::SegmentIntersectsBox(Node.Bounds, Start, InvDir, BestT))
+		{
+			continue;
+		}
+		if(Node.Leaf == INDEX_NONE)
+		{
+			Stack.Add(Node.Left);
+			Stack.Add(Node.Right);
+			continue;
+		}
+
+		// closest distance between the ray segment and four capsule segments at once
+		const FCapsuleLeaf& Leaf = Leaves[Node.Leaf];
+		const VectorRegister Ax = VectorLoad(Leaf.Ax);
+		const VectorRegister Ay = VectorLoad(Leaf.Ay);
+		const VectorRegister Az = VectorLoad(Leaf.Az);
+		const VectorRegister D2x = VectorSubtract(VectorLoad(Leaf.Bx), Ax);
+		const VectorRegister D2y = VectorSubtract(VectorLoad(Leaf.By), Ay);
+		const VectorRegister D2z = VectorSubtract(VectorLoad(Leaf.Bz), Az);
+		const VectorRegister Rx = VectorSubtract(P0x, Ax);
+		const VectorRegister Ry = VectorSubtract(P0y, Ay);
+		const VectorRegister Rz = VectorSubtract(P0z, Az);
+
+		const VectorRegister E = VectorMax(VectorMultiplyAdd(D2x, D2x, VectorMultiplyAdd(D2y, D2y, VectorMultiply(D2z, D2z))), VEpsilon);
+		const VectorRegister F = VectorMultiplyAdd(D2x, Rx, VectorMultiplyAdd(D2y, Ry, VectorMultiply(D2z, Rz)));
+		const VectorRegister C = VectorMultiplyAdd(D1x, Rx, VectorMultiplyAdd(D1y, Ry, VectorMultiply(D1z, Rz)));
+		const VectorRegister B = VectorMultiplyAdd(D1x, D2x, VectorMultiplyAdd(D1y, D2y, VectorMultiply(D1z, D2z)));
+		const VectorRegister InvE = VectorReciprocalAccurate(E);
+
+		// parameter on the ray, parallel segments start at the origin
+		const VectorRegister Denom = VectorSubtract(VectorMultiply(VA, E), VectorMultiply(B, B));
+		const VectorRegister SNum = VectorSubtract(VectorMultiply(B, F), VectorMultiply(C, E));
+		VectorRegister S = VectorMultiply(SNum, VectorReciprocalAccurate(VectorMax(Denom, VEpsilon)));
+		S = VectorSelect(VectorCompareGT(Denom, VEpsilon), VectorMin(VectorMax(S, VZero), VOne), VZero);
+
+		// parameter on the capsule, if it is clamped the ray parameter has to be recomputed
+		const VectorRegister T = VectorMultiply(VectorMultiplyAdd(B, S, F), InvE);
+		const VectorRegister SLow = VectorMin(VectorMax(VectorMultiply(VectorNegate(C), VInvA), VZero), VOne);
+		const VectorRegister SHigh = VectorMin(VectorMax(VectorMultiply(VectorSubtract(B, C), VInvA), VZero), VOne);
+		S = VectorSelect(VectorCompareLT(T, VZero), SLow, S);
+		S = VectorSelect(VectorCompareGT(T, VOne), SHigh, S);
+		const VectorRegister TClamped = VectorMin(VectorMax(T, VZero), VOne);
+
+		const VectorRegister DiffX = VectorSubtract(VectorMultiplyAdd(D1x, S, Rx), VectorMultiply(D2x, TClamped));
+		const VectorRegister DiffY = VectorSubtract(VectorMultiplyAdd(D1y, S, Ry), VectorMultiply(D2y, TClamped));
+		const VectorRegister DiffZ = VectorSubtract(VectorMultiplyAdd(D1z, S, Rz), VectorMultiply(D2z, TClamped));
+		const VectorRegister DistSq = VectorMultiplyAdd(DiffX, DiffX, VectorMultiplyAdd(DiffY, DiffY, VectorMultiply(DiffZ, DiffZ)));
+		const int32 CandidateMask = VectorMaskBits(VectorCompareLE(DistSq, VectorLoad(Leaf.RadiusSq)));
+		if(CandidateMask == 0)
+		{
+			continue;
+		}
+
+		// exact intersection only for the candidates
+		for(int32 Lane = 0; Lane < TVRHitbox::LeafSize; Lane++)
+		{
+			if((CandidateMask & (1 << Lane)) == 0)
+			{
+				continue;
+			}
+			const FWorldCapsule& Capsule = WorldCapsules[Leaf.Capsule[Lane]];
+			const UTVRHitboxComponent* HitboxComp = HitboxComponents[Capsule.ComponentIndex];
+			const AActor* HitboxOwner = HitboxComp ? HitboxComp->GetOwner() : nullptr;
+			if(HitboxOwner == nullptr || HitboxOwner == Shooter || IgnoredActors.Contains(HitboxOwner->GetUniqueID()))
+			{
+				continue;
+			}
+			// a segment that starts inside of the capsule has no entry, e.g. a muzzle inside of the own arm
+			const float Distance = TVRHitbox::RayCapsule(Start, DirNormal, Capsule.A, Capsule.B, Capsule.Radius);
+			if(Distance <= 0.f)
+			{
+				continue;
+			}
+			if(Distance <= Length && Distance / Length <= BestT)
+			{
+				BestT = Distance / Length;
+				BestDistance = Distance;
+				BestCapsule = Leaf.Capsule[Lane];
+			}
+		}
+	}
+
+	if(BestCapsule == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const FWorldCapsule& Capsule = WorldCapsules[BestCapsule];
+	UTVRHitboxComponent* HitboxComp = HitboxComponents[Capsule.ComponentIndex];
+	const FVector Location = Start + DirNormal * BestDistance;
+	const FVector ClosestOnSegment = FMath::ClosestPointOnSegment(Location, Capsule.A, Capsule.B);
+	FVector Normal = (Location - ClosestOnSegment).GetSafeNormal();
+	if(Normal.IsZero())
+	{
+		Normal = -DirNormal;
+	}
+
+	OutHit = FHitResult(HitboxComp->GetOwner(), HitboxComp->GetHitboxMesh(), Location, Normal);
+	OutHit.TraceStart = Start;
+	OutHit.TraceEnd = End;
+	OutHit.Time = BestT;
+	OutHit.Distance = BestDistance;
+	OutHit.bBlockingHit = true;
+	OutHit.BoneName = HitboxComp->GetCapsules()[Capsule.CapsuleIndex].BoneName;
+	OutHit.MyItem = Capsule.CapsuleIndex;
+	OutHit.PhysMaterial = HitboxComp->GetPhysicalMaterial();
+	return true;
+}
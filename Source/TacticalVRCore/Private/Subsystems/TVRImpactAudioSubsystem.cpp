@@ -0,0 +1,170 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#include "Subsystems/TVRImpactAudioSubsystem.h"
+
+#include "Components/AudioComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/WorldSettings.h"
+#include "Settings/TVRCoreWeaponSettings.h"
+#include "Sound/SoundBase.h"
+
+namespace TVRImpactAudio
+{
+	/** Time in s after which the priority of a playing voice has halved, the loud part of an impact is short */
+	constexpr float PriorityHalfLife = 0.15f;
+}
+
+void UTVRImpactAudioSubsystem::Deinitialize()
+{
+	for(UAudioComponent* Voice: Voices)
+	{
+		if(Voice && !Voice->IsPendingKill())
+		{
+			Voice->DestroyComponent();
+		}
+	}
+	Voices.Empty();
+	VoiceStates.Empty();
+	Super::Deinitialize();
+}
+
+bool UTVRImpactAudioSubsystem::PlayImpactSound(USoundBase* Sound, const FVector& Location, EPhysicalSurface SurfaceType,
+	float Volume, USoundAttenuation* Attenuation, float PriorityScale)
+{
+	if(Sound == nullptr || Volume <= 0.f || GetWorld()->GetNetMode() == NM_DedicatedServer)
+	{
+		return false;
+	}
+
+	const UTVRCoreWeaponSettings* Settings = UTVRCoreWeaponSettings::Get();
+	const float MaxDistance = FMath::Min(Settings->MaxImpactAudioDistance, Sound->GetMaxDistance());
+	const float ListenerDistance = GetClosestListenerDistance(Location);
+	if(ListenerDistance < 0.f || ListenerDistance > MaxDistance)
+	{
+		return false;
+	}
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	const float Priority = Volume * PriorityScale * (1.f - ListenerDistance / FMath::Max(MaxDistance, 1.f));
+	const int32 VoiceIdx = FindVoice(SurfaceType, Priority, Now);
+	if(VoiceIdx == INDEX_NONE)
+	{
+		return false;
+	}
+
+	UAudioComponent* Voice = Voices[VoiceIdx];
+	if(Voice == nullptr || Voice->IsPendingKill())
+	{
+		// created without auto activation, so the voice only starts once it is configured
+		Voice = NewObject<UAudioComponent>(GetWorld()->GetWorldSettings());
+		Voice->bAutoActivate = false;
+		Voice->bAutoDestroy = false;
+		Voice->RegisterComponentWithWorld(GetWorld());
+		Voices[VoiceIdx] = Voice;
+	}
+	else
+	{
+		Voice->Stop();
+	}
+	if(Voice->Sound != Sound)
+	{
+		Voice->SetSound(Sound);
+	}
+	Voice->SetWorldLocation(Location, false);
+
+	Voice->AttenuationSettings = Attenuation;
+	Voice->SetVolumeMultiplier(Volume);
+	Voice->SetIntParameter(FName(TEXT("SurfaceType")), SurfaceType);
+	Voice->Play();
+
+	FVoiceState& State = VoiceStates[VoiceIdx];
+	State.Priority = Priority;
+	State.StartTime = Now;
+	State.SurfaceType = SurfaceType;
+	return true;
+}
+
+float UTVRImpactAudioSubsystem::GetClosestListenerDistance(const FVector& Location) const
+{
+	float ClosestDistSq = -1.f;
+	for(FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if(PC && PC->IsLocalController())
+		{
+			FVector ListenerLocation;
+			FVector FrontDir;
+			FVector RightDir;
+			PC->GetAudioListenerPosition(ListenerLocation, FrontDir, RightDir);
+			const float DistSq = FVector::DistSquared(ListenerLocation, Location);
+			if(ClosestDistSq < 0.f || DistSq < ClosestDistSq)
+			{
+				ClosestDistSq = DistSq;
+			}
+		}
+	}
+	return ClosestDistSq < 0.f ? -1.f : FMath::Sqrt(ClosestDistSq);
+}
+
+float UTVRImpactAudioSubsystem::GetEffectivePriority(int32 VoiceIdx, float Now) const
+{
+	const FVoiceState& State = VoiceStates[VoiceIdx];
+	return State.Priority * FMath::Exp2(-(Now - State.StartTime) / TVRImpactAudio::PriorityHalfLife);
+}
+
+int32 UTVRImpactAudioSubsystem::FindVoice(EPhysicalSurface SurfaceType, float Priority, float Now)
+{
+	const UTVRCoreWeaponSettings* Settings = UTVRCoreWeaponSettings::Get();
+
+	int32 FreeVoice = INDEX_NONE;
+	int32 NumSurfaceVoices = 0;
+	int32 WeakestSurfaceVoice = INDEX_NONE;
+	int32 WeakestVoice = INDEX_NONE;
+	for(int32 Idx = 0; Idx < Voices.Num(); Idx++)
+	{
+		const UAudioComponent* Voice = Voices[Idx];
+		if(Voice == nullptr || Voice->IsPendingKill() || !Voice->IsPlaying())
+		{
+			if(FreeVoice == INDEX_NONE)
+			{
+				FreeVoice = Idx;
+			}
+			continue;
+		}
+
+		const float VoicePriority = GetEffectivePriority(Idx, Now);
+		if(WeakestVoice == INDEX_NONE || VoicePriority < GetEffectivePriority(WeakestVoice, Now))
+		{
+			WeakestVoice = Idx;
+		}
+		if(VoiceStates[Idx].SurfaceType == SurfaceType)
+		{
+			NumSurfaceVoices++;
+			if(WeakestSurfaceVoice == INDEX_NONE || VoicePriority < GetEffectivePriority(WeakestSurfaceVoice, Now))
+			{
+				WeakestSurfaceVoice = Idx;
+			}
+		}
+	}
+
+	// the surface is at its limit, we can only replace one of its own voices
+	if(NumSurfaceVoices >= Settings->MaxImpactVoicesPerSurface)
+	{
+		return GetEffectivePriority(WeakestSurfaceVoice, Now) < Priority ? WeakestSurfaceVoice : INDEX_NONE;
+	}
+	if(FreeVoice != INDEX_NONE)
+	{
+		return FreeVoice;
+	}
+	if(Voices.Num() < Settings->MaxImpactVoices)
+	{
+		Voices.Add(nullptr);
+		VoiceStates.AddZeroed();
+		return Voices.Num() - 1;
+	}
+	if(WeakestVoice != INDEX_NONE && GetEffectivePriority(WeakestVoice, Now) < Priority)
+	{
+		return WeakestVoice;
+	}
+	return INDEX_NONE;
+}
@@ -0,0 +1,278 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#include "Subsystems/TVRImpactFXSubsystem.h"
+
+#include "Components/DecalComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Materials/MaterialInterface.h"
+#include "Particles/ParticleSystem.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "Settings/TVRCoreWeaponSettings.h"
+#include "Subsystems/TVRFXPreloadSubsystem.h"
+
+namespace TVRImpactFX
+{
+	/** Impacts that could not be spawned within this time in s (budget) are dropped */
+	constexpr float MaxPendingImpactAge = 0.25f;
+}
+
+UTVRImpactFXSubsystem::UTVRImpactFXSubsystem()
+{
+	NextDecal = 0;
+	ViewLocationsFrame = MAX_uint64;
+}
+
+void UTVRImpactFXSubsystem::Deinitialize()
+{
+	PendingImpacts.Empty();
+	RecentImpacts.Empty();
+	Decals.Empty();
+	Super::Deinitialize();
+}
+
+void UTVRImpactFXSubsystem::Tick(float DeltaTime)
+{
+	const UTVRCoreWeaponSettings* Settings = UTVRCoreWeaponSettings::Get();
+	const float Now = GetWorld()->GetTimeSeconds();
+
+	const int32 NumToSpawn = FMath::Min(PendingImpacts.Num(), Settings->MaxImpactEffectsPerFrame);
+	for(int32 Idx = 0; Idx < NumToSpawn; Idx++)
+	{
+		SpawnImpactParticle(PendingImpacts[Idx]);
+		SpawnImpactDecal(PendingImpacts[Idx]);
+	}
+	PendingImpacts.RemoveAt(0, NumToSpawn, false);
+
+	// during sustained fire the budget may not be enough, late effects would look off so they are dropped
+	PendingImpacts.RemoveAll([Now](const FPendingImpact& Impact)
+	{
+		return Now - Impact.Time > TVRImpactFX::MaxPendingImpactAge;
+	});
+}
+
+bool UTVRImpactFXSubsystem::IsTickable() const
+{
+	return !HasAnyFlags(RF_ClassDefaultObject) && PendingImpacts.Num() > 0;
+}
+
+TStatId UTVRImpactFXSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTVRImpactFXSubsystem, STATGROUP_Tickables);
+}
+
+void UTVRImpactFXSubsystem::AddImpact(const FHitResult& Hit, const ATVRCartridge* CartridgeCDO)
+{
+	if(CartridgeCDO == nullptr || GetWorld()->GetNetMode() == NM_DedicatedServer)
+	{
+		return;
+	}
+
+	const EPhysicalSurface SurfaceType = Hit.PhysMaterial.IsValid() ? Hit.PhysMaterial->SurfaceType.GetValue() : SurfaceType_Default;
+	const FImpactParticleData* ImpactPS = CartridgeCDO->GetImpactParticle(SurfaceType);
+	const FImpactDecalData* ImpactDecal = CartridgeCDO->GetImpactDecal(SurfaceType);
+	const bool bHasParticle = ImpactPS && !ImpactPS->ParticleSystem.IsNull();
+	const bool bHasDecal = ImpactDecal && !ImpactDecal->DecalMaterial.IsNull() && Hit.GetComponent()
+		&& Hit.GetComponent()->GetCollisionObjectType() == ECC_WorldStatic;
+	if(!bHasParticle && !bHasDecal)
+	{
+		return;
+	}
+
+	if(!IsInViewRange(Hit.ImpactPoint))
+	{
+		return;
+	}
+
+	// usually requested when the gun became relevant already, the fallback effects are used until it is loaded
+	if(UTVRFXPreloadSubsystem* FXPreload = GetWorld()->GetSubsystem<UTVRFXPreloadSubsystem>())
+	{
+		FXPreload->RequestCartridgeFX(CartridgeCDO->GetClass());
+	}
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	if(IsMergedWithRecentImpact(Hit.ImpactPoint, Now))
+	{
+		return;
+	}
+	RecentImpacts.Add({Hit.ImpactPoint, Now});
+
+	FPendingImpact& Impact = PendingImpacts.AddDefaulted_GetRef();
+	Impact.Location = Hit.ImpactPoint;
+	Impact.Normal = Hit.ImpactNormal;
+	Impact.TraceDir = (Hit.TraceEnd - Hit.TraceStart).GetSafeNormal();
+	Impact.HitComponent = Hit.GetComponent();
+	Impact.BoneName = Hit.BoneName;
+	if(bHasParticle)
+	{
+		Impact.Particle = *ImpactPS;
+	}
+	if(bHasDecal)
+	{
+		Impact.Decal = *ImpactDecal;
+	}
+	Impact.Time = Now;
+}
+
+void UTVRImpactFXSubsystem::ClearDecals()
+{
+	for(const TWeakObjectPtr<UDecalComponent>& Decal: Decals)
+	{
+		if(Decal.IsValid())
+		{
+			Decal->DestroyComponent();
+		}
+	}
+	Decals.Reset();
+	NextDecal = 0;
+}
+
+bool UTVRImpactFXSubsystem::IsInViewRange(const FVector& Location)
+{
+	if(ViewLocationsFrame != GFrameCounter)
+	{
+		ViewLocationsFrame = GFrameCounter;
+		ViewLocations.Reset();
+		for(FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+		{
+			const APlayerController* PC = It->Get();
+			if(PC && PC->IsLocalController())
+			{
+				FVector ViewLocation;
+				FRotator ViewRotation;
+				PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+				ViewLocations.Add(ViewLocation);
+			}
+		}
+	}
+
+	const float MaxDistSq = FMath::Square(UTVRCoreWeaponSettings::Get()->MaxImpactEffectDistance);
+	for(const FVector& ViewLocation: ViewLocations)
+	{
+		if(FVector::DistSquared(ViewLocation, Location) <= MaxDistSq)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool UTVRImpactFXSubsystem::IsMergedWithRecentImpact(const FVector& Location, float Now)
+{
+	const UTVRCoreWeaponSettings* Settings = UTVRCoreWeaponSettings::Get();
+	const float MergeRadiusSq = FMath::Square(Settings->ImpactMergeRadius);
+	RecentImpacts.RemoveAll([Now, Settings](const FRecentImpact& Impact)
+	{
+		return Now - Impact.Time > Settings->ImpactMergeTime;
+	});
+
+	for(const FRecentImpact& Impact: RecentImpacts)
+	{
+		if(FVector::DistSquared(Impact.Location, Location) <= MergeRadiusSq)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void UTVRImpactFXSubsystem::SpawnImpactParticle(const FPendingImpact& Impact)
+{
+	if(Impact.Particle.ParticleSystem.IsNull())
+	{
+		return;
+	}
+	UParticleSystem* ParticleSystem = Impact.Particle.ParticleSystem.Get();
+	if(ParticleSystem == nullptr)
+	{
+		ParticleSystem = UTVRCoreWeaponSettings::Get()->FallbackImpactParticle.Get();
+		if(ParticleSystem == nullptr)
+		{
+			return;
+		}
+	}
+
+	const FVector& TraceDir = Impact.TraceDir;
+	const FVector ImpactUpVector = Impact.Normal + TraceDir - 2 * (TraceDir | Impact.Normal) * Impact.Normal;
+	FRotator ImpactRot;
+	switch(Impact.Particle.UpAxis)
+	{
+	case EAxisOption::X:
+		ImpactRot = UKismetMathLibrary::MakeRotFromX(ImpactUpVector);
+		break;
+	case EAxisOption::Y:
+		ImpactRot = UKismetMathLibrary::MakeRotFromY(ImpactUpVector);
+		break;
+	case EAxisOption::X_Neg:
+		ImpactRot = UKismetMathLibrary::MakeRotFromX(-ImpactUpVector);
+		break;
+	case EAxisOption::Y_Neg:
+		ImpactRot = UKismetMathLibrary::MakeRotFromY(-ImpactUpVector);
+		break;
+	case EAxisOption::Z_Neg:
+		ImpactRot = UKismetMathLibrary::MakeRotFromZ(-ImpactUpVector);
+		break;
+	case EAxisOption::Z:
+	default:
+		ImpactRot = UKismetMathLibrary::MakeRotFromZ(ImpactUpVector);
+		break;
+	}
+	UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ParticleSystem,
+		Impact.Location, ImpactRot, FVector(Impact.Particle.ScaleFactor),
+		true, EPSCPoolMethod::AutoRelease, true);
+}
+
+void UTVRImpactFXSubsystem::SpawnImpactDecal(const FPendingImpact& Impact)
+{
+	USceneComponent* HitComponent = Impact.HitComponent.Get();
+	if(Impact.Decal.DecalMaterial.IsNull() || HitComponent == nullptr)
+	{
+		return;
+	}
+
+	const UTVRCoreWeaponSettings* Settings = UTVRCoreWeaponSettings::Get();
+	UMaterialInterface* DecalMaterial = Impact.Decal.DecalMaterial.Get();
+	if(DecalMaterial == nullptr)
+	{
+		DecalMaterial = Settings->FallbackImpactDecal.Get();
+		if(DecalMaterial == nullptr)
+		{
+			return;
+		}
+	}
+	FRotator DecalRot = UKismetMathLibrary::MakeRotFromX(-Impact.Normal);
+	DecalRot.Roll = FMath::RandRange(-180.f, 180.f);
+	const FVector DecalSize = Impact.Decal.ScaleFactor * FVector(0.5f, 1.f, 1.f);
+
+	// while the ring buffer is not full NextDecal stays at the first (oldest) decal
+	UDecalComponent* Decal = Decals.Num() >= Settings->MaxImpactDecals && Decals.IsValidIndex(NextDecal) ? Decals[NextDecal].Get() : nullptr;
+	if(Decal && !Decal->IsPendingKill())
+	{
+		Decal->SetDecalMaterial(DecalMaterial);
+		Decal->DecalSize = DecalSize;
+		Decal->AttachToComponent(HitComponent, FAttachmentTransformRules::KeepWorldTransform, Impact.BoneName);
+		Decal->SetWorldLocationAndRotation(Impact.Location, DecalRot);
+		Decal->MarkRenderStateDirty();
+	}
+	else
+	{
+		Decal = UGameplayStatics::SpawnDecalAttached(DecalMaterial, DecalSize,
+			HitComponent, Impact.BoneName,
+			Impact.Location, DecalRot,
+			EAttachLocation::KeepWorldPosition);
+		if(Decal == nullptr)
+		{
+			return;
+		}
+		Decal->SetFadeScreenSize(Settings->ImpactDecalFadeScreenSize);
+		if(Decals.Num() < Settings->MaxImpactDecals)
+		{
+			Decals.Add(Decal);
+			return;
+		}
+		// the oldest decal was destroyed with its owner, take its slot
+		Decals[NextDecal] = Decal;
+	}
+	NextDecal = (NextDecal + 1) % Decals.Num();
+}
@@ -0,0 +1,152 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#include "Subsystems/TVRMagazineSubsystem.h"
+
+#include "GameFramework/PlayerController.h"
+#include "Settings/TVRCoreWeaponSettings.h"
+#include "Weapon/TVRMagazine.h"
+
+namespace TVRMagazineManager
+{
+	/** Distances below this count as equally close, so fresh magazines next to a player are not evicted first */
+	constexpr float MinEvictionDistance = 100.f;
+}
+
+void UTVRMagazineSubsystem::Deinitialize()
+{
+	LooseMagazines.Empty();
+	RecycledMagazines.Empty();
+	Super::Deinitialize();
+}
+
+ATVRMagazine* UTVRMagazineSubsystem::AcquireMagazine(TSubclassOf<ATVRMagazine> MagazineClass, const FTransform& Transform)
+{
+	if(MagazineClass == nullptr)
+	{
+		return nullptr;
+	}
+
+	if(TArray<TWeakObjectPtr<ATVRMagazine>>* Recycled = RecycledMagazines.Find(MagazineClass))
+	{
+		while(Recycled->Num() > 0)
+		{
+			ATVRMagazine* Mag = Recycled->Pop(false).Get();
+			if(Mag && !Mag->IsPendingKill())
+			{
+				Mag->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+				Mag->FlushNetDormancy();
+				Mag->SetRecycled(false);
+				return Mag;
+			}
+		}
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParams.bAllowDuringConstructionScript = false;
+	return GetWorld()->SpawnActor<ATVRMagazine>(MagazineClass, Transform, SpawnParams);
+}
+
+void UTVRMagazineSubsystem::RegisterLooseMagazine(ATVRMagazine* Magazine)
+{
+	if(Magazine == nullptr || Magazine->IsRecycled())
+	{
+		return;
+	}
+
+	const bool bAlreadyLoose = LooseMagazines.ContainsByPredicate([Magazine](const TPair<TWeakObjectPtr<ATVRMagazine>, float>& Entry)
+	{
+		return Entry.Key == Magazine;
+	});
+	if(!bAlreadyLoose)
+	{
+		LooseMagazines.Emplace(Magazine, GetWorld()->GetTimeSeconds());
+	}
+
+	LooseMagazines.RemoveAll([](const TPair<TWeakObjectPtr<ATVRMagazine>, float>& Entry)
+	{
+		return !Entry.Key.IsValid() || Entry.Key->IsPendingKill();
+	});
+	const int32 MaxLooseMagazines = UTVRCoreWeaponSettings::Get()->MaxLooseMagazines;
+	while(LooseMagazines.Num() > MaxLooseMagazines)
+	{
+		EvictMagazine();
+	}
+}
+
+void UTVRMagazineSubsystem::UnregisterLooseMagazine(ATVRMagazine* Magazine)
+{
+	LooseMagazines.RemoveAll([Magazine](const TPair<TWeakObjectPtr<ATVRMagazine>, float>& Entry)
+	{
+		return Entry.Key == Magazine;
+	});
+}
+
+void UTVRMagazineSubsystem::ReleaseMagazine(ATVRMagazine* Magazine)
+{
+	if(Magazine == nullptr || Magazine->IsRecycled() || !Magazine->HasAuthority())
+	{
+		return;
+	}
+	UnregisterLooseMagazine(Magazine);
+	if(Magazine->GetAttachParentActor())
+	{
+		Magazine->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+	}
+	RecycleMagazine(Magazine);
+}
+
+void UTVRMagazineSubsystem::EvictMagazine()
+{
+	TArray<FVector, TInlineAllocator<4>> PlayerLocations;
+	for(FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if(PC && PC->GetPawn())
+		{
+			PlayerLocations.Add(PC->GetPawn()->GetActorLocation());
+		}
+	}
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	int32 EvictIdx = 0;
+	float EvictScore = -1.f;
+	for(int32 Idx = 0; Idx < LooseMagazines.Num(); ++Idx)
+	{
+		const ATVRMagazine* Mag = LooseMagazines[Idx].Key.Get();
+		float MinDistSq = PlayerLocations.Num() > 0 ? MAX_flt : 0.f;
+		for(const FVector& PlayerLocation: PlayerLocations)
+		{
+			MinDistSq = FMath::Min(MinDistSq, FVector::DistSquared(Mag->GetActorLocation(), PlayerLocation));
+		}
+		const float Dist = FMath::Max(FMath::Sqrt(MinDistSq), TVRMagazineManager::MinEvictionDistance);
+		const float Score = (Now - LooseMagazines[Idx].Value + 1.f) * Dist;
+		if(Score > EvictScore)
+		{
+			EvictIdx = Idx;
+			EvictScore = Score;
+		}
+	}
+
+	ATVRMagazine* Mag = LooseMagazines[EvictIdx].Key.Get();
+	LooseMagazines.RemoveAt(EvictIdx);
+	RecycleMagazine(Mag);
+}
+
+void UTVRMagazineSubsystem::RecycleMagazine(ATVRMagazine* Magazine)
+{
+	TArray<TWeakObjectPtr<ATVRMagazine>>& Recycled = RecycledMagazines.FindOrAdd(Magazine->GetClass());
+	Recycled.RemoveAllSwap([](const TWeakObjectPtr<ATVRMagazine>& RecycledMag)
+	{
+		return !RecycledMag.IsValid();
+	});
+	if(Recycled.Num() >= UTVRCoreWeaponSettings::Get()->MaxRecycledMagazinesPerClass)
+	{
+		Magazine->Destroy();
+		return;
+	}
+
+	Magazine->FlushNetDormancy();
+	Magazine->SetRecycled(true);
+	Recycled.Add(Magazine);
+}
@@ -0,0 +1,357 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#include "Subsystems/TVRWeaponProxySubsystem.h"
+
+#include "GripMotionControllerComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Player/TVRCharacter.h"
+#include "Settings/TVRCoreWeaponSettings.h"
+#include "Weapon/TVRGunBase.h"
+#include "Weapon/TVRMagazine.h"
+#include "Weapon/TVRWeaponProxyActor.h"
+#include "Weapon/Component/TVRAttachmentPoint.h"
+#include "Weapon/Component/TVRGunFireComponent.h"
+#include "Weapon/Component/TVRMagWellComponent.h"
+
+namespace TVRWeaponProxy
+{
+	/** Hands are checked against the proxies a few times per second, not every frame */
+	constexpr float CheckInterval = 0.1f;
+}
+
+void UTVRWeaponProxySubsystem::Deinitialize()
+{
+	ProxyStates.Empty();
+	HydratedWeapons.Empty();
+	ProxyActor = nullptr;
+	Super::Deinitialize();
+}
+
+void UTVRWeaponProxySubsystem::Tick(float DeltaTime)
+{
+	TimeSinceCheck += DeltaTime;
+	if(TimeSinceCheck < TVRWeaponProxy::CheckInterval)
+	{
+		return;
+	}
+	TimeSinceCheck = 0.f;
+
+	TArray<FVector> HandLocations;
+	GetHandLocations(HandLocations);
+
+	const UTVRCoreWeaponSettings* Settings = UTVRCoreWeaponSettings::Get();
+	const float RadiusSq = FMath::Square(Settings->ProxyHydrateRadius);
+	const auto IsHandNear = [&HandLocations, RadiusSq](const FVector& Location)
+	{
+		for(const FVector& HandLocation: HandLocations)
+		{
+			if(FVector::DistSquared(HandLocation, Location) < RadiusSq)
+			{
+				return true;
+			}
+		}
+		return false;
+	};
+
+	for(int32 Idx = ProxyStates.Num() - 1; Idx >= 0; --Idx)
+	{
+		if(IsHandNear(ProxyStates[Idx].Transform.GetLocation()))
+		{
+			Hydrate(Idx);
+		}
+	}
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	TArray<AActor*> WeaponsToDehydrate;
+	for(auto It = HydratedWeapons.CreateIterator(); It; ++It)
+	{
+		AActor* Weapon = It.Key().Get();
+		if(Weapon == nullptr || Weapon->IsPendingKill())
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		const UPrimitiveComponent* RootPrim = Cast<UPrimitiveComponent>(Weapon->GetRootComponent());
+		const bool bIsMoving = RootPrim && RootPrim->IsSimulatingPhysics() && RootPrim->IsAnyRigidBodyAwake();
+		if(bIsMoving || IsWeaponInUse(Weapon) || IsHandNear(Weapon->GetActorLocation()))
+		{
+			It.Value() = Now;
+		}
+		else if(Now - It.Value() > Settings->ProxyDehydrateDelay)
+		{
+			WeaponsToDehydrate.Add(Weapon);
+		}
+	}
+	for(AActor* Weapon: WeaponsToDehydrate)
+	{
+		Dehydrate(Weapon);
+	}
+}
+
+bool UTVRWeaponProxySubsystem::IsTickable() const
+{
+	return !HasAnyFlags(RF_ClassDefaultObject) && (ProxyStates.Num() > 0 || HydratedWeapons.Num() > 0);
+}
+
+TStatId UTVRWeaponProxySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTVRWeaponProxySubsystem, STATGROUP_Tickables);
+}
+
+bool UTVRWeaponProxySubsystem::Dehydrate(AActor* Weapon)
+{
+	if(Weapon == nullptr || !Weapon->HasAuthority() || IsWeaponInUse(Weapon))
+	{
+		return false;
+	}
+
+	const AStaticMeshActor* MeshActor = Cast<AStaticMeshActor>(Weapon);
+	FTVRWeaponProxyState State;
+	if(MeshActor == nullptr || !CaptureState(Weapon, State))
+	{
+		return false;
+	}
+
+	ATVRWeaponProxyActor* Proxy = GetOrSpawnProxyActor();
+	if(Proxy == nullptr)
+	{
+		return false;
+	}
+	Proxy->AddInstance(MeshActor->GetStaticMeshComponent()->GetStaticMesh(), State.Transform);
+	ProxyStates.Add(State);
+	HydratedWeapons.Remove(Weapon);
+
+	TArray<AActor*> AttachedActors;
+	Weapon->GetAttachedActors(AttachedActors);
+	for(AActor* AttachedActor: AttachedActors)
+	{
+		// the inserted magazine is part of the captured state
+		if(AttachedActor->IsA<ATVRMagazine>())
+		{
+			AttachedActor->Destroy();
+		}
+	}
+	Weapon->Destroy();
+	return true;
+}
+
+AActor* UTVRWeaponProxySubsystem::HydrateClosest(const FVector& Location, float MaxDistance)
+{
+	int32 ClosestIdx = INDEX_NONE;
+	float ClosestDistSq = FMath::Square(MaxDistance);
+	for(int32 Idx = 0; Idx < ProxyStates.Num(); ++Idx)
+	{
+		const float DistSq = FVector::DistSquared(ProxyStates[Idx].Transform.GetLocation(), Location);
+		if(DistSq <= ClosestDistSq)
+		{
+			ClosestIdx = Idx;
+			ClosestDistSq = DistSq;
+		}
+	}
+	return ClosestIdx != INDEX_NONE ? Hydrate(ClosestIdx) : nullptr;
+}
+
+AActor* UTVRWeaponProxySubsystem::Hydrate(int32 Idx)
+{
+	if(!ProxyStates.IsValidIndex(Idx))
+	{
+		return nullptr;
+	}
+	const FTVRWeaponProxyState State = ProxyStates[Idx];
+	ProxyStates.RemoveAtSwap(Idx);
+	if(ProxyActor)
+	{
+		ProxyActor->RemoveInstanceAtSwap(Idx);
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	AActor* Weapon = GetWorld()->SpawnActor<AActor>(State.ActorClass, State.Transform, SpawnParams);
+	if(Weapon == nullptr)
+	{
+		return nullptr;
+	}
+
+	if(ATVRGunBase* Gun = Cast<ATVRGunBase>(Weapon))
+	{
+		TArray<UTVRAttachmentPoint*> AttachmentPoints;
+		Gun->GetComponents<UTVRAttachmentPoint>(AttachmentPoints);
+		if(AttachmentPoints.Num() == State.Attachments.Num())
+		{
+			for(int32 PointIdx = 0; PointIdx < AttachmentPoints.Num(); ++PointIdx)
+			{
+				if(AttachmentPoints[PointIdx]->GetCurrentAttachmentClass_Internal() != State.Attachments[PointIdx])
+				{
+					AttachmentPoints[PointIdx]->SetCurrentAttachmentClass(State.Attachments[PointIdx]);
+				}
+			}
+		}
+		Gun->SetColorVariant(State.ColorVariant);
+		// a gun next to a hand is about to be used, so no time slicing here
+		Gun->CompleteWarmup();
+
+		UTVRMagWellComponent* MagWell = Cast<UTVRMagWellComponent>(Gun->GetMagInterface());
+		if(MagWell && !State.bDefaultLoadout)
+		{
+			ATVRMagazine* Mag = MagWell->GetCurrentMagazine();
+			if(Mag && Mag->GetClass() != State.MagazineClass)
+			{
+				Mag->Destroy();
+				Mag = nullptr;
+			}
+			if(Mag == nullptr && State.MagazineClass)
+			{
+				MagWell->SpawnMagazineAttached(State.MagazineClass);
+			}
+		}
+		if(State.Ammo >= 0 && Gun->GetMagInterface())
+		{
+			Gun->GetMagInterface()->SetAmmoCount(State.Ammo);
+		}
+		if(State.ChamberedRound && Gun->GetFiringComponent())
+		{
+			Gun->GetFiringComponent()->TryLoadCartridge(State.ChamberedRound);
+		}
+	}
+	else if(ATVRMagazine* Mag = Cast<ATVRMagazine>(Weapon))
+	{
+		if(State.Ammo >= 0)
+		{
+			Mag->SetAmmo(State.Ammo);
+		}
+	}
+
+	if(UPrimitiveComponent* RootPrim = Cast<UPrimitiveComponent>(Weapon->GetRootComponent()))
+	{
+		RootPrim->SetSimulatePhysics(State.bSimulatePhysics);
+	}
+	HydratedWeapons.Add(Weapon, GetWorld()->GetTimeSeconds());
+	return Weapon;
+}
+
+bool UTVRWeaponProxySubsystem::CaptureState(AActor* Weapon, FTVRWeaponProxyState& OutState) const
+{
+	OutState.ActorClass = Weapon->GetClass();
+	OutState.Transform = Weapon->GetActorTransform();
+	if(const UPrimitiveComponent* RootPrim = Cast<UPrimitiveComponent>(Weapon->GetRootComponent()))
+	{
+		OutState.bSimulatePhysics = RootPrim->IsSimulatingPhysics();
+	}
+
+	if(ATVRGunBase* Gun = Cast<ATVRGunBase>(Weapon))
+	{
+		OutState.ColorVariant = Gun->GetColorVariant();
+
+		// attachment points are collected directly, the cached list is not built yet while the warm-up is pending
+		TArray<UTVRAttachmentPoint*> AttachmentPoints;
+		Gun->GetComponents<UTVRAttachmentPoint>(AttachmentPoints);
+		for(const UTVRAttachmentPoint* AttachmentPoint: AttachmentPoints)
+		{
+			OutState.Attachments.Add(AttachmentPoint->GetCurrentAttachmentClass_Internal());
+		}
+
+		if(Gun->IsWarmupPending())
+		{
+			// nothing was spawned yet, so the gun is still in its default state
+			OutState.bDefaultLoadout = true;
+			return true;
+		}
+
+		if(const UTVRMagWellComponent* MagWell = Cast<UTVRMagWellComponent>(Gun->GetMagInterface()))
+		{
+			const ATVRMagazine* Mag = MagWell->GetCurrentMagazine();
+			if(Mag && !Mag->IsInserted())
+			{
+				return false;
+			}
+			OutState.MagazineClass = Mag ? Mag->GetClass() : nullptr;
+			OutState.Ammo = Mag ? Mag->GetAmmo() : -1;
+		}
+		else if(Gun->GetMagInterface())
+		{
+			OutState.Ammo = Gun->GetMagInterface()->GetAmmoCount();
+		}
+
+		if(Gun->GetFiringComponent())
+		{
+			OutState.ChamberedRound = Gun->GetFiringComponent()->GetLoadedCartridge();
+		}
+		return true;
+	}
+
+	if(const ATVRMagazine* Mag = Cast<ATVRMagazine>(Weapon))
+	{
+		OutState.Ammo = Mag->GetAmmo();
+		return true;
+	}
+	return false;
+}
+
+bool UTVRWeaponProxySubsystem::IsWeaponInUse(AActor* Weapon) const
+{
+	if(Weapon->GetAttachParentActor())
+	{
+		return true;
+	}
+
+	const ATVRGunBase* Gun = Cast<ATVRGunBase>(Weapon);
+	if(Gun && Gun->IsPooled())
+	{
+		return true;
+	}
+
+	if(Weapon->Implements<UVRGripInterface>())
+	{
+		TArray<FBPGripPair> HoldingControllers;
+		bool bIsHeld = false;
+		IVRGripInterface::Execute_IsHeld(Weapon, HoldingControllers, bIsHeld);
+		return bIsHeld;
+	}
+	return false;
+}
+
+void UTVRWeaponProxySubsystem::GetHandLocations(TArray<FVector>& OutLocations) const
+{
+	for(FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if(PC == nullptr || PC->GetPawn() == nullptr)
+		{
+			continue;
+		}
+
+		if(const ATVRCharacter* Character = Cast<ATVRCharacter>(PC->GetPawn()))
+		{
+			for(const EControllerHand Hand: {EControllerHand::Left, EControllerHand::Right})
+			{
+				if(const UGripMotionControllerComponent* Controller = Character->GetControllerHand(Hand))
+				{
+					OutLocations.Add(Controller->GetComponentLocation());
+				}
+			}
+		}
+		else
+		{
+			OutLocations.Add(PC->GetPawn()->GetActorLocation());
+		}
+	}
+}
+
+ATVRWeaponProxyActor* UTVRWeaponProxySubsystem::GetOrSpawnProxyActor()
+{
+	if(ProxyActor == nullptr || ProxyActor->IsPendingKill())
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		ProxyActor = GetWorld()->SpawnActor<ATVRWeaponProxyActor>(ATVRWeaponProxyActor::StaticClass(), FTransform::Identity, SpawnParams);
+
+		// the instances have to match the proxy states by index
+		for(const FTVRWeaponProxyState& State: ProxyStates)
+		{
+			const AStaticMeshActor* DefaultActor = Cast<AStaticMeshActor>(State.ActorClass ? State.ActorClass->GetDefaultObject() : nullptr);
+			ProxyActor->AddInstance(DefaultActor ? DefaultActor->GetStaticMeshComponent()->GetStaticMesh() : nullptr, State.Transform);
+		}
+	}
+	return ProxyActor;
+}
@@ -6,6 +6,7 @@
 #include "Weapon/Component/TVRAttachmentPoint.h"
 #include "Components/ArrowComponent.h"
 #include "Weapon/TVRGunBase.h"
+#include "Weapon/Component/TVRGunFireComponent.h"
 
 
 FName ATVRWeaponAttachment::StaticMeshComponentName(TEXT("Mesh"));
@@ -119,6 +120,11 @@ void ATVRWeaponAttachment::AttachToWeapon(UTVRAttachmentPoint* AttachPoint)
 			Child->AttachToComponent(AttachPoint->GetAttachParent(), FAttachmentTransformRules::KeepWorldTransform);
 		}
 		SetOwner(Gun);
+		TInlineComponentArray<UTVRGunFireComponent*> FireComponents(this);
+		for(UTVRGunFireComponent* FireComp: FireComponents)
+		{
+			FireComp->InvalidateTraceQueryCache();
+		}
 		AttachmentPoint = AttachPoint;
 		AttachPoint->OnWeaponAttachmentAttached(this);	
 		AddTickPrerequisiteComponent(GunMesh);
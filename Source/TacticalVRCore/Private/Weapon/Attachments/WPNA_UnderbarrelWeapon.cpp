@@ -155,7 +155,7 @@ void AWPNA_UnderbarrelWeapon::OnStartFire_Implementation()
 {
 	if(IsGripped())
 	{
-		FiringComponent->StartFire();
+		FiringComponent->StartFireAtTime(TriggerComponent->GetCurrentPullActivateTime());
 	}
 }
 
@@ -140,6 +140,38 @@ void UTVRAttachmentPoint::SetPreferredColorVariant(uint8 NewVariant)
 	}
 }
 
+void UTVRAttachmentPoint::ResetToDefaults()
+{
+	const UTVRAttachmentPoint* Archetype = Cast<UTVRAttachmentPoint>(GetArchetype());
+	if(Archetype == nullptr || Archetype == this)
+	{
+		return;
+	}
+
+	PreferredVariant = Archetype->PreferredVariant;
+	ColorVariant = Archetype->ColorVariant;
+	bOverrideVariant = Archetype->bOverrideVariant;
+	VariantOverride = Archetype->VariantOverride;
+	bOverrideColorVariant = Archetype->bOverrideColorVariant;
+	ColorVariantOverride = Archetype->ColorVariantOverride;
+
+	// both paths end in OnConstruction, which also pushes the variants to the attachment
+	if(!SetCurrentAttachmentClass(Archetype->GetCurrentAttachmentClass_Internal()))
+	{
+		OnConstruction();
+	}
+
+	if(AActor* Attachment = GetChildActor())
+	{
+		TArray<UTVRAttachmentPoint*> NestedPoints;
+		Attachment->GetComponents<UTVRAttachmentPoint>(NestedPoints);
+		for(UTVRAttachmentPoint* NestedPoint : NestedPoints)
+		{
+			NestedPoint->ResetToDefaults();
+		}
+	}
+}
+
 uint8 UTVRAttachmentPoint::GetRequestedVariant() const
 {
 	return bOverrideVariant ? VariantOverride : PreferredVariant;
@@ -4,6 +4,7 @@
 
 #include "TacticalCollisionProfiles.h"
 #include "Components/AudioComponent.h"
+#include "Weapon/Component/TVRGunAudioComponent.h"
 
 UTVRChargingHandle::UTVRChargingHandle(const FObjectInitializer& OI) : Super(OI)
 {
@@ -34,17 +35,15 @@ UTVRChargingHandle::UTVRChargingHandle(const FObjectInitializer& OI) : Super(OI)
 	bShouldPlayBackSound = false;
 	bShouldPlayCloseSound = false;
 	GrabLocation = ETVRLeftRight::None;
+	GunAudio = nullptr;
 }
 
 void UTVRChargingHandle::BeginPlay()
 {
 	Super::BeginPlay();
-	if(ChargingHandleSoundCue && !AudioComponent)
+	if(ChargingHandleSoundCue)
 	{
-		AudioComponent = NewObject<UAudioComponent>(GetOwner());
-		AudioComponent->bAutoActivate = false;
-		AudioComponent->AttachToComponent(this, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
-		AudioComponent->SetSound(ChargingHandleSoundCue);
+		GunAudio = UTVRGunAudioComponent::FindOrCreate(GetOwner());
 	}
 	
 	InitialRelativeTransform = GetRelativeTransform();}
@@ -72,6 +71,7 @@ void UTVRChargingHandle::TickComponent(float DeltaTime, ELevelTick Tick, FActorC
 			ChargingHandleSpeed = 0.f;
 			SetComponentTickEnabled(false);
 		}
+		EventTickNative.Broadcast(DeltaTime);
 		if(EventTick.IsBound())
 		{
 			EventTick.Broadcast(DeltaTime);
@@ -118,6 +118,7 @@ void UTVRChargingHandle::TickGrip_Implementation(UGripMotionControllerComponent*
 	ChargingHandleSpeed = (PreviousProgress - CurrentProgress) / DeltaTime / MaxDeflection;
 
 	
+	EventTickGripNative.Broadcast(GrippingController, GripInformation, DeltaTime);
 	if(EventTickGrip.IsBound())
 	{
 		EventTickGrip.Broadcast(GrippingController, GripInformation, DeltaTime);
@@ -183,41 +184,61 @@ void UTVRChargingHandle::SetProgress_Implementation(float Value)
 
 void UTVRChargingHandle::OnBoltClosed_Implementation() const
 {
-	if(!Execute_IsReciprocating(this) && AudioComponent)
+	if(Execute_IsReciprocating(this))
+	{
+		return;
+	}
+	// the bolt closes inside of the gun, so the sound is played at the gun
+	if(UAudioComponent* Voice = GunAudio ? GunAudio->PrepareOneShot(ChargingHandleSoundCue, GetOwner()->GetRootComponent()) : nullptr)
 	{
-		AudioComponent->Stop();
 		// const float VolumeBase = FMath::Abs(ChargingHandleSpeed * MaxDeflection) * 0.5f;
-		AudioComponent->SetVolumeMultiplier(1.f);
-		AudioComponent->SetBoolParameter(FName("Back"), false);
-		// AudioComponent->SetBoolParameter(FName("Pump"), true);
-		AudioComponent->Play();
+		Voice->SetVolumeMultiplier(1.f);
+		Voice->SetBoolParameter(FName("Back"), false);
+		// Voice->SetBoolParameter(FName("Pump"), true);
+		Voice->Play();
 	}
 }
 
 void UTVRChargingHandle::PlayRackBackSound()
 {
-	if(bShouldPlayBackSound && AudioComponent)
+	if(!bShouldPlayBackSound)
+	{
+		return;
+	}
+	bShouldPlayBackSound = false;
+	if(UAudioComponent* Voice = GunAudio ? GunAudio->PrepareOneShot(ChargingHandleSoundCue, this) : nullptr)
 	{
-		bShouldPlayBackSound = false;
-		AudioComponent->Stop();
 		const float VolumeBase = FMath::Abs(ChargingHandleSpeed * MaxDeflection)* 0.5f;
-		AudioComponent->SetVolumeMultiplier(FMath::Clamp(VolumeBase, 0.65f, 1.f));
-		AudioComponent->SetBoolParameter(FName("Back"), true);
-		// AudioComponent->SetBoolParameter(FName("Pump"), true);
-		AudioComponent->Play();
+		Voice->SetVolumeMultiplier(FMath::Clamp(VolumeBase, 0.65f, 1.f));
+		Voice->SetBoolParameter(FName("Back"), true);
+		// Voice->SetBoolParameter(FName("Pump"), true);
+		Voice->Play();
 	}
 }
 
 void UTVRChargingHandle::PlayCloseSound()
 {
-	if(bShouldPlayCloseSound && AudioComponent)
+	if(!bShouldPlayCloseSound)
+	{
+		return;
+	}
+	bShouldPlayCloseSound = false;
+	if(UAudioComponent* Voice = GunAudio ? GunAudio->PrepareOneShot(ChargingHandleSoundCue, this) : nullptr)
 	{
-		bShouldPlayCloseSound = false;
-		AudioComponent->Stop();
 		const float VolumeBase = FMath::Abs(ChargingHandleSpeed * MaxDeflection) * 0.5f;
-		AudioComponent->SetVolumeMultiplier(FMath::Clamp(VolumeBase, 0.1f, 1.f));
-		AudioComponent->SetBoolParameter(FName("Back"), false);
-		// AudioComponent->SetBoolParameter(FName("Pump"), true);
-		AudioComponent->Play();
+		Voice->SetVolumeMultiplier(FMath::Clamp(VolumeBase, 0.1f, 1.f));
+		Voice->SetBoolParameter(FName("Back"), false);
+		// Voice->SetBoolParameter(FName("Pump"), true);
+		Voice->Play();
 	}
 }
+
+void UTVRChargingHandle::ResetForPool_Implementation()
+{
+	bIsLocked = false;
+	LockedProgress = 0.f;
+	ChargingHandleSpeed = 0.f;
+	bShouldPlayBackSound = false;
+	bShouldPlayCloseSound = false;
+	Execute_SetProgress(this, 0.f);
+}
@@ -8,6 +8,7 @@
 #include "Weapon/TVRCartridge.h"
 #include "Weapon/TVRGunBase.h"
 #include "Weapon/TVRSpentCartridge.h"
+#include "Weapon/Component/TVRGunAudioComponent.h"
 #include "Weapon/Component/TVRMagazineCompInterface.h"
 
 UTVREjectionPort::UTVREjectionPort(const FObjectInitializer& OI) : Super(OI)
@@ -33,30 +34,36 @@ UTVREjectionPort::UTVREjectionPort(const FObjectInitializer& OI) : Super(OI)
 void UTVREjectionPort::BeginPlay()
 {
 	Super::BeginPlay();
-	PopulateCartridgePool();
+	const ATVRGunBase* Gun = Cast<ATVRGunBase>(GetOwner());
+	if(Gun == nullptr || !Gun->IsWarmupPending())
+	{
+		// otherwise the pool is filled during the warm-up of the gun
+		PopulateCartridgePool();
+	}
 	OnComponentBeginOverlap.AddDynamic(this, &UTVREjectionPort::OnBeginOverlap);
 	const auto MagComp = GetOwner()->FindComponentByClass<UTVRMagazineCompInterface>();
 	LinkMagComp(MagComp);
 
-	if(EjectSound && EjectAudioComp == nullptr)
+	GunAudio = UTVRGunAudioComponent::FindOrCreate(GetOwner());
+}
+
+void UTVREjectionPort::ResetForPool_Implementation()
+{
+	// the casings stay in the pool, but the ones lying around belong to the previous user
+	for(ATVRSpentCartridge* PooledCartridge: CartridgePool)
 	{
-		EjectAudioComp = NewObject<UAudioComponent>(this, FName(TEXT("EjectAudio")));
-		EjectAudioComp->bAutoActivate = false;
-		EjectAudioComp->SetSound(EjectSound);
-		EjectAudioComp->AttachToComponent(this, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+		if(PooledCartridge && PooledCartridge->IsActive())
+		{
+			PooledCartridge->Deactivate();
+		}
 	}
+	CartridgePoolIdx = 0;
 }
 
 void UTVREjectionPort::OnComponentDestroyed(bool bDestroyingHierarchy)
 {
 	Super::OnComponentDestroyed(bDestroyingHierarchy);
 
-	if(EjectAudioComp && !EjectAudioComp->IsPendingKill())
-	{
-		EjectAudioComp->DestroyComponent();
-		EjectAudioComp = nullptr;
-	}
-	
 	if(EjectionArrow)
 	{
 		EjectionArrow->DestroyComponent();
@@ -149,17 +156,33 @@ void UTVREjectionPort::PopulateCartridgePool()
 		return;
 	}
 	
-	while(CartridgePool.Num() < CartridgePoolSize) {
-		ATVRSpentCartridge* NewPooledCartridge = GetWorld()->SpawnActor<ATVRSpentCartridge>(
-			SpentCartridgeClass, FVector::ZeroVector, FRotator::ZeroRotator);
-		NewPooledCartridge->Deactivate();
-		CartridgePool.Add(NewPooledCartridge);
-		NewPooledCartridge->OnDestroyed.AddDynamic(this, &UTVREjectionPort::OnPooledCartridgeDestroyed);
+	while(!PopulateCartridgePoolStep())
+	{
 	}
 }
 
+bool UTVREjectionPort::PopulateCartridgePoolStep()
+{
+	if(SpentCartridgeClass == nullptr || CartridgePool.Num() >= CartridgePoolSize)
+	{
+		return true;
+	}
+
+	ATVRSpentCartridge* NewPooledCartridge = GetWorld()->SpawnActor<ATVRSpentCartridge>(
+		SpentCartridgeClass, FVector::ZeroVector, FRotator::ZeroRotator);
+	NewPooledCartridge->Deactivate();
+	CartridgePool.Add(NewPooledCartridge);
+	NewPooledCartridge->OnDestroyed.AddDynamic(this, &UTVREjectionPort::OnPooledCartridgeDestroyed);
+	return CartridgePool.Num() >= CartridgePoolSize;
+}
+
 ATVRSpentCartridge* UTVREjectionPort::GetCartridgeFromPool()
 {
+	if(CartridgePool.Num() == 0)
+	{
+		// the gun fires before its warm-up got to the pool
+		PopulateCartridgePool();
+	}
 	if(CartridgePool.Num() > 0)
 	{
 		CartridgePoolIdx++;
@@ -222,11 +245,10 @@ ATVRCartridge* UTVREjectionPort::SpawnEjectedCartridge(TSubclassOf<ATVRCartridge
 			NewCartridge->GetStaticMeshComponent()->SetPhysicsAngularVelocityInDegrees(
 				EjectionTransform.TransformVector(FVector::UpVector) * EjectRotImpulse, false);
 
-			if(EjectAudioComp)
+			if(UAudioComponent* EjectVoice = GunAudio ? GunAudio->PrepareOneShot(EjectSound, this) : nullptr)
 			{
-				EjectAudioComp->Stop();
-				EjectAudioComp->SetBoolParameter(FName(TEXT("Insert")), false);
-				EjectAudioComp->Play();
+				EjectVoice->SetBoolParameter(FName(TEXT("Insert")), false);
+				EjectVoice->Play();
 			}
 			
 			return NewCartridge;
@@ -269,11 +291,10 @@ void UTVREjectionPort::TryLoadChamber(ATVRCartridge* Cartridge)
 			{
 				if(Gun->TryChamberNewRound(Cartridge->GetClass()))
 				{
-					if(EjectAudioComp)
+					if(UAudioComponent* EjectVoice = GunAudio ? GunAudio->PrepareOneShot(EjectSound, this) : nullptr)
 					{
-						EjectAudioComp->Stop();
-						EjectAudioComp->SetBoolParameter(FName(TEXT("Insert")), true);
-						EjectAudioComp->Play();
+						EjectVoice->SetBoolParameter(FName(TEXT("Insert")), true);
+						EjectVoice->Play();
 					}
 					Cartridge->Destroy();
 				}
@@ -0,0 +1,176 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#include "Weapon/Component/TVRGunAudioComponent.h"
+
+#include "Components/AudioComponent.h"
+#include "Sound/SoundBase.h"
+
+UTVRGunAudioComponent::UTVRGunAudioComponent(const FObjectInitializer& OI) : Super(OI)
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	MaxVoices = 3;
+	LoopVoice = INDEX_NONE;
+}
+
+void UTVRGunAudioComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	for(UAudioComponent* Voice: Voices)
+	{
+		if(Voice && !Voice->IsPendingKill())
+		{
+			Voice->DestroyComponent();
+		}
+	}
+	Voices.Empty();
+	VoiceStartTimes.Empty();
+	VoiceGenerations.Empty();
+	LoopVoice = INDEX_NONE;
+	Super::EndPlay(EndPlayReason);
+}
+
+UTVRGunAudioComponent* UTVRGunAudioComponent::FindOrCreate(AActor* Actor)
+{
+	if(Actor == nullptr)
+	{
+		return nullptr;
+	}
+	UTVRGunAudioComponent* GunAudio = Actor->FindComponentByClass<UTVRGunAudioComponent>();
+	if(GunAudio == nullptr)
+	{
+		GunAudio = NewObject<UTVRGunAudioComponent>(Actor, FName(TEXT("GunAudio")));
+		GunAudio->RegisterComponent();
+	}
+	return GunAudio;
+}
+
+UAudioComponent* UTVRGunAudioComponent::PrepareOneShot(USoundBase* Sound, USceneComponent* AttachParent, FTVRGunVoiceHandle* OutHandle)
+{
+	if(OutHandle)
+	{
+		*OutHandle = FTVRGunVoiceHandle();
+	}
+	if(Sound == nullptr || AttachParent == nullptr || GetNetMode() == NM_DedicatedServer)
+	{
+		return nullptr;
+	}
+	const int32 VoiceIdx = AcquireVoice();
+	if(VoiceIdx == INDEX_NONE)
+	{
+		return nullptr;
+	}
+	UAudioComponent* Voice = SetupVoice(VoiceIdx, Sound, AttachParent);
+	if(OutHandle)
+	{
+		OutHandle->VoiceIdx = VoiceIdx;
+		OutHandle->Generation = VoiceGenerations[VoiceIdx];
+	}
+	return Voice;
+}
+
+UAudioComponent* UTVRGunAudioComponent::GetVoice(const FTVRGunVoiceHandle& Handle) const
+{
+	if(Voices.IsValidIndex(Handle.VoiceIdx) && VoiceGenerations[Handle.VoiceIdx] == Handle.Generation)
+	{
+		return Voices[Handle.VoiceIdx];
+	}
+	return nullptr;
+}
+
+UAudioComponent* UTVRGunAudioComponent::PrepareLoop(USoundBase* Sound, USceneComponent* AttachParent)
+{
+	if(Sound == nullptr || AttachParent == nullptr || GetNetMode() == NM_DedicatedServer)
+	{
+		return nullptr;
+	}
+	if(LoopVoice == INDEX_NONE)
+	{
+		LoopVoice = AcquireVoice();
+		if(LoopVoice == INDEX_NONE)
+		{
+			return nullptr;
+		}
+	}
+	return SetupVoice(LoopVoice, Sound, AttachParent);
+}
+
+void UTVRGunAudioComponent::StopLoop(float FadeOutTime)
+{
+	if(Voices.IsValidIndex(LoopVoice) && Voices[LoopVoice])
+	{
+		if(FadeOutTime > 0.f)
+		{
+			Voices[LoopVoice]->FadeOut(FadeOutTime, 0.f);
+		}
+		else
+		{
+			Voices[LoopVoice]->Stop();
+		}
+	}
+	LoopVoice = INDEX_NONE;
+}
+
+bool UTVRGunAudioComponent::IsLoopPlaying() const
+{
+	return Voices.IsValidIndex(LoopVoice) && Voices[LoopVoice] && Voices[LoopVoice]->IsPlaying();
+}
+
+int32 UTVRGunAudioComponent::AcquireVoice()
+{
+	int32 OldestVoice = INDEX_NONE;
+	for(int32 Idx = 0; Idx < Voices.Num(); Idx++)
+	{
+		if(Idx == LoopVoice)
+		{
+			continue;
+		}
+		if(Voices[Idx] == nullptr || !Voices[Idx]->IsPlaying())
+		{
+			return Idx;
+		}
+		if(OldestVoice == INDEX_NONE || VoiceStartTimes[Idx] < VoiceStartTimes[OldestVoice])
+		{
+			OldestVoice = Idx;
+		}
+	}
+
+	if(Voices.Num() < MaxVoices)
+	{
+		Voices.Add(nullptr);
+		VoiceStartTimes.Add(0.f);
+		VoiceGenerations.Add(0);
+		return Voices.Num() - 1;
+	}
+	return OldestVoice;
+}
+
+UAudioComponent* UTVRGunAudioComponent::SetupVoice(int32 VoiceIdx, USoundBase* Sound, USceneComponent* AttachParent)
+{
+	UAudioComponent* Voice = Voices[VoiceIdx];
+	if(Voice == nullptr || Voice->IsPendingKill())
+	{
+		Voice = NewObject<UAudioComponent>(GetOwner());
+		Voice->bAutoActivate = false;
+		Voice->RegisterComponent();
+		Voices[VoiceIdx] = Voice;
+	}
+	else
+	{
+		Voice->Stop();
+		// parameters of the previous sound must not leak into the next one
+		Voice->InstanceParameters.Reset();
+		Voice->VolumeMultiplier = 1.f;
+		Voice->PitchMultiplier = 1.f;
+	}
+
+	if(Voice->GetAttachParent() != AttachParent)
+	{
+		Voice->AttachToComponent(AttachParent, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+	}
+	if(Voice->Sound != Sound)
+	{
+		Voice->SetSound(Sound);
+	}
+	VoiceStartTimes[VoiceIdx] = GetWorld()->GetTimeSeconds();
+	VoiceGenerations[VoiceIdx]++;
+	return Voice;
+}
@@ -3,20 +3,55 @@
 #include "Weapon/Component/TVRGunFireComponent.h"
 
 #include "Components/AudioComponent.h"
-#include "Components/DecalComponent.h"
+#include "Components/TVRHitboxComponent.h"
 #include "Components/TVRGunHapticsComponent.h"
+#include "Components/TVRHapticsMixerComponent.h"
+#include "GameFramework/WorldSettings.h"
+#include "GripMotionControllerComponent.h"
 #include "Kismet/GameplayStatics.h"
-#include "Kismet/KismetMathLibrary.h"
+#include "Net/UnrealNetwork.h"
+#include "Materials/MaterialInterface.h"
 #include "Particles/ParticleSystemComponent.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
 #include "Player/TVRCharacter.h"
 #include "Player/TVRPlayerController.h"
+#include "Settings/TVRCoreWeaponSettings.h"
+#include "Subsystems/TVRBallisticsSubsystem.h"
+#include "Subsystems/TVRDamageQueueSubsystem.h"
+#include "Subsystems/TVRFlyBySubsystem.h"
+#include "Subsystems/TVRFXPreloadSubsystem.h"
+#include "Subsystems/TVRHitboxSubsystem.h"
+#include "Subsystems/TVRImpactAudioSubsystem.h"
+#include "Subsystems/TVRImpactFXSubsystem.h"
+#include "TacticalTraceChannels.h"
 #include "Weapon/TVRGunBase.h"
 #include "Weapon/TVRGunWithChild.h"
 #include "Weapon/TVRCartridge.h"
+#include "Weapon/TVRProjectile.h"
 #include "Weapon/Attachments/TVRWeaponAttachment.h"
 #include "Weapon/Component/TVRAttachmentPoint.h"
 #include "Weapon/Component/TVRChargingHandleInterface.h"
+#include "Weapon/Component/TVRGunAudioComponent.h"
+#include "Weapon/Component/TVRMagazineCompInterface.h"
+#include "Weapon/Component/TVRTriggerComponent.h"
+
+namespace TVRGunFire
+{
+	const FName KickHapticsSource(TEXT("GunKick"));
+
+	/** The shot ends where the bullet stops flying. */
+	float GetTrajectoryDistance(const ATVRCartridge* AmmoCDO, const FTVRTrajectoryTable& Trajectory)
+	{
+		return Trajectory.IsValid() ? FMath::Min(AmmoCDO->GetTraceDistance(), Trajectory.GetMaxDistance())
+			: AmmoCDO->GetTraceDistance();
+	}
+
+	/** Shots that hit nothing are sent as a hit without any component, that only carries the path of the bullet. */
+	bool IsMissedShot(const FHitResult& Hit)
+	{
+		return !Hit.bBlockingHit && Hit.GetComponent() == nullptr;
+	}
+}
 
 // Sets default values for this component's properties
 UTVRGunFireComponent::UTVRGunFireComponent(const FObjectInitializer& OI) : Super(OI)
@@ -24,11 +59,14 @@ UTVRGunFireComponent::UTVRGunFireComponent(const FObjectInitializer& OI) : Super
 	// Set this component to be initialized when the game starts, and to be ticked every frame. You can turn these
 	// features off to improve performance if you don't need them.
 	PrimaryComponentTick.bCanEverTick = false;
+	SetIsReplicatedByDefault(true);
 	MuzzleFlashPSC = nullptr;
-	FireAudioComp = nullptr;
-	EmptyAudioComp = nullptr;
+	GunAudio = nullptr;
 	FireSoundCue = nullptr;
 	EmptySoundCue = nullptr;
+	NumCollectingShells = 0;
+	AutoFireLoopSound = nullptr;
+	AutoFireTailSound = nullptr;
 
 	ShotCount = 0;
 	bIsFiring = false;
@@ -49,18 +87,35 @@ UTVRGunFireComponent::UTVRGunFireComponent(const FObjectInitializer& OI) : Super
 	
 	bUseGunHapticsPistolGrip = false;
 	bUseGunHapticsButtstock = false;
+	ControllerKickAmplitude = 0.f;
+	ControllerKickFrequency = 0.5f;
+	ControllerKickDuration = 0.05f;
+	ControllerKickPriority = 100;
 
 	bIsSuppressed = false;
 	MuzzleFlashOverride = nullptr;
 	
 	bDefaultSuppressed = false;
-	ImpactSoundComp = nullptr;
+	bTraceQueryCacheValid = false;
+	LastAuthorityFireTime = -1.f;
+	bPredictShots = false;
+	PredictedShotCadenceTolerance = 0.5f;
+	DeferredShotSequence = 0;
+	LocalShotSequence = 0;
+	bUseLateUpdatedMuzzlePose = false;
+	TriggerBreakLatency = 0.f;
+
+	bUseNetInterestManagement = true;
+	FullEventRange = 15000.f;
+	DistantEventRange = 100000.f;
+	DistantEventInterval = 0.5f;
+	LastDistantEventTime = -1.f;
 }
 
 void UTVRGunFireComponent::SetSuppressed(bool NewValue)
 {
 	bIsSuppressed = NewValue;
-	if(FireAudioComp)
+	if(UAudioComponent* FireAudioComp = GunAudio ? GunAudio->GetVoice(FireVoice) : nullptr)
 	{
 		FireAudioComp->SetBoolParameter(FName("IsSuppressed"), bIsSuppressed);
 	}
@@ -77,20 +132,7 @@ void UTVRGunFireComponent::BeginPlay()
 	Super::BeginPlay();
 	RandomFiringStream.GenerateNewSeed();
 	
-	// The order here determines the priority.
-	// all weapons start out in single shot
-	if(bHasSingleShot)
-	{
-		CurrentFireMode = ETVRFireMode::Single;
-	}
-	else if(bHasFullAuto)
-	{
-		CurrentFireMode = ETVRFireMode::Automatic;
-	}
-	else
-	{
-		CurrentFireMode = ETVRFireMode::Burst;
-	}
+	CurrentFireMode = GetInitialFireMode();
 	
 	RefireTime = 60.f/RateOfFireRPM;
 	
@@ -107,20 +149,7 @@ void UTVRGunFireComponent::BeginPlay()
 		}
 	}
 	
-	if(FireSoundCue && !FireAudioComp)
-	{
-		FireAudioComp = NewObject<UAudioComponent>(GetOwner(), FName("FiringAudio"));
-		FireAudioComp->AttachToComponent(this, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
-		FireAudioComp->SetSound(FireSoundCue);
-		FireAudioComp->bAutoActivate = false;
-	}
-	if(EmptySoundCue && !EmptyAudioComp)
-	{
-		EmptyAudioComp = NewObject<UAudioComponent>(GetOwner(), FName("EmptyAudio"));
-		EmptyAudioComp->AttachToComponent(this, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
-		EmptyAudioComp->SetSound(EmptySoundCue);
-		EmptyAudioComp->bAutoActivate = false;
-	}
+	GunAudio = UTVRGunAudioComponent::FindOrCreate(GetOwner());
 	
 	bDefaultSuppressed = bIsSuppressed;
 	SetSuppressed(bIsSuppressed);
@@ -128,22 +157,61 @@ void UTVRGunFireComponent::BeginPlay()
 	
 }
 
-void UTVRGunFireComponent::PostInitProperties()
+void UTVRGunFireComponent::ResetForPool_Implementation()
 {
-	Super::PostInitProperties();
-	RefireTime = 60.f/RateOfFireRPM;
+	bIsFiring = false;
+	ShotCount = 0;
+	TriggerBreakLatency = 0.f;
+	if(GetNetMode() != NM_DedicatedServer)
+	{
+		StopFireLoop();
+	}
+	GetWorldTimerManager().ClearTimer(RefireTimer);
+	GetWorldTimerManager().ClearTimer(DeferredShotTimer);
+
+	LoadedCartridge = nullptr;
+	bCartridgeIsSpent = false;
+	CurrentFireMode = GetInitialFireMode();
+	ResetSuppressed();
+	InvalidateTraceQueryCache();
+
+	// sequence numbers keep counting, so late RPCs of the previous user are still recognized as old
+	PredictedShots.Empty();
+	LocalShotSequence = AuthShotState.ShotSequence;
+	UpdateAuthAmmoCount();
+	NumCollectingShells = 0;
+	PendingPelletHits.Reset();
 }
 
-void UTVRGunFireComponent::BeginDestroy()
+ETVRFireMode UTVRGunFireComponent::GetInitialFireMode() const
 {
-	if(FireAudioComp && !FireAudioComp->IsPendingKill())
+	// The order here determines the priority.
+	// all weapons start out in single shot
+	if(bHasSingleShot)
 	{
-		FireAudioComp->DestroyComponent();
+		return ETVRFireMode::Single;
 	}
-	if(EmptyAudioComp && !EmptyAudioComp->IsPendingKill())
+	if(bHasFullAuto)
 	{
-		EmptyAudioComp->DestroyComponent();
+		return ETVRFireMode::Automatic;
 	}
+	return ETVRFireMode::Burst;
+}
+
+void UTVRGunFireComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	DOREPLIFETIME(UTVRGunFireComponent, AuthShotState);
+}
+
+void UTVRGunFireComponent::PostInitProperties()
+{
+	Super::PostInitProperties();
+	RefireTime = 60.f/RateOfFireRPM;
+}
+
+void UTVRGunFireComponent::BeginDestroy()
+{
 	Super::BeginDestroy();
 }
 
@@ -162,6 +230,17 @@ bool UTVRGunFireComponent::IsOwnerLocalPlayerController() const
 	return false;
 }
 
+bool UTVRGunFireComponent::IsShotReportedByClient() const
+{
+	if(GetOwner()->GetLocalRole() != ROLE_Authority)
+	{
+		return false;
+	}
+	const ACharacter* CharOwner = GetCharacterOwner();
+	const AController* Controller = CharOwner ? CharOwner->GetController() : nullptr;
+	return Controller && Controller->IsPlayerController() && !Controller->IsLocalController();
+}
+
 ACharacter* UTVRGunFireComponent::GetCharacterOwner() const
 {
 	AActor* TestOwner = GetOwner();
@@ -190,12 +269,84 @@ ATVRCharacter* UTVRGunFireComponent::GetVRCharacterOwner() const
 	return nullptr;
 }
 
+ATVRGunBase* UTVRGunFireComponent::GetGunOwner() const
+{
+	if(GetOwner())
+	{
+		if(const auto GunOwner = Cast<ATVRGunBase>(GetOwner()))
+		{
+			return GunOwner;
+		}
+		if(const auto AttachmentOwner = Cast<ATVRWeaponAttachment>(GetOwner()))
+		{
+			return AttachmentOwner->GetGunOwner();
+		}
+	}
+	return nullptr;
+}
+
+UGripMotionControllerComponent* UTVRGunFireComponent::GetAimingController() const
+{
+	if(const auto Gun = GetGunOwner())
+	{
+		if(Gun->IsHeldByParentGun())
+		{
+			return Gun->GetParentGun()->GetPrimaryController();
+		}
+		return Gun->GetPrimaryController();
+	}
+	return nullptr;
+}
+
+bool UTVRGunFireComponent::GetLateUpdatedMuzzleTransform(FTransform& OutTransform) const
+{
+	UGripMotionControllerComponent* Controller = GetAimingController();
+	if(Controller == nullptr || !IsOwnerLocalPlayerController())
+	{
+		return false;
+	}
+
+	FVector Position;
+	FRotator Orientation;
+	const float WorldToMeters = GetWorld()->GetWorldSettings()->WorldToMeters;
+	if(!Controller->GripPollControllerState(Position, Orientation, WorldToMeters))
+	{
+		return false;
+	}
+
+	// rebuild the controller transform the same way the motion controller does during its tick
+	FTransform LateControllerTF(Orientation, Position, Controller->GetRelativeScale3D());
+	if(Controller->bOffsetByControllerProfile)
+	{
+		LateControllerTF = Controller->CurrentControllerProfileTransform * LateControllerTF;
+	}
+	if(const USceneComponent* TrackingOrigin = Controller->GetAttachParent())
+	{
+		LateControllerTF = LateControllerTF * TrackingOrigin->GetComponentTransform();
+	}
+
+	// the muzzle relative to the controller pose of this frame contains both the grip offset and the constraint error
+	const FTransform MuzzleToController = GetComponentTransform().GetRelativeTransform(Controller->GetComponentTransform());
+	OutTransform = MuzzleToController * LateControllerTF;
+	return true;
+}
+
 
 float UTVRGunFireComponent::GetRefireTime() const
 {
 	return FMath::Max(RefireTime, 0.02f);
 }
 
+FTransform UTVRGunFireComponent::GetMuzzleTransform() const
+{
+	FTransform LateMuzzleTF;
+	if(bUseLateUpdatedMuzzlePose && GetLateUpdatedMuzzleTransform(LateMuzzleTF))
+	{
+		return LateMuzzleTF;
+	}
+	return GetComponentTransform();
+}
+
 
 bool UTVRGunFireComponent::HasRoundLoaded() const
 {
@@ -208,6 +359,7 @@ void UTVRGunFireComponent::StartEmpty()
 	{
 		LocalSimulateEmpty();
 	}
+	OnEmptyNative.Broadcast();
 	if(OnEmpty.IsBound())
 	{
 		OnEmpty.Broadcast();
@@ -215,9 +367,19 @@ void UTVRGunFireComponent::StartEmpty()
 }
 
 void UTVRGunFireComponent::StartFire()
+{
+	StartFireAtTime(FPlatformTime::Seconds());
+}
+
+void UTVRGunFireComponent::StartFireAtTime(double TriggerBreakTime)
 {
 	if(!IsInFiringCooldown())
 	{
+		// a break older than a full cycle does not belong to this trigger pull and is ignored.
+		// never compensate more than half a cycle, otherwise a hitch could make the gun fire twice in the same frame
+		const float BreakLatency = TriggerBreakTime > 0.0 ? static_cast<float>(FPlatformTime::Seconds() - TriggerBreakTime) : 0.f;
+		TriggerBreakLatency = BreakLatency <= GetRefireTime() ? FMath::Clamp(BreakLatency, 0.f, GetRefireTime() * 0.5f) : 0.f;
+		
 		ShotCount = 0;
 		bIsFiring = true;
 		
@@ -229,8 +391,10 @@ void UTVRGunFireComponent::StartFire()
 		{
 			Fire();
 		}
+		// only the first cycle of this pull is compensated, whether it fired or not
+		TriggerBreakLatency = 0.f;
 
-		if(GetOwner()->GetLocalRole() != ROLE_Authority)
+		if(GetOwner()->GetLocalRole() != ROLE_Authority && !IsPredictingShots())
 		{
 			ServerStartFire();
 		}
@@ -239,6 +403,11 @@ void UTVRGunFireComponent::StartFire()
 
 void UTVRGunFireComponent::ServerStartFire_Implementation()
 {
+	if(!ConsumeOwnerRpcToken())
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("%s: dropped ServerStartFire, rate limit exceeded"), *GetName());
+		return;
+	}
 	StartFire();
 }
 
@@ -246,7 +415,12 @@ void UTVRGunFireComponent::StopFire()
 {
 	bIsFiring = false;
 	ShotCount = 0;
-	if(GetOwner()->GetLocalRole() != ROLE_Authority)
+	TriggerBreakLatency = 0.f;
+	if(GetNetMode() != NM_DedicatedServer)
+	{
+		StopFireLoop();
+	}
+	if(GetOwner()->GetLocalRole() != ROLE_Authority && !IsPredictingShots())
 	{
 		ServerStopFire();
 	}
@@ -257,6 +431,201 @@ void UTVRGunFireComponent::ServerStopFire_Implementation()
 	StopFire();
 }
 
+bool UTVRGunFireComponent::IsPredictingShots() const
+{
+	return bPredictShots && GetOwner()->GetLocalRole() != ROLE_Authority && IsOwnerLocalPlayerController();
+}
+
+void UTVRGunFireComponent::PredictShot()
+{
+	// shots the server never answered (lost rpc) are dropped, the ammo will be corrected by the next state
+	constexpr float PredictedShotTimeout = 2.f;
+	const float Now = GetWorld()->GetTimeSeconds();
+	PredictedShots.RemoveAll([Now](const FTVRPredictedShot& Shot)
+	{
+		return Now - Shot.Time > PredictedShotTimeout;
+	});
+
+	// continue after the last sequence of the server, e.g. if another player has used this gun before
+	if(PredictedShots.Num() == 0 && IsShotSequenceNewer(AuthShotState.ShotSequence, LocalShotSequence))
+	{
+		LocalShotSequence = AuthShotState.ShotSequence;
+	}
+	LocalShotSequence++;
+	PredictedShots.Add({LocalShotSequence, Now});
+	ServerFireShot(LocalShotSequence);
+}
+
+void UTVRGunFireComponent::ServerFireShot_Implementation(uint16 Sequence)
+{
+	if(!ConsumeOwnerRpcToken() || !IsShotSequenceNewer(Sequence, AuthShotState.ShotSequence))
+	{
+		return;
+	}
+
+	if(CanAuthorityFirePredictedShot())
+	{
+		AuthorityFirePredictedShot(Sequence);
+	}
+	else if(!GetWorldTimerManager().IsTimerActive(DeferredShotTimer) && LastAuthorityFireTime >= 0.f
+		&& GetWorld()->GetTimeSeconds() - LastAuthorityFireTime < GetRefireTime() * 2.f)
+	{
+		// jitter can make a shot arrive before the gun has cycled on the server, give it one more chance
+		DeferredShotSequence = Sequence;
+		const float RetryDelay = FMath::Max(GetRefireCooldownRemaining(), GetRefireTime() * PredictedShotCadenceTolerance);
+		GetWorldTimerManager().SetTimer(DeferredShotTimer, this, &UTVRGunFireComponent::RetryDeferredShot, RetryDelay, false);
+	}
+	else
+	{
+		AuthShotState.ShotSequence = Sequence;
+		ClientRejectShot(Sequence);
+	}
+}
+
+bool UTVRGunFireComponent::CanAuthorityFirePredictedShot() const
+{
+	if(!HasRoundLoaded() || bCartridgeIsSpent || !CanFire())
+	{
+		return false;
+	}
+	return !IsInFiringCooldown() || GetRefireCooldownRemaining() <= GetRefireTime() * PredictedShotCadenceTolerance;
+}
+
+void UTVRGunFireComponent::AuthorityFirePredictedShot(uint16 Sequence)
+{
+	if(IsInFiringCooldown())
+	{
+		// the client has already finished this cycle, so the server has to as well
+		EndCycle();
+	}
+	
+	// the client drives the cadence, so every predicted shot is a single shot on the server
+	bIsFiring = true;
+	ShotCount = 0;
+	Fire();
+	bIsFiring = false;
+	AuthShotState.ShotSequence = Sequence;
+}
+
+void UTVRGunFireComponent::RetryDeferredShot()
+{
+	if(!IsShotSequenceNewer(DeferredShotSequence, AuthShotState.ShotSequence))
+	{
+		return;
+	}
+	
+	if(CanAuthorityFirePredictedShot())
+	{
+		AuthorityFirePredictedShot(DeferredShotSequence);
+	}
+	else
+	{
+		AuthShotState.ShotSequence = DeferredShotSequence;
+		ClientRejectShot(DeferredShotSequence);
+	}
+}
+
+void UTVRGunFireComponent::ClientRejectShot_Implementation(uint16 Sequence)
+{
+	const int32 NumRemoved = PredictedShots.RemoveAll([Sequence](const FTVRPredictedShot& Shot)
+	{
+		return Shot.Sequence == Sequence;
+	});
+	if(NumRemoved == 0)
+	{
+		return;
+	}
+	
+	// only the most recent shot can still have cosmetics running
+	if(Sequence == LocalShotSequence)
+	{
+		RollbackShotCosmetics();
+	}
+	if(OnShotRejected.IsBound())
+	{
+		OnShotRejected.Broadcast();
+	}
+}
+
+void UTVRGunFireComponent::OnRep_AuthShotState(const FTVRAuthShotState& PrevState)
+{
+	if(IsPredictingShots())
+	{
+		const uint16 ServerSequence = AuthShotState.ShotSequence;
+		PredictedShots.RemoveAll([ServerSequence](const FTVRPredictedShot& Shot)
+		{
+			return !IsShotSequenceNewer(Shot.Sequence, ServerSequence);
+		});
+		ReconcileAmmo();
+	}
+	else if(AuthShotState.FiredShotCounter != PrevState.FiredShotCounter)
+	{
+		if(OnShotConfirmed.IsBound())
+		{
+			OnShotConfirmed.Broadcast();
+		}
+	}
+}
+
+void UTVRGunFireComponent::RollbackShotCosmetics()
+{
+	if(MuzzleFlashOverride)
+	{
+		MuzzleFlashOverride->Deactivate();
+	}
+	else if(MuzzleFlashPSC)
+	{
+		MuzzleFlashPSC->Deactivate();
+	}
+	
+	if(UAudioComponent* FireAudioComp = GunAudio ? GunAudio->GetVoice(FireVoice) : nullptr)
+	{
+		FireAudioComp->FadeOut(0.05f, 0.f);
+	}
+	if(GunAudio && GunAudio->IsLoopPlaying() && !bIsFiring)
+	{
+		GetWorldTimerManager().ClearTimer(FireLoopTimer);
+		GunAudio->StopLoop(0.05f);
+	}
+}
+
+void UTVRGunFireComponent::UpdateAuthAmmoCount()
+{
+	if(GetOwner() && GetOwner()->GetLocalRole() == ROLE_Authority)
+	{
+		AuthShotState.AmmoCount = static_cast<int16>(FMath::Min<int32>(GetAvailableAmmoCount(), MAX_int16));
+	}
+}
+
+int32 UTVRGunFireComponent::GetAvailableAmmoCount() const
+{
+	int32 Ammo = HasRoundLoaded() && !bCartridgeIsSpent ? 1 : 0;
+	const ATVRGunBase* Gun = GetGunOwner();
+	if(Gun && Gun->GetMagInterface())
+	{
+		Ammo += Gun->GetMagInterface()->GetAmmoCount();
+	}
+	return Ammo;
+}
+
+void UTVRGunFireComponent::ReconcileAmmo()
+{
+	const ATVRGunBase* Gun = GetGunOwner();
+	if(AuthShotState.AmmoCount < 0 || Gun == nullptr || Gun->GetMagInterface() == nullptr)
+	{
+		return;
+	}
+
+	// every shot that is still in flight has consumed a round that the server has not seen yet
+	const int32 ExpectedAmmo = FMath::Max(AuthShotState.AmmoCount - PredictedShots.Num(), 0);
+	const int32 AmmoError = ExpectedAmmo - GetAvailableAmmoCount();
+	if(AmmoError != 0)
+	{
+		UTVRMagazineCompInterface* MagInterface = Gun->GetMagInterface();
+		MagInterface->ReconcileAmmoCount(MagInterface->GetAmmoCount() + AmmoError);
+	}
+}
+
 bool UTVRGunFireComponent::IsInFiringCooldown() const
 {
 	return GetWorldTimerManager().IsTimerActive(RefireTimer);
@@ -268,6 +637,7 @@ bool UTVRGunFireComponent::TryLoadCartridge(TSubclassOf<ATVRCartridge> NewCartri
 	{
 		LoadedCartridge = NewCartridge;
 		bCartridgeIsSpent = false;
+		UpdateAuthAmmoCount();
 		return true;
 	}
 	return false;
@@ -279,6 +649,7 @@ TSubclassOf<ATVRCartridge> UTVRGunFireComponent::TryEjectCartridge()
 	{
 		auto EjectedCartridge = LoadedCartridge;
 		LoadedCartridge = nullptr;
+		UpdateAuthAmmoCount();
 		return EjectedCartridge;
 	}
 	return nullptr;
@@ -322,6 +693,23 @@ float UTVRGunFireComponent::GetDamage(TSubclassOf<ATVRCartridge> Cartridge) cons
 }
 
 
+float UTVRGunFireComponent::GetMuzzleVelocityModifier() const
+{
+	float VelocityMod = 1.f;
+	if(const auto Gun = Cast<ATVRGunBase>(GetOwner()))
+	{
+		for(const auto AttachPoint: Gun->GetAttachmentPoints())
+		{
+			if(const auto WPNA = AttachPoint->GetCurrentAttachment())
+			{
+				VelocityMod *= WPNA->GetMuzzleVelocityModifier();
+			}
+		}
+	}
+	return VelocityMod;
+}
+
+
 bool UTVRGunFireComponent::ShouldRefire() const
 {
 	if(bIsFiring && HasRoundLoaded() && CanFire())
@@ -345,10 +733,25 @@ void UTVRGunFireComponent::Fire()
 	if(ShouldRefire())
 	{
 		const auto AmmoCDO = LoadedCartridge->GetDefaultObject<ATVRCartridge>();
+		const FTransform MuzzleTF = GetMuzzleTransform();
+		const FVector MuzzleLoc = MuzzleTF.GetLocation();
+		const FVector MuzzleDir = MuzzleTF.GetUnitAxis(EAxis::X);
 		
 		SimulateFire();        
 		ShotCount++;
 		bCartridgeIsSpent = true;
+		if(GetOwner()->GetLocalRole() == ROLE_Authority)
+		{
+			LastAuthorityFireTime = GetWorld()->GetTimeSeconds();
+			AuthShotState.ShotSequence++;
+			AuthShotState.FiredShotCounter++;
+			UpdateAuthAmmoCount();
+		}
+		else if(IsPredictingShots())
+		{
+			PredictShot();
+		}
+		OnCartridgeSpentNative.Broadcast();
 		if(OnCartridgeSpent.IsBound())
 		{
 			OnCartridgeSpent.Broadcast();
@@ -356,28 +759,51 @@ void UTVRGunFireComponent::Fire()
 
 		if(FireOverride.IsBound())
 		{
-			FireOverride.Broadcast(GetForwardVector(), LoadedCartridge);
+			FireOverride.Broadcast(MuzzleDir, LoadedCartridge);
+		}
+		else if(AmmoCDO->IsProjectile())
+		{
+			const uint8 NumProjectiles = AmmoCDO->IsBuckshot() ? AmmoCDO->GetNumBuckshot() : 1;
+			const float Spread = AmmoCDO->IsBuckshot() ? FMath::DegreesToRadians(AmmoCDO->GetBuckshotSpread()) : 0.f;
+			for(uint8 i = 0; i < NumProjectiles; i++)
+			{
+				const FVector ProjectileDir = Spread > 0.f ? RandomFiringStream.VRandCone(MuzzleDir, Spread) : MuzzleDir;
+				LaunchProjectile(AmmoCDO, MuzzleLoc, ProjectileDir);
+			}
 		}
 		else
 		{
 			if(AmmoCDO->IsBuckshot())
 			{
-				const FVector PendingBuckshotDir = GetForwardVector(); 
-				FireBuckshot(AmmoCDO->GetNumBuckshot(), AmmoCDO, PendingBuckshotDir);
+				// the pellets are traced over several frames, their damage is applied together after the last one
+				UTVRDamageQueueSubsystem* DamageQueue = GetWorld()->GetSubsystem<UTVRDamageQueueSubsystem>();
+				if(DamageQueue && GetOwner()->GetLocalRole() == ROLE_Authority)
+				{
+					DamageQueue->HoldDamage(GetOwner());
+				}
+				else if(GetOwner()->GetLocalRole() != ROLE_Authority)
+				{
+					NumCollectingShells++;
+				}
+				FireBuckshot(AmmoCDO->GetNumBuckshot(), AmmoCDO, MuzzleLoc, MuzzleDir);
 			}
 			else
 			{
 				TArray<FHitResult> Hits;
-				if(TraceFire(Hits, GetForwardVector() * AmmoCDO->GetTraceDistance()))
+				if(TraceShot(Hits, MuzzleLoc, MuzzleDir, AmmoCDO))
 				{
 					ProcessHits(Hits, LoadedCartridge);
-					const auto& LastHit = Hits.Last();
-					SimulateFlyBy(LastHit.TraceStart, LastHit.ImpactPoint, LoadedCartridge);
+				}
+				else
+				{
+					ProcessMiss(MuzzleLoc, MuzzleDir, AmmoCDO);
 				}
 			}
 		}
 
-		GetWorldTimerManager().SetTimer(RefireTimer, this, &UTVRGunFireComponent::ReFire, GetRefireTime(), false);
+		GetWorldTimerManager().SetTimer(RefireTimer, this, &UTVRGunFireComponent::ReFire, GetRefireTime() - TriggerBreakLatency, false);
+		TriggerBreakLatency = 0.f;
+		OnFireNative.Broadcast();
 		if(OnFire.IsBound())
 		{
 			OnFire.Broadcast();
@@ -386,17 +812,23 @@ void UTVRGunFireComponent::Fire()
 }
 
 void UTVRGunFireComponent::ReFire()
+{
+	EndCycle();
+	Fire();
+}
+
+void UTVRGunFireComponent::EndCycle()
 {
 	if(GetWorldTimerManager().TimerExists(RefireTimer))
 	{
 		GetWorldTimerManager().ClearTimer(RefireTimer);
 	}
 	
+	OnEndCycleNative.Broadcast();
 	if(OnEndCycle.IsBound())
 	{
 		OnEndCycle.Broadcast();
 	}
-	Fire();
 }
 
 void UTVRGunFireComponent::SimulateFire()
@@ -408,38 +840,92 @@ void UTVRGunFireComponent::SimulateFire()
     
 	if(GetOwner()->GetLocalRole() == ROLE_Authority) // Server: LocalRole == Authority, Client == Simulated Proxy
 	{
-		MulticastSimulateFire();
-	}
-}
-
-void UTVRGunFireComponent::MulticastSimulateFire_Implementation()
-{
-	if(!IsOwnerLocalPlayerController()) // already done for owner
-	{
-		LocalSimulateFire();
+		if(bUseNetInterestManagement)
+		{
+			SendSimulateFireToClients();
+		}
+		else
+		{
+			MulticastSimulateFire();
+		}
 	}
 }
 
-void UTVRGunFireComponent::LocalSimulateFire()
+void UTVRGunFireComponent::SendSimulateFireToClients()
 {
-	if(GetNetMode() != ENetMode::NM_DedicatedServer)
+	const FVector MuzzleLoc = GetComponentLocation();
+	const AController* OwnerController = GetCharacterOwner() ? GetCharacterOwner()->GetController() : nullptr;
+	const float Now = GetWorld()->GetTimeSeconds();
+	const bool bCanSendDistant = LastDistantEventTime < 0.f || Now - LastDistantEventTime >= DistantEventInterval;
+	bool bSentDistant = false;
+	
+	for(FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
 	{
-		if(MuzzleFlashOverride)
+		ATVRPlayerController* PC = Cast<ATVRPlayerController>(It->Get());
+		if(PC == nullptr || PC == OwnerController) // owner already simulated this due to forward prediction
 		{
-			MuzzleFlashOverride->Activate(true);
+			continue;
 		}
-		else if(MuzzleFlashPSC != nullptr)
+		
+		FVector ViewLoc;
+		FRotator ViewRot;
+		PC->GetPlayerViewPoint(ViewLoc, ViewRot);
+		const float DistSq = FVector::DistSquared(ViewLoc, MuzzleLoc);
+		if(DistSq <= FMath::Square(FullEventRange))
 		{
-			MuzzleFlashPSC->Activate(true);
-		}
+			if(PC->IsLocalController())
+			{
+				ReceiveSimulateFire();
+			}
+			else
+			{
+				PC->ClientSimulateGunFire(this, MuzzleLoc, GetOwner()->GetClass());
+			}
+		}
+		else if(bCanSendDistant && DistSq <= FMath::Square(DistantEventRange))
+		{
+			PC->ClientDistantGunfire(MuzzleLoc, GetOwner()->GetClass());
+			bSentDistant = true;
+		}
+	}
+
+	if(bSentDistant)
+	{
+		LastDistantEventTime = Now;
+	}
+}
+
+void UTVRGunFireComponent::ReceiveSimulateFire()
+{
+	if(!IsOwnerLocalPlayerController())
+	{
+		LocalSimulateFire();
+	}
+}
 
-		if(FireAudioComp != nullptr)
+void UTVRGunFireComponent::MulticastSimulateFire_Implementation()
+{
+	if(!IsOwnerLocalPlayerController()) // already done for owner
+	{
+		LocalSimulateFire();
+	}
+}
+
+void UTVRGunFireComponent::LocalSimulateFire()
+{
+	if(GetNetMode() != ENetMode::NM_DedicatedServer)
+	{
+		if(MuzzleFlashOverride)
 		{
-			FireAudioComp->Stop();
-			// FireAudioComp->SetBoolParameter(FName("IsEmpty"), false);
-			FireAudioComp->Play(0);
+			MuzzleFlashOverride->Activate(true);
+		}
+		else if(MuzzleFlashPSC != nullptr)
+		{
+			MuzzleFlashPSC->Activate(true);
 		}
 
+		PlayFireSound();
+
 		if(IsOwnerLocalPlayerController()) // ony for owner
 		{
 			ATVRPlayerController* OwnerPC = nullptr;
@@ -453,20 +939,38 @@ void UTVRGunFireComponent::LocalSimulateFire()
 			}
 			if(OwnerPC != nullptr)
 			{
+				EControllerHand TriggerHand = EControllerHand::AnyHand;
+				const UTVRTriggerComponent* TriggerComp = GetGunOwner() ? GetGunOwner()->GetTriggerComponent() : nullptr;
+				if(TriggerComp && TriggerComp->GetUsingController())
+				{
+					TriggerComp->GetUsingController()->GetHandType(TriggerHand);
+				}
+
 				if(const auto GunHapctics = OwnerPC->GetGunHapticsComponent())
 				{
+					// we are the owning client, so the kicks are played directly instead of going through the RPCs
 					if(bUseGunHapticsButtstock)
 					{
-						GunHapctics->ClientButtstockKick(255, GetRefireTime());
+						GunHapctics->PlayButtstockKick(255, GetRefireTime());
+					}
+					if(bUseGunHapticsPistolGrip && TriggerHand != EControllerHand::AnyHand)
+					{
+						GunHapctics->PlayPistolKick(255, GetRefireTime(),
+							TriggerHand == EControllerHand::Left ? ETVRLeftRight::Left : ETVRLeftRight::Right);
+					}
+				}
+
+				if(ControllerKickAmplitude > 0.f && TriggerHand != EControllerHand::AnyHand)
+				{
+					if(UTVRHapticsMixerComponent* Mixer = UTVRHapticsMixerComponent::FindOrCreate(OwnerPC))
+					{
+						Mixer->SubmitHaptics(TriggerHand, ControllerKickAmplitude, ControllerKickFrequency,
+							ControllerKickDuration, ControllerKickPriority, TVRGunFire::KickHapticsSource);
 					}
-					// todo
-					// if(bUseGunHapticsPistolGrip)
-					// {
-					// 	GunHapctics->ClientPistolKick(255, GetRefireTime(), left or right hand);
-					// }
 				}
 			}
 		}
+		OnSimulateFireNative.Broadcast();
 		if(OnSimulateFire.IsBound())
 		{
 			OnSimulateFire.Broadcast();
@@ -474,6 +978,58 @@ void UTVRGunFireComponent::LocalSimulateFire()
 	}
 }
 
+void UTVRGunFireComponent::PlayFireSound()
+{
+	if(GunAudio == nullptr)
+	{
+		return;
+	}
+
+	// the loop timer is still running if the last shot was fired at the rate of fire
+	const bool bContinuousFire = GetWorldTimerManager().IsTimerActive(FireLoopTimer);
+	if(AutoFireLoopSound && bContinuousFire)
+	{
+		FireVoice = FTVRGunVoiceHandle();
+		if(!GunAudio->IsLoopPlaying())
+		{
+			if(UAudioComponent* LoopVoice = GunAudio->PrepareLoop(AutoFireLoopSound, this))
+			{
+				LoopVoice->SetBoolParameter(FName("IsSuppressed"), bIsSuppressed);
+				LoopVoice->Play();
+			}
+		}
+	}
+	else
+	{
+		if(UAudioComponent* FireAudioComp = GunAudio->PrepareOneShot(FireSoundCue, this, &FireVoice))
+		{
+			FireAudioComp->SetBoolParameter(FName("IsSuppressed"), bIsSuppressed);
+			FireAudioComp->Play();
+		}
+	}
+
+	if(AutoFireLoopSound)
+	{
+		// remote clients only see the shots, so the loop is kept alive by the cadence of the shots
+		constexpr float LoopCadenceTolerance = 1.5f;
+		GetWorldTimerManager().SetTimer(FireLoopTimer, this, &UTVRGunFireComponent::StopFireLoop, GetRefireTime() * LoopCadenceTolerance, false);
+	}
+}
+
+void UTVRGunFireComponent::StopFireLoop()
+{
+	GetWorldTimerManager().ClearTimer(FireLoopTimer);
+	if(GunAudio && GunAudio->IsLoopPlaying())
+	{
+		GunAudio->StopLoop(0.05f);
+		if(UAudioComponent* TailVoice = GunAudio->PrepareOneShot(AutoFireTailSound, this))
+		{
+			TailVoice->SetBoolParameter(FName("IsSuppressed"), bIsSuppressed);
+			TailVoice->Play();
+		}
+	}
+}
+
 void UTVRGunFireComponent::SimulateEmpty()
 {
 	if(IsOwnerLocalPlayerController())
@@ -497,10 +1053,9 @@ void UTVRGunFireComponent::MulticastSimulateEmpty_Implementation()
 
 void UTVRGunFireComponent::LocalSimulateEmpty()
 {
-	if(EmptyAudioComp)
+	if(UAudioComponent* EmptyVoice = GunAudio ? GunAudio->PrepareOneShot(EmptySoundCue, this) : nullptr)
 	{
-		EmptyAudioComp->Stop();
-		EmptyAudioComp->Play();
+		EmptyVoice->Play();
 	}
 
 	if(OnSimulateEmpty.IsBound())
@@ -509,7 +1064,7 @@ void UTVRGunFireComponent::LocalSimulateEmpty()
 	}
 }
 
-void UTVRGunFireComponent::FireBuckshot(uint8 PendingBuckshot, const ATVRCartridge* AmmoCDO, FVector PendingBuckshotDir)
+void UTVRGunFireComponent::FireBuckshot(uint8 PendingBuckshot, const ATVRCartridge* AmmoCDO, FVector PendingBuckshotOrigin, FVector PendingBuckshotDir)
 {
 	// Caution: In theory it can happen that multiples of this function are called in one frame for this component
 	// This would happen during very high fire rates that need less that 3-4 frames. In that case there is no big benefit
@@ -522,10 +1077,14 @@ void UTVRGunFireComponent::FireBuckshot(uint8 PendingBuckshot, const ATVRCartrid
 	{
 		const FVector TraceDir = RandomFiringStream.VRandCone(PendingBuckshotDir, BuckshotSpread);
 		TArray<FHitResult> Hits;
-		if(TraceFire(Hits, TraceDir * AmmoCDO->GetTraceDistance()))
+		if(TraceShot(Hits, PendingBuckshotOrigin, TraceDir, AmmoCDO))
 		{
 			ProcessHits(Hits, AmmoCDO->GetClass());		
 		}
+		else
+		{
+			ProcessMiss(PendingBuckshotOrigin, TraceDir, AmmoCDO);
+		}
 	}
 	
 	const uint8 NewPendingBuckshot = (PendingBuckshot > ShotsToDo) ? (PendingBuckshot - ShotsToDo) : 0;
@@ -533,9 +1092,59 @@ void UTVRGunFireComponent::FireBuckshot(uint8 PendingBuckshot, const ATVRCartrid
 	{
 		FTimerDelegate BuckshotDelegate = FTimerDelegate::CreateUObject(
 			this, &UTVRGunFireComponent::FireBuckshot,
-			NewPendingBuckshot, AmmoCDO, PendingBuckshotDir);
+			NewPendingBuckshot, AmmoCDO, PendingBuckshotOrigin, PendingBuckshotDir);
 		GetWorldTimerManager().SetTimerForNextTick(BuckshotDelegate);
 	}
+	else if(GetOwner()->GetLocalRole() == ROLE_Authority)
+	{
+		if(UTVRDamageQueueSubsystem* DamageQueue = GetWorld()->GetSubsystem<UTVRDamageQueueSubsystem>())
+		{
+			DamageQueue->ReleaseDamage(GetOwner());
+		}
+	}
+	else if(NumCollectingShells > 0)
+	{
+		// overlapping shells are reported once the last of them is done
+		NumCollectingShells--;
+		if(NumCollectingShells == 0 && PendingPelletHits.Num() > 0)
+		{
+			ServerReceiveHits(PendingPelletHits, AmmoCDO->GetClass());
+			PendingPelletHits.Reset();
+		}
+	}
+}
+
+void UTVRGunFireComponent::LaunchProjectile(const ATVRCartridge* AmmoCDO, const FVector& Origin, const FVector& Direction)
+{
+	UTVRBallisticsSubsystem* Ballistics = GetWorld()->GetSubsystem<UTVRBallisticsSubsystem>();
+	const ATVRProjectile* ProjectileCDO = GetDefault<ATVRProjectile>(AmmoCDO->GetProjectileClass());
+	if(Ballistics == nullptr || ProjectileCDO == nullptr)
+	{
+		return;
+	}
+	
+	FTVRProjectileLaunchParams Params;
+	Params.Origin = Origin;
+	Params.Velocity = Direction * ProjectileCDO->GetMuzzleVelocity() * GetMuzzleVelocityModifier();
+	Params.DragCoefficient = ProjectileCDO->GetDragCoefficient();
+	Params.GravityScale = ProjectileCDO->GetGravityScale();
+	Params.LifeTime = ProjectileCDO->GetMaxLifeTime();
+	Params.FiringComponent = this;
+	Params.Cartridge = AmmoCDO->GetClass();
+	Params.Shooter = GetCharacterOwner();
+	
+	for(const uint32 IgnoredActorId : GetTraceQueryParams().GetIgnoredActors())
+	{
+		Params.IgnoredActors.Add(IgnoredActorId);
+	}
+	Ballistics->LaunchProjectile(Params);
+}
+
+void UTVRGunFireComponent::ReceiveProjectileHit(const FHitResult& Hit, TSubclassOf<ATVRCartridge> Cartridge)
+{
+	TArray<FHitResult> Hits;
+	Hits.Add(Hit);
+	ProcessHits(Hits, Cartridge);
 }
 
 void UTVRGunFireComponent::AddTraceIgnoreActors(FCollisionQueryParams& QueryParams)
@@ -556,79 +1165,363 @@ void UTVRGunFireComponent::AddTraceIgnoreActors(FCollisionQueryParams& QueryPara
 	}
 }
 
-bool UTVRGunFireComponent::TraceFire(TArray<FHitResult>& Hits, const FVector& TraceDir)
+void UTVRGunFireComponent::InvalidateTraceQueryCache()
+{
+	bTraceQueryCacheValid = false;
+}
+
+const FCollisionQueryParams& UTVRGunFireComponent::GetTraceQueryParams()
+{
+	const USceneComponent* OwnerRoot = GetOwner()->GetRootComponent();
+	AActor* AttachRoot = OwnerRoot ? OwnerRoot->GetAttachmentRootActor() : GetOwner();
+	if(!bTraceQueryCacheValid || CachedTraceAttachRoot.Get() != AttachRoot)
+	{
+		CachedTraceQueryParams = FCollisionQueryParams(FName("WeaponTrace"), true);
+		CachedTraceQueryParams.bReturnPhysicalMaterial = false;
+		CachedTraceQueryParams.bReturnFaceIndex = true;
+		AddTraceIgnoreActors(CachedTraceQueryParams);
+		CachedTraceAttachRoot = AttachRoot;
+		bTraceQueryCacheValid = true;
+	}
+	return CachedTraceQueryParams;
+}
+
+bool UTVRGunFireComponent::ShouldTraceMultiHit(const ATVRCartridge* AmmoCDO) const
+{
+	// cartridges do not penetrate yet, so the first blocking hit is all we need
+	return false;
+}
+
+bool UTVRGunFireComponent::TraceFire(TArray<FHitResult>& Hits, const FVector& TraceStart, const FVector& TraceDir, bool bMultiHit)
 {
-	const FVector TraceStart = GetComponentLocation();
 	const FVector TraceEnd = TraceStart + TraceDir;
-    FCollisionQueryParams QueryParams(FName("WeaponTrace"), true);
-	AddTraceIgnoreActors(QueryParams);
-	QueryParams.bReturnPhysicalMaterial = true;
+	const FCollisionQueryParams& QueryParams = GetTraceQueryParams();
+
+	// test the character hitboxes first, the physics scene only needs to be traced up to the hitbox
+	FHitResult HitboxHit;
+	UTVRHitboxSubsystem* Hitboxes = GetWorld()->GetSubsystem<UTVRHitboxSubsystem>();
+	const bool bHitHitbox = Hitboxes && Hitboxes->HasHitboxes() && Hitboxes->RaycastHitboxes(HitboxHit, TraceStart, TraceEnd, QueryParams, GetCharacterOwner());
+	const FVector PhysicsTraceEnd = bHitHitbox ? HitboxHit.ImpactPoint : TraceEnd;
 	
 	const FCollisionResponseParams ResponseParams(ECR_Block);
-	GetWorld()->LineTraceMultiByChannel(
-		Hits,
-		TraceStart, TraceEnd,
-		ECC_Visibility,
-		QueryParams,
-		ResponseParams
-	);
+	if(bMultiHit)
+	{
+		GetWorld()->LineTraceMultiByChannel(
+			Hits,
+			TraceStart, PhysicsTraceEnd,
+			ECC_WeaponTraceChannel,
+			QueryParams,
+			ResponseParams
+		);
+	}
+	else
+	{
+		FHitResult Hit;
+		if(GetWorld()->LineTraceSingleByChannel(Hit, TraceStart, PhysicsTraceEnd, ECC_WeaponTraceChannel, QueryParams, ResponseParams))
+		{
+			Hits.Add(Hit);
+		}
+	}
+
+	if(bHitHitbox && (Hits.Num() == 0 || !Hits.Last().bBlockingHit))
+	{
+		Hits.Add(HitboxHit);
+	}
 	return Hits.Num() > 0;
 }
 
-void UTVRGunFireComponent::ProcessHits(TArray<FHitResult>& Hits, TSubclassOf<ATVRCartridge> Cartridge)
+void UTVRGunFireComponent::ResolveHitPhysicalMaterial(FHitResult& Hit)
+{
+	UPrimitiveComponent* HitComp = Hit.GetComponent();
+	if(HitComp == nullptr || Hit.PhysMaterial.IsValid())
+	{
+		return;
+	}
+	
+	UPhysicalMaterial* PhysMat = nullptr;
+	if(Hit.FaceIndex != INDEX_NONE)
+	{
+		int32 SectionIndex;
+		if(UMaterialInterface* Material = HitComp->GetMaterialFromCollisionFaceIndex(Hit.FaceIndex, SectionIndex))
+		{
+			PhysMat = Material->GetPhysicalMaterial();
+		}
+	}
+	if(PhysMat == nullptr)
+	{
+		if(FBodyInstance* Body = HitComp->GetBodyInstance(Hit.BoneName))
+		{
+			PhysMat = Body->GetSimplePhysicalMaterial();
+		}
+	}
+	Hit.PhysMaterial = PhysMat;
+}
+
+bool UTVRGunFireComponent::TraceShot(TArray<FHitResult>& Hits, const FVector& TraceStart, const FVector& ShotDir,
+	const ATVRCartridge* AmmoCDO)
 {
+	const float TraceDistance = AmmoCDO->GetTraceDistance();
+	const bool bMultiHit = ShouldTraceMultiHit(AmmoCDO);
+	if(!AmmoCDO->UsesBallisticTrajectory())
+	{
+		TraceFire(Hits, TraceStart, ShotDir * TraceDistance, bMultiHit);
+	}
+	else
+	{
+		TraceTrajectory(Hits, TraceStart, ShotDir, AmmoCDO, bMultiHit);
+	}
+
+	// only the last hit is processed, so it is the only one that needs a physical material
 	if(Hits.Num() > 0)
-	{		
-		FHitResult& LastHit = Hits.Last();
-		SimulateHit(LastHit, Cartridge);
-		if(const auto HitActor = LastHit.GetActor())
+	{
+		ResolveHitPhysicalMaterial(Hits.Last());
+	}
+	return Hits.Num() > 0;
+}
+
+void UTVRGunFireComponent::TraceTrajectory(TArray<FHitResult>& Hits, const FVector& TraceStart, const FVector& ShotDir,
+	const ATVRCartridge* AmmoCDO, bool bMultiHit)
+{
+	// flat fire approximation: the drop from the table is applied along the world down axis
+	const FTVRTrajectoryTable& Trajectory = AmmoCDO->GetTrajectoryTable(GetWorld()->GetGravityZ());
+	const float TraceDistance = TVRGunFire::GetTrajectoryDistance(AmmoCDO, Trajectory);
+	const int32 NumSegments = FMath::Max(AmmoCDO->GetTrajectorySegments(), 1);
+	const float SegmentLength = TraceDistance / NumSegments;
+	FVector SegmentStart = TraceStart;
+	for(int32 i = 1; i <= NumSegments; i++)
+	{
+		const float Distance = SegmentLength * i;
+		const FVector SegmentEnd = TraceStart + ShotDir * Distance - FVector::UpVector * Trajectory.GetDrop(Distance);
+		TArray<FHitResult> SegmentHits;
+		if(TraceFire(SegmentHits, SegmentStart, SegmentEnd - SegmentStart, bMultiHit))
 		{
-			const auto CartridgeCDO = Cartridge->GetDefaultObject<ATVRCartridge>();
-			float Damage = CartridgeCDO->GetBaseDamage();
-			if(GetOwner())
+			Hits.Append(SegmentHits);
+			if(Hits.Last().bBlockingHit)
 			{
-				if(const auto GunOwner = Cast<ATVRGunBase>(GetOwner()))
-				{
-					for(const auto AttachPoint: GunOwner->GetAttachmentPoints())
-					{
-						if(const auto WPNA = AttachPoint->GetCurrentAttachment())
-						{
-							Damage *= WPNA->GetDamageModifier();
-						}
-					}
-				}
+				break;
 			}
-			const FVector TraceDir = (LastHit.ImpactPoint - LastHit.TraceStart).GetSafeNormal();
-			UGameplayStatics::ApplyPointDamage(HitActor, Damage, TraceDir, LastHit, nullptr, GetOwner(), CartridgeCDO->GetDamageType());
 		}
+		SegmentStart = SegmentEnd;
 	}
 }
 
+void UTVRGunFireComponent::ProcessHits(TArray<FHitResult>& Hits, TSubclassOf<ATVRCartridge> Cartridge)
+{
+	if(Hits.Num() > 0)
+	{		
+		// the damage is applied once on the authority, when it receives the hit
+		SimulateHit(Hits.Last(), Cartridge);
+	}
+}
+
+void UTVRGunFireComponent::ProcessMiss(const FVector& TraceStart, const FVector& ShotDir, const ATVRCartridge* AmmoCDO)
+{
+	FVector TraceEnd = TraceStart + ShotDir * AmmoCDO->GetTraceDistance();
+	if(AmmoCDO->UsesBallisticTrajectory())
+	{
+		const FTVRTrajectoryTable& Trajectory = AmmoCDO->GetTrajectoryTable(GetWorld()->GetGravityZ());
+		const float TraceDistance = TVRGunFire::GetTrajectoryDistance(AmmoCDO, Trajectory);
+		TraceEnd = TraceStart + ShotDir * TraceDistance - FVector::UpVector * Trajectory.GetDrop(TraceDistance);
+	}
+
+	// the miss takes the same way as a hit, so remote listeners along its path hear the fly-by
+	FHitResult Miss(TraceStart, TraceEnd);
+	Miss.Location = TraceEnd;
+	Miss.ImpactPoint = TraceEnd;
+	SimulateHit(Miss, AmmoCDO->GetClass());
+}
+
+void UTVRGunFireComponent::ApplyHitDamage(AActor* Victim, float Damage, const FVector& ShotDirection, const FHitResult& Hit,
+	AController* EventInstigator, AActor* DamageCauser, TSubclassOf<UDamageType> DamageTypeClass)
+{
+	if(UTVRDamageQueueSubsystem* DamageQueue = GetWorld()->GetSubsystem<UTVRDamageQueueSubsystem>())
+	{
+		DamageQueue->QueuePointDamage(Victim, Damage, ShotDirection, Hit, EventInstigator, DamageCauser, DamageTypeClass);
+	}
+	else
+	{
+		UGameplayStatics::ApplyPointDamage(Victim, Damage, ShotDirection, Hit, EventInstigator, DamageCauser, DamageTypeClass);
+	}
+}
 
 void UTVRGunFireComponent::SimulateHit(const FHitResult& Hit, TSubclassOf<ATVRCartridge> Cartridge)
 {
-    ServerReceiveHit(Hit, Cartridge);
+	if(GetOwner()->GetLocalRole() == ROLE_Authority)
+	{
+		if(IsShotReportedByClient())
+		{
+			// damage and effects of this shot follow the hit report of the shooting client
+			return;
+		}
+		AuthorityReceiveHit(Hit, Cartridge);
+	}
+	else if(NumCollectingShells > 0)
+	{
+		PendingPelletHits.Add(Hit);
+	}
+	else
+	{
+		ServerReceiveHit(Hit, Cartridge);
+	}
     LocalSimulateHit(Hit, Cartridge);
 }
 
 void UTVRGunFireComponent::ServerReceiveHit_Implementation(const FHitResult& Hit, TSubclassOf<ATVRCartridge> Cartridge)
 {
-    MulticastSimulateHit(Hit, Cartridge);
+	if(!AcceptClientHit(Hit, Cartridge))
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("%s: dropped client hit report"), *GetName());
+		return;
+	}
+	AuthorityReceiveHit(Hit, Cartridge);
+}
+
+void UTVRGunFireComponent::ServerReceiveHits_Implementation(const TArray<FHitResult>& Hits, TSubclassOf<ATVRCartridge> Cartridge)
+{
+	UTVRDamageQueueSubsystem* DamageQueue = GetWorld()->GetSubsystem<UTVRDamageQueueSubsystem>();
+	if(DamageQueue)
+	{
+		DamageQueue->HoldDamage(GetOwner());
+	}
+	for(const FHitResult& Hit: Hits)
+	{
+		if(AcceptClientHit(Hit, Cartridge))
+		{
+			AuthorityReceiveHit(Hit, Cartridge);
+		}
+	}
+	if(DamageQueue)
+	{
+		DamageQueue->ReleaseDamage(GetOwner());
+	}
+}
+
+bool UTVRGunFireComponent::ConsumeOwnerRpcToken() const
+{
+	const ACharacter* CharOwner = GetCharacterOwner();
+	if(ATVRPlayerController* PC = CharOwner ? Cast<ATVRPlayerController>(CharOwner->GetController()) : nullptr)
+	{
+		return PC->ConsumeWeaponRpcToken();
+	}
+	return true;
+}
+
+bool UTVRGunFireComponent::AcceptClientHit(const FHitResult& Hit, TSubclassOf<ATVRCartridge> Cartridge)
+{
+	if(!ConsumeOwnerRpcToken())
+	{
+		return false;
+	}
+	
+	const UTVRCoreWeaponSettings* Settings = UTVRCoreWeaponSettings::Get();
+	if(!Settings->bValidateClientHits)
+	{
+		return true;
+	}
+
+	const ATVRCartridge* CartridgeCDO = GetDefault<ATVRCartridge>(Cartridge);
+	const float Now = GetWorld()->GetTimeSeconds();
+	
+	// fire cadence: the client can not report more hits than the gun can produce with its rate of fire
+	const float HitsPerShot = CartridgeCDO->IsBuckshot() ? CartridgeCDO->GetNumBuckshot() : 1.f;
+	if(!HitReportBucket.TryConsume(Now, HitsPerShot / GetRefireTime(), HitsPerShot * Settings->HitReportBurstShots))
+	{
+		return false;
+	}
+
+	// projectile hits arrive after their time of flight, hit-scan hits right after the shot
+	float MaxRange = CartridgeCDO->GetTraceDistance();
+	float MaxDelay = Settings->HitReportDelayTolerance;
+	if(CartridgeCDO->IsProjectile())
+	{
+		const ATVRProjectile* ProjectileCDO = GetDefault<ATVRProjectile>(CartridgeCDO->GetProjectileClass());
+		MaxRange = ProjectileCDO->GetMuzzleVelocity() * GetMuzzleVelocityModifier() * ProjectileCDO->GetMaxLifeTime();
+		MaxDelay += ProjectileCDO->GetMaxLifeTime();
+	}
+	
+	// ammo: the server must have fired recently, or the client is ahead and the server still has a round to fire
+	const bool bFiredRecently = LastAuthorityFireTime >= 0.f && Now - LastAuthorityFireTime <= MaxDelay;
+	const bool bCanStillFire = HasRoundLoaded() && !bCartridgeIsSpent;
+	if(!bFiredRecently && !bCanStillFire)
+	{
+		return false;
+	}
+
+	// the impact has to be within the range of the cartridge from the server's muzzle
+	const float MaxDistance = MaxRange + Settings->HitReportDistanceTolerance;
+	return FVector::DistSquared(Hit.ImpactPoint, GetComponentLocation()) <= FMath::Square(MaxDistance);
+}
+
+void UTVRGunFireComponent::AuthorityReceiveHit(const FHitResult& Hit, TSubclassOf<ATVRCartridge> Cartridge)
+{
+	if(bUseNetInterestManagement)
+	{
+		SendSimulateHitToClients(Hit, Cartridge);
+	}
+	else
+	{
+		MulticastSimulateHit(Hit, Cartridge);
+	}
 
 	if(Hit.bBlockingHit)
 	{
-		ATVRCharacter* MyChar = Cast<ATVRCharacter>(GetOwner());		
-		UGameplayStatics::ApplyPointDamage(
+		float Damage = GetDamage(Cartridge);
+		if(const UTVRHitboxComponent* Hitbox = Hit.GetActor() ? Hit.GetActor()->FindComponentByClass<UTVRHitboxComponent>() : nullptr)
+		{
+			Damage *= Hitbox->GetDamageMultiplier(UTVRHitboxComponent::GetHitZone(Hit));
+		}
+		const ACharacter* MyChar = GetCharacterOwner();
+		ApplyHitDamage(
 			Hit.GetActor(),
-			GetDamage(Cartridge),
-			Hit.TraceEnd-Hit.TraceStart, Hit,
+			Damage,
+			(Hit.TraceEnd - Hit.TraceStart).GetSafeNormal(), Hit,
 			MyChar ? MyChar->GetController() : nullptr,
-			MyChar,
-			UDamageType::StaticClass()
+			GetOwner(),
+			Cartridge ? GetDefault<ATVRCartridge>(Cartridge)->GetDamageType() : UDamageType::StaticClass()
 		);
 	}
 }
 
+void UTVRGunFireComponent::SendSimulateHitToClients(const FHitResult& Hit, TSubclassOf<ATVRCartridge> Cartridge)
+{
+	const AController* OwnerController = GetCharacterOwner() ? GetCharacterOwner()->GetController() : nullptr;
+	// listeners close to the path of the bullet need the hit as well to hear the fly-by
+	const float FlyByRange = Cartridge ? GetDefault<ATVRCartridge>(Cartridge)->GetFlyByThresholdDistance() : 0.f;
+	for(FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		ATVRPlayerController* PC = Cast<ATVRPlayerController>(It->Get());
+		if(PC == nullptr || PC == OwnerController) // owner already simulated this due to forward prediction
+		{
+			continue;
+		}
+		
+		FVector ViewLoc;
+		FRotator ViewRot;
+		PC->GetPlayerViewPoint(ViewLoc, ViewRot);
+		const bool bNearImpact = !TVRGunFire::IsMissedShot(Hit) && FVector::DistSquared(ViewLoc, Hit.ImpactPoint) <= FMath::Square(FullEventRange);
+		const bool bNearPath = FlyByRange > 0.f && FMath::PointDistToSegmentSquared(ViewLoc, Hit.TraceStart, Hit.ImpactPoint) <= FMath::Square(FlyByRange);
+		if(bNearImpact || bNearPath)
+		{
+			if(PC->IsLocalController())
+			{
+				ReceiveSimulateHit(Hit, Cartridge);
+			}
+			else
+			{
+				PC->ClientSimulateGunHit(this, Hit, Cartridge);
+			}
+		}
+	}
+}
+
+void UTVRGunFireComponent::ReceiveSimulateHit(const FHitResult& Hit, TSubclassOf<ATVRCartridge> Cartridge)
+{
+	if(!IsOwnerLocalPlayerController())
+	{
+		LocalSimulateHit(Hit, Cartridge);
+	}
+}
+
 void UTVRGunFireComponent::MulticastSimulateHit_Implementation(const FHitResult& Hit, TSubclassOf<ATVRCartridge> Cartridge)
 {
     if(!IsOwnerLocalPlayerController())
@@ -639,133 +1532,69 @@ void UTVRGunFireComponent::MulticastSimulateHit_Implementation(const FHitResult&
 
 void UTVRGunFireComponent::LocalSimulateHit(const FHitResult& Hit, TSubclassOf<ATVRCartridge> Cartridge)
 {
-	const auto CartridgeCDO = Cartridge->GetDefaultObject<ATVRCartridge>();
-	const auto SurfaceType = Hit.PhysMaterial.IsValid() ? Hit.PhysMaterial->SurfaceType : SurfaceType_Default;
-	const auto ImpactPS = CartridgeCDO->GetImpactParticle(SurfaceType);
-	if(ImpactPS && ImpactPS->ParticleSystem)
-	{
-		const FVector TraceDir = (Hit.TraceEnd - Hit.TraceStart).GetSafeNormal();
-		const FVector ImpactUpVector = Hit.Normal + TraceDir - 2 * (TraceDir | Hit.Normal) * Hit.Normal;
-		FRotator ImpactRot;
-		switch(ImpactPS->UpAxis)
-		{
-		case EAxisOption::X:
-			ImpactRot = UKismetMathLibrary::MakeRotFromX(ImpactUpVector);
-			break;
-		case EAxisOption::Y:
-			ImpactRot = UKismetMathLibrary::MakeRotFromY(ImpactUpVector);
-			break;
-		case EAxisOption::X_Neg:
-			ImpactRot = UKismetMathLibrary::MakeRotFromX(-ImpactUpVector);
-			break;
-		case EAxisOption::Y_Neg:
-			ImpactRot = UKismetMathLibrary::MakeRotFromY(-ImpactUpVector);
-			break;
-		case EAxisOption::Z_Neg:
-			ImpactRot = UKismetMathLibrary::MakeRotFromZ(-ImpactUpVector);
-			break;
-		case EAxisOption::Z:
-		default:
-			ImpactRot = UKismetMathLibrary::MakeRotFromZ(ImpactUpVector);
-			break;
-		}
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), ImpactPS->ParticleSystem,
-			Hit.ImpactPoint, ImpactRot, FVector(ImpactPS->ScaleFactor),
-			true, EPSCPoolMethod::AutoRelease, true);
-	}
-
-	const auto ImpactDecal = CartridgeCDO->GetImpactDecal(SurfaceType);
-	if(ImpactDecal && ImpactDecal->DecalMaterial && Hit.GetComponent() && Hit.GetComponent()->GetCollisionObjectType() == ECC_WorldStatic)
-	{
-		FRotator DecalRot = UKismetMathLibrary::MakeRotFromX(-Hit.ImpactNormal);
-		DecalRot.Roll = FMath::RandRange(-180.f, 180.f);
-		const auto NewDecal = UGameplayStatics::SpawnDecalAttached(
-			ImpactDecal->DecalMaterial,
-			ImpactDecal->ScaleFactor * FVector(0.5f, 1.f, 1.f),
-			Hit.GetComponent(), Hit.BoneName,
-			Hit.ImpactPoint, DecalRot,
-			EAttachLocation::KeepWorldPosition
-		);
-		NewDecal->SetFadeScreenSize(0.0025f); // todo: make a setting or something
-	}
-	
-	USoundBase* ImpactSound = CartridgeCDO->GetImpactSound();
-	if(ImpactSound)
+	// every machine simulates the hits, so this is where all local listeners can hear the shot
+	LocalSimulateFlyBy(Hit.TraceStart, Hit.ImpactPoint, Cartridge);
+	if(TVRGunFire::IsMissedShot(Hit))
 	{
-		SpawnImpactSound(Hit, ImpactSound);
+		return;
 	}
+	SimulateImpact(GetWorld(), Hit, Cartridge);
 		
+	OnSimulateHitNative.Broadcast(Hit, Cartridge);
 	if(OnSimulateHit.IsBound())
 	{
 		OnSimulateHit.Broadcast(Hit, Cartridge);
 	}
 }
 
-void UTVRGunFireComponent::SimulateFlyBy(const FVector_NetQuantize& Origin, const FVector_NetQuantize& Target,
+void UTVRGunFireComponent::LocalSimulateFlyBy(const FVector_NetQuantize& Origin, const FVector_NetQuantize& Target,
 	TSubclassOf<ATVRCartridge> Cartridge)
 {
-	LocalSimulateFlyBy(Origin, Target, Cartridge);
+	if(UTVRFlyBySubsystem* FlyBy = GetWorld()->GetSubsystem<UTVRFlyBySubsystem>())
+	{
+		FlyBy->AddShotSegment(Origin, Target, Cartridge, GetCharacterOwner());
+	}
 }
 
-void UTVRGunFireComponent::LocalSimulateFlyBy(const FVector_NetQuantize& Origin, const FVector_NetQuantize& Target,
-	TSubclassOf<ATVRCartridge> Cartridge)
+void UTVRGunFireComponent::SimulateImpact(UWorld* World, const FHitResult& Hit, TSubclassOf<ATVRCartridge> Cartridge)
 {
-	const auto CartridgeCDO = GetDefault<ATVRCartridge>(Cartridge);
-	if(GetOwner() && CartridgeCDO->GetFlyBySound())
+	if(World == nullptr || Cartridge == nullptr || TVRGunFire::IsMissedShot(Hit))
+	{
+		return;
+	}
+	
+	const auto CartridgeCDO = Cartridge->GetDefaultObject<ATVRCartridge>();
+	if(UTVRImpactFXSubsystem* ImpactFX = World->GetSubsystem<UTVRImpactFXSubsystem>())
+	{
+		ImpactFX->AddImpact(Hit, CartridgeCDO);
+	}
+	
+	USoundBase* ImpactSound = CartridgeCDO->GetImpactSound();
+	if(ImpactSound == nullptr && CartridgeCDO->HasImpactSound())
 	{
-		if(const auto P = GetOwner()->GetGameInstance()->GetPrimaryPlayerController()->GetPawn())
+		// the effects of the cartridge are still loading
+		if(UTVRFXPreloadSubsystem* FXPreload = World->GetSubsystem<UTVRFXPreloadSubsystem>())
 		{
-			if(P == GetCharacterOwner())
-			{
-				return;
-			}
-			if(const auto LocalCharacter = Cast<ATVRCharacter>(P))
-			{
-				const FVector HeadLoc = LocalCharacter->GetVRHeadLocation();
-				const FVector NearestLoc = FMath::ClosestPointOnSegment(HeadLoc, Origin, Target);
-				const float MaxDist = CartridgeCDO->GetFlyByThresholdDistance();
-				if(FVector::DistSquared(HeadLoc, NearestLoc) <= MaxDist*MaxDist)
-				{
-					UGameplayStatics::PlaySoundAtLocation(LocalCharacter, CartridgeCDO->GetFlyBySound(), NearestLoc);
-				}
-			}
+			FXPreload->RequestCartridgeFX(Cartridge);
 		}
+		ImpactSound = UTVRCoreWeaponSettings::Get()->FallbackImpactSound.Get();
+	}
+	if(ImpactSound)
+	{
+		SpawnImpactSound(World, Hit, ImpactSound);
 	}
 }
 
-void UTVRGunFireComponent::SpawnImpactSound(const FHitResult& Hit, USoundBase* Sound)
+void UTVRGunFireComponent::SpawnImpactSound(UWorld* World, const FHitResult& Hit, USoundBase* Sound)
 {
-	// if there already is an Audio Component for the impact, we just re-use it instead of respawning it
-	// best case all cartridges use the same impact sound cue, but in case it is not, the sound will be changed
-	// what is certain is that consecutive shots out of this component will have almost the same sound, at a similar location
-	// the only weakness is buckshot or penetrating shots, where a lot of sound would theoretically trigger at a lot of locations
-	// even then the impact points should be close enough
-	//
-	// A possible improvement might be to have a pooled method, but on the other hand the amount of sounds that can be played at once
-	// is also limited, so a more complex system might have diminishing returns
-
 	// we need to move back the sound a bit so that there is no occlusion though collision.
 	// we use the normal
 	constexpr float MoveBackDist = 1.f;
 	const FVector SpawnLoc = Hit.ImpactPoint + Hit.ImpactNormal * MoveBackDist;
-	const auto SurfaceType = Hit.PhysMaterial.IsValid() ? Hit.PhysMaterial->SurfaceType : SurfaceType_Default;
-	if(ImpactSoundComp == nullptr)
-	{
-		ImpactSoundComp = UGameplayStatics::SpawnSoundAtLocation(GetWorld(), Sound,
-			SpawnLoc, FRotator::ZeroRotator, 1.f, 1.f, 0.f,
-			nullptr, nullptr, false);
-	}
-	else if(ImpactSoundComp->Sound != Sound)
-	{
-		ImpactSoundComp->SetSound(Sound);
-	}
-	
-	if(ImpactSoundComp)
+	const auto SurfaceType = Hit.PhysMaterial.IsValid() ? Hit.PhysMaterial->SurfaceType.GetValue() : SurfaceType_Default;
+	if(UTVRImpactAudioSubsystem* ImpactAudio = World->GetSubsystem<UTVRImpactAudioSubsystem>())
 	{
-		ImpactSoundComp->Stop();
-		ImpactSoundComp->SetWorldLocation(SpawnLoc, false);
-		ImpactSoundComp->SetIntParameter(FName(TEXT("SurfaceType")), SurfaceType);
-		ImpactSoundComp->Play();
+		ImpactAudio->PlayImpactSound(Sound, SpawnLoc, SurfaceType);
 	}
 }
 
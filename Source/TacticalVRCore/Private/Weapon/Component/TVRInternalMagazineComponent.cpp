@@ -5,6 +5,7 @@
 #include "Components/AudioComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Weapon/TVRCartridge.h"
+#include "Weapon/Component/TVRGunAudioComponent.h"
 #include "TacticalTraceChannels.h"
 
 UTVRInternalMagazineComponent::UTVRInternalMagazineComponent(const FObjectInitializer& OI) : Super(OI)
@@ -70,13 +71,13 @@ void UTVRInternalMagazineComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
-	if(AmmoInsertSound && !MagAudioComp)
-	{
-		MagAudioComp = NewObject<UAudioComponent>(GetOwner());
-		MagAudioComp->bAutoActivate = false;
-		MagAudioComp->SetSound(AmmoInsertSound);
-		MagAudioComp->AttachToComponent(this, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
-	}
+	GunAudio = UTVRGunAudioComponent::FindOrCreate(GetOwner());
+}
+
+void UTVRInternalMagazineComponent::ResetForPool_Implementation()
+{
+	// internal magazines start out empty
+	InsertedAmmo.Empty();
 }
 
 bool UTVRInternalMagazineComponent::IsEmpty() const
@@ -100,6 +101,38 @@ TSubclassOf<ATVRCartridge> UTVRInternalMagazineComponent::TryFeedAmmo()
 	return nullptr;
 }
 
+void UTVRInternalMagazineComponent::SetAmmoCount(int32 NewAmmo)
+{
+	NewAmmo = FMath::Clamp<int32>(NewAmmo, 0, Capacity);
+	if(NewAmmo < InsertedAmmo.Num())
+	{
+		InsertedAmmo.SetNum(NewAmmo);
+	}
+	else if(NewAmmo > InsertedAmmo.Num())
+	{
+		// we do not know which rounds are missing, so use the ones we know about
+		const TSubclassOf<ATVRCartridge> FillCartridge = InsertedAmmo.Num() > 0 ? InsertedAmmo.Last()
+			: (CompatibleAmmo.Num() > 0 ? CompatibleAmmo[0] : nullptr);
+		if(FillCartridge)
+		{
+			while(InsertedAmmo.Num() < NewAmmo)
+			{
+				InsertedAmmo.Add(FillCartridge);
+			}
+		}
+	}
+	NotifyAmmoCountChanged();
+}
+
+void UTVRInternalMagazineComponent::ReconcileAmmoCount(int32 NewAmmo)
+{
+	// the type of missing rounds is unknown, so rounds are only removed
+	if(NewAmmo < InsertedAmmo.Num())
+	{
+		SetAmmoCount(NewAmmo);
+	}
+}
+
 bool UTVRInternalMagazineComponent::CanBoltLock() const
 {
 	return IsEmpty();
@@ -127,11 +160,11 @@ void UTVRInternalMagazineComponent::FullyInsertCartridge()
 	{
 		InsertedAmmo.Add(CurrentInsertingCartridge->GetClass());
 		CurrentInsertingCartridge->Destroy();
+		NotifyAmmoCountChanged();
 		
-		if(MagAudioComp)
+		if(UAudioComponent* MagVoice = GunAudio ? GunAudio->PrepareOneShot(AmmoInsertSound, this) : nullptr)
 		{
-			MagAudioComp->Stop();
-			MagAudioComp->Play();
+			MagVoice->Play();
 		}
 	}
 }
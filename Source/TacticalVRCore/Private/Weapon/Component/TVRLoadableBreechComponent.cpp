@@ -7,6 +7,7 @@
 #include "TacticalCollisionProfiles.h"
 #include "Components/AudioComponent.h"
 #include "Weapon/TVRCartridge.h"
+#include "Weapon/Component/TVRGunAudioComponent.h"
 #include "Weapon/Component/TVRGunFireComponent.h"
 
 #define MAG_AUDIO_StartInsert 0
@@ -27,6 +28,7 @@ ULoadableBreechComponent::ULoadableBreechComponent(const FObjectInitializer& OI)
 	BreechOpenTime = 0.5f;
 	bReleaseCartridgeWhenOpened = false;
 	EjectorForce = 0.f;
+	GunAudio = nullptr;
 }
 
 void ULoadableBreechComponent::BeginPlay()
@@ -44,21 +46,27 @@ void ULoadableBreechComponent::BeginPlay()
 		}
 	}
 
-	if(CartridgeInsertSound)
+	if(CartridgeInsertSound || OpenCloseSound)
 	{
-		CartridgeInsertAudioComp = NewObject<UAudioComponent>(this);
-		CartridgeInsertAudioComp->AttachToComponent(this, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
-		CartridgeInsertAudioComp->SetSound(CartridgeInsertSound);
-		CartridgeInsertAudioComp->SetAutoActivate(false);
+		GunAudio = UTVRGunAudioComponent::FindOrCreate(GetOwner());
 	}
-	
-	if(OpenCloseSound)
+}
+
+void ULoadableBreechComponent::ResetForPool_Implementation()
+{
+	GetWorld()->GetTimerManager().ClearTimer(BreechOpenTimer);
+	if(ATVRCartridge* Cartridge = GetCurrentCartridge())
 	{
-		OpenCloseAudioComp = NewObject<UAudioComponent>(this);
-		OpenCloseAudioComp->AttachToComponent(this, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
-		OpenCloseAudioComp->SetSound(OpenCloseSound);
-		OpenCloseAudioComp->SetAutoActivate(false);
+		SetCurrentCartridge(nullptr);
+		Cartridge->Destroy();
 	}
+	Progress = 0.f;
+	CartridgeSpeed = 0.f;
+	bCanRemoveCartridge = false;
+	bCanFullyInsertCartridge = false;
+	bCartridgeIsLocked = false;
+	BreechState = ETVRLoadableBreechState::Closed;
+	SetComponentTickEnabled(false);
 }
 
 void ULoadableBreechComponent::BeginDestroy()
@@ -71,11 +79,7 @@ void ULoadableBreechComponent::BeginDestroy()
 	}
 	if(GetFiringComp() && !GetFiringComp()->IsPendingKill())
 	{
-		GetFiringComp()->OnCartridgeSpent.RemoveDynamic(this, &ULoadableBreechComponent::OnCartridgeSpent);
-	}
-	if(GetCartridgeInsertAudioComp() && !GetCartridgeInsertAudioComp()->IsPendingKill())
-	{
-		GetCartridgeInsertAudioComp()->DestroyComponent();
+		GetFiringComp()->OnCartridgeSpentNative.RemoveAll(this);
 	}
 	Super::BeginDestroy();
 }
@@ -225,11 +229,10 @@ bool ULoadableBreechComponent::OpenBreech()
 			GetFiringComp()->TryEjectCartridge();
 		}
 		
-		if(GetOpenCloseAudioComp())
+		if(UAudioComponent* BreechVoice = GunAudio ? GunAudio->PrepareOneShot(OpenCloseSound, this) : nullptr)
 		{
-			GetOpenCloseAudioComp()->Stop();
-			GetOpenCloseAudioComp()->SetBoolParameter(FName("Open"), true);
-			GetOpenCloseAudioComp()->Play();
+			BreechVoice->SetBoolParameter(FName("Open"), true);
+			BreechVoice->Play();
 		}
 
 		
@@ -278,11 +281,10 @@ bool ULoadableBreechComponent::CloseBreech()
 		GetWorld()->GetTimerManager().SetTimer(BreechOpenTimer,
 			this, &ULoadableBreechComponent::OnBreechClosed, GetOpenDuration(), false);
 		EventOnBeginCloseBreech.Broadcast();
-		if(GetOpenCloseAudioComp())
+		if(UAudioComponent* BreechVoice = GunAudio ? GunAudio->PrepareOneShot(OpenCloseSound, this) : nullptr)
 		{
-			GetOpenCloseAudioComp()->Stop();
-			GetOpenCloseAudioComp()->SetBoolParameter(FName("Open"), false);
-			GetOpenCloseAudioComp()->Play();
+			BreechVoice->SetBoolParameter(FName("Open"), false);
+			BreechVoice->Play();
 		}
 		
 		return true;
@@ -294,12 +296,12 @@ void ULoadableBreechComponent::AssignFiringComp(UTVRGunFireComponent* NewFiringC
 {
 	if(GetFiringComp()) // remove any old delegates
 	{
-		GetFiringComp()->OnCartridgeSpent.RemoveDynamic(this, &ULoadableBreechComponent::OnCartridgeSpent);
+		GetFiringComp()->OnCartridgeSpentNative.RemoveAll(this);
 	}
 	FiringComp = NewFiringComp;
 	if(GetFiringComp()) // only do this if we actually assigned a valid object
 	{
-		GetFiringComp()->OnCartridgeSpent.AddDynamic(this, &ULoadableBreechComponent::OnCartridgeSpent);
+		GetFiringComp()->OnCartridgeSpentNative.AddUObject(this, &ULoadableBreechComponent::OnCartridgeSpent);
 	}
 }
 
@@ -318,11 +320,10 @@ void ULoadableBreechComponent::BeginInsertCartridge(ATVRCartridge* CartridgeToIn
 	if(CartridgeToInsert->VRGripInterfaceSettings.bIsHeld)
 	{		
 		AttachCartridge(CartridgeToInsert);
-		if(GetCartridgeInsertAudioComp())
+		if(UAudioComponent* CartridgeVoice = GunAudio ? GunAudio->PrepareOneShot(CartridgeInsertSound, this) : nullptr)
 		{
-			GetCartridgeInsertAudioComp()->Stop();
-			GetCartridgeInsertAudioComp()->SetIntParameter(FName("MagEvent"), MAG_AUDIO_StartInsert);
-			GetCartridgeInsertAudioComp()->Play();
+			CartridgeVoice->SetIntParameter(FName("MagEvent"), MAG_AUDIO_StartInsert);
+			CartridgeVoice->Play();
 		}
 	}
 }
@@ -339,11 +340,10 @@ void ULoadableBreechComponent::OnCartridgeSpent()
 void ULoadableBreechComponent::OnCartridgeGrabbed(UGripMotionControllerComponent* GrippingController, const FBPActorGripInformation& GripInformation)
 {
 	SetComponentTickEnabled(true);
-	if(GetCartridgeInsertAudioComp())
+	if(UAudioComponent* CartridgeVoice = GunAudio ? GunAudio->PrepareOneShot(CartridgeInsertSound, this) : nullptr)
 	{
-		GetCartridgeInsertAudioComp()->Stop();
-		GetCartridgeInsertAudioComp()->SetIntParameter(FName("MagEvent"), MAG_AUDIO_StartDrop);
-		GetCartridgeInsertAudioComp()->Play();
+		CartridgeVoice->SetIntParameter(FName("MagEvent"), MAG_AUDIO_StartDrop);
+		CartridgeVoice->Play();
 	}
 }
 
@@ -451,11 +451,10 @@ void ULoadableBreechComponent::FullyInsertCartridge()
 	
 	SetComponentTickEnabled(false);
 	
-	if(GetCartridgeInsertAudioComp())
+	if(UAudioComponent* CartridgeVoice = GunAudio ? GunAudio->PrepareOneShot(CartridgeInsertSound, this) : nullptr)
 	{
-		GetCartridgeInsertAudioComp()->Stop();
-		GetCartridgeInsertAudioComp()->SetIntParameter(FName("MagEvent"), MAG_AUDIO_FullyInserted);
-		GetCartridgeInsertAudioComp()->Play();
+		CartridgeVoice->SetIntParameter(FName("MagEvent"), MAG_AUDIO_FullyInserted);
+		CartridgeVoice->Play();
 	}
 }
 
@@ -464,10 +463,9 @@ void ULoadableBreechComponent::FullyRemoveCartridge()
 	Progress = 0.f;
 	DetachCartridge();
 	SetComponentTickEnabled(false);
-	if(GetCartridgeInsertAudioComp())
+	if(UAudioComponent* CartridgeVoice = GunAudio ? GunAudio->PrepareOneShot(CartridgeInsertSound, this) : nullptr)
 	{
-		GetCartridgeInsertAudioComp()->Stop();
-		GetCartridgeInsertAudioComp()->SetIntParameter(FName("MagEvent"), MAG_AUDIO_FullyDropped);
-		GetCartridgeInsertAudioComp()->Play();
+		CartridgeVoice->SetIntParameter(FName("MagEvent"), MAG_AUDIO_FullyDropped);
+		CartridgeVoice->Play();
 	}
 }
@@ -9,6 +9,8 @@
 #include "Libraries/TVRFunctionLibrary.h"
 #include "Player/TVRCharacter.h"
 #include "Sound/SoundCue.h"
+#include "Subsystems/TVRMagazineSubsystem.h"
+#include "Weapon/Component/TVRGunAudioComponent.h"
 
 #define MAG_AUDIO_StartInsert 0
 #define MAG_AUDIO_FullyInserted 1
@@ -19,7 +21,7 @@ UTVRMagWellComponent::UTVRMagWellComponent(const FObjectInitializer& OI) : Super
 {
 	PrimaryComponentTick.bCanEverTick = true;
 	PrimaryComponentTick.bStartWithTickEnabled = true;
-	MagAudioComp = nullptr;
+	GunAudio = nullptr;
 	MagazineSound = nullptr;
 	bIsMagFree = false;
     CurrentMagazine = nullptr;
@@ -44,23 +46,42 @@ void UTVRMagWellComponent::BeginPlay()
 		CachedMagSpline = FindMagSpline();
 	}
 
-	if(MagazineSound && !MagAudioComp)
+	GunAudio = UTVRGunAudioComponent::FindOrCreate(GetOwner());
+
+	const ATVRGunBase* Gun = GetGunOwner();
+	if(Gun == nullptr || !Gun->IsWarmupPending())
 	{
-		MagAudioComp = NewObject<UAudioComponent>(GetOwner());
-		MagAudioComp->bAutoActivate = false;
-		MagAudioComp->SetSound(MagazineSound);
-		MagAudioComp->AttachToComponent(this, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+		// otherwise the magazine is spawned during the warm-up of the gun
+		SpawnMagazineAttached();
+	}
+}
+
+void UTVRMagWellComponent::ResetForPool_Implementation()
+{
+	ATVRMagazine* Mag = GetCurrentMagazine();
+	const TSubclassOf<ATVRMagazine> DefaultMagClass = AllowedMagazines.Num() > 0 ? AllowedMagazines[0] : nullptr;
+	if(Mag && Mag->GetClass() == DefaultMagClass && Mag->IsInserted())
+	{
+		// the starting magazine is still in the gun, refilling it is enough
+		Mag->SetAmmo(Mag->GetAmmoCapacity());
+		return;
 	}
 
+	if(!GetOwner()->HasAuthority())
+	{
+		// the replacement magazine is replicated
+		return;
+	}
+	if(Mag)
+	{
+		CurrentMagazine = nullptr;
+		GetWorld()->GetSubsystem<UTVRMagazineSubsystem>()->ReleaseMagazine(Mag);
+	}
 	SpawnMagazineAttached();
 }
 
 void UTVRMagWellComponent::BeginDestroy()
 {
-	if(MagAudioComp && !MagAudioComp->IsPendingKill())
-	{
-		MagAudioComp->DestroyComponent();
-	}
 	Super::BeginDestroy();
 }
 
@@ -279,12 +300,14 @@ void UTVRMagWellComponent::OnMagFullyEjected()
         bIsMagFree= false;
         CurrentMagazine = nullptr;
     }
+	NotifyAmmoCountChanged();
 }
 
 void UTVRMagWellComponent::OnMagDestroyed()
 {
 	bIsMagFree= false;
 	CurrentMagazine = nullptr;
+	NotifyAmmoCountChanged();
 }
 
 bool UTVRMagWellComponent::ShouldEjectMag() const
@@ -310,12 +333,12 @@ void UTVRMagWellComponent::OnMagFullyInserted()
         CurrentMagazine->SetMagazineOriginToTransform(TransformSplineToMagazineCoordinates(SplineTransform));
         CurrentMagazine->MagInsertPercentage = 1.f;
         bIsMagFree = false;
+    	NotifyAmmoCountChanged();
 
-    	if(MagAudioComp)
+    	if(UAudioComponent* MagVoice = GunAudio ? GunAudio->PrepareOneShot(MagazineSound, this) : nullptr)
     	{
-    		MagAudioComp->Stop();
-    		MagAudioComp->SetIntParameter(FName("MagEvent"), MAG_AUDIO_FullyInserted);
-    		MagAudioComp->Play();
+    		MagVoice->SetIntParameter(FName("MagEvent"), MAG_AUDIO_FullyInserted);
+    		MagVoice->Play();
     	}
     	
     	if(EventOnMagazineFullyInserted.IsBound())
@@ -387,12 +410,12 @@ bool UTVRMagWellComponent::TryReleaseMag()
     {
         MagVelocity = FVector::ZeroVector;
         bIsMagFree = true;
+    	NotifyAmmoCountChanged();
 
-    	if(MagAudioComp)
+    	if(UAudioComponent* MagVoice = GunAudio ? GunAudio->PrepareOneShot(MagazineSound, this) : nullptr)
     	{
-    		MagAudioComp->Stop();
-    		MagAudioComp->SetIntParameter(FName("MagEvent"), MAG_AUDIO_StartDrop);
-    		MagAudioComp->Play();
+    		MagVoice->SetIntParameter(FName("MagEvent"), MAG_AUDIO_StartDrop);
+    		MagVoice->Play();
     	}
     	
     	if(EventOnMagazineStartDrop.IsBound())
@@ -422,6 +445,24 @@ TSubclassOf<ATVRCartridge> UTVRMagWellComponent::TryFeedAmmo()
 	return nullptr;
 }
 
+int32 UTVRMagWellComponent::GetAmmoCount() const
+{
+	if(HasFullyInsertedMagazine())
+	{
+		return GetCurrentMagazine()->GetAmmo();
+	}
+	return 0;
+}
+
+void UTVRMagWellComponent::SetAmmoCount(int32 NewAmmo)
+{
+	if(HasFullyInsertedMagazine())
+	{
+		GetCurrentMagazine()->SetAmmo(NewAmmo);
+		NotifyAmmoCountChanged();
+	}
+}
+
 bool UTVRMagWellComponent::IsAllowedMagType(UClass* TestClass) const
 {
     return AllowedMagazines.Find(TestClass) != INDEX_NONE;
@@ -562,12 +603,9 @@ ATVRMagazine* UTVRMagWellComponent::SpawnMagazineAttached(TSubclassOf<ATVRMagazi
 			}
 			if(IsAllowedMagType(MagazineClass) && GetWorld())
 			{
-				FActorSpawnParameters SpawnParams;
-				SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-				SpawnParams.bAllowDuringConstructionScript = false;
 				// in theory we could allow spawn during construction script, but it would require addtional code like child actor components
-				
-				auto NewMag = World->SpawnActor<ATVRMagazine>(MagazineClass, SpawnParams);
+				// evicted magazines are reused before new ones are spawned
+				auto NewMag = World->GetSubsystem<UTVRMagazineSubsystem>()->AcquireMagazine(MagazineClass, Gun->GetActorTransform());
 				if(NewMag)
 				{
 					FTransform SplineTransform;
@@ -610,11 +648,10 @@ void UTVRMagWellComponent::StartInsertMagazine(ATVRMagazine* MagToInsert)
 		CurrentMagazine = MagToInsert;
 		//Gun->OnMagazineInserted(Mag);
 
-		if(MagAudioComp)
+		if(UAudioComponent* MagVoice = GunAudio ? GunAudio->PrepareOneShot(MagazineSound, this) : nullptr)
 		{
-			MagAudioComp->Stop();
-			MagAudioComp->SetIntParameter(FName("MagEvent"), MAG_AUDIO_StartInsert);
-			MagAudioComp->Play();
+			MagVoice->SetIntParameter(FName("MagEvent"), MAG_AUDIO_StartInsert);
+			MagVoice->Play();
 		}
 		if(EventOnMagazineStartInsert.IsBound())
 		{
@@ -5,6 +5,7 @@
 #include "TacticalCollisionProfiles.h"
 #include "Weapon/TVRGunBase.h"
 #include "Weapon/Attachments/TVRWeaponAttachment.h"
+#include "Weapon/Component/TVRGunFireComponent.h"
 
 UTVRMagazineCompInterface::UTVRMagazineCompInterface(const FObjectInitializer& OI)
 {
@@ -47,6 +48,14 @@ void UTVRMagazineCompInterface::OnOwnerGripReleased(ATVRCharacter* OwningChar, c
 {
 }
 
+void UTVRMagazineCompInterface::NotifyAmmoCountChanged() const
+{
+	if(UTVRGunFireComponent* FiringComponent = GetOwner() ? GetOwner()->FindComponentByClass<UTVRGunFireComponent>() : nullptr)
+	{
+		FiringComponent->UpdateAuthAmmoCount();
+	}
+}
+
 void UTVRMagazineCompInterface::GetAllowedCatridges(TArray<TSubclassOf<class ATVRCartridge>>& OutCartridges) const
 {
 }
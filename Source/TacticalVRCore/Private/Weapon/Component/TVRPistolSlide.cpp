@@ -4,6 +4,7 @@
 #include "TacticalCollisionProfiles.h"
 #include "Components/AudioComponent.h"
 #include "Weapon/TVRGunBase.h"
+#include "Weapon/Component/TVRGunAudioComponent.h"
 #include "Weapon/Component/TVRGunFireComponent.h"
 
 UTVRPistolSlide::UTVRPistolSlide(const FObjectInitializer& OI) : Super(OI)
@@ -32,25 +33,23 @@ UTVRPistolSlide::UTVRPistolSlide(const FObjectInitializer& OI) : Super(OI)
 	bIsLocked = false;
 	bShouldPlayBackSound = false;
 	bShouldPlayCloseSound = false;
+	GunAudio = nullptr;
 }
 
 void UTVRPistolSlide::BeginPlay()
 {
 	Super::BeginPlay();
 
-	if(SlideSoundCue && !AudioComponent)
+	if(SlideSoundCue)
 	{
-		AudioComponent = NewObject<UAudioComponent>(GetOwner());
-		AudioComponent->bAutoActivate = false;
-		AudioComponent->AttachToComponent(this, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
-		AudioComponent->SetSound(SlideSoundCue);
+		GunAudio = UTVRGunAudioComponent::FindOrCreate(GetOwner());
 	}
 	
 	InitialRelativeTransform = GetRelativeTransform();
 	const auto Gun = GetOwner() ? Cast<ATVRGunBase>(GetOwner()) : nullptr;
 	if(Gun && Gun->GetFiringComponent())
 	{			
-		Gun->GetFiringComponent()->OnEndCycle.AddDynamic(this, &UTVRPistolSlide::OnEndFiringCycle);
+		Gun->GetFiringComponent()->OnEndCycleNative.AddUObject(this, &UTVRPistolSlide::OnEndFiringCycle);
 	}
 }
 
@@ -188,29 +187,35 @@ void UTVRPistolSlide::SetProgress_Implementation(float Value)
 
 void UTVRPistolSlide::PlaySlideBackSound()
 {
-	if(bShouldPlayBackSound && AudioComponent)
+	if(!bShouldPlayBackSound)
+	{
+		return;
+	}
+	bShouldPlayBackSound = false;
+	if(UAudioComponent* Voice = GunAudio ? GunAudio->PrepareOneShot(SlideSoundCue, this) : nullptr)
 	{
-		bShouldPlayBackSound = false;
-		AudioComponent->Stop();
 		const float VolumeBase = FMath::Abs(ChargingHandleSpeed * MaxDeflection)* 0.5f;
-		AudioComponent->SetVolumeMultiplier(FMath::Clamp(VolumeBase, 0.65f, 1.f));
-		AudioComponent->SetBoolParameter(FName("Back"), true);
-		// AudioComponent->SetBoolParameter(FName("Pump"), true);
-		AudioComponent->Play();
+		Voice->SetVolumeMultiplier(FMath::Clamp(VolumeBase, 0.65f, 1.f));
+		Voice->SetBoolParameter(FName("Back"), true);
+		// Voice->SetBoolParameter(FName("Pump"), true);
+		Voice->Play();
 	}
 }
 
 void UTVRPistolSlide::PlaySlideCloseSound()
 {
-	if(bShouldPlayCloseSound && AudioComponent)
+	if(!bShouldPlayCloseSound)
+	{
+		return;
+	}
+	bShouldPlayCloseSound = false;
+	if(UAudioComponent* Voice = GunAudio ? GunAudio->PrepareOneShot(SlideSoundCue, this) : nullptr)
 	{
-		bShouldPlayCloseSound = false;
-		AudioComponent->Stop();
 		const float VolumeBase = FMath::Abs(ChargingHandleSpeed * MaxDeflection) * 0.5f;
-		AudioComponent->SetVolumeMultiplier(FMath::Clamp(VolumeBase, 0.1f, 1.f));
-		AudioComponent->SetBoolParameter(FName("Back"), false);
-		// AudioComponent->SetBoolParameter(FName("Pump"), true);
-		AudioComponent->Play();
+		Voice->SetVolumeMultiplier(FMath::Clamp(VolumeBase, 0.1f, 1.f));
+		Voice->SetBoolParameter(FName("Back"), false);
+		// Voice->SetBoolParameter(FName("Pump"), true);
+		Voice->Play();
 	}
 }
 
@@ -219,3 +224,13 @@ void UTVRPistolSlide::OnEndFiringCycle()
 	Execute_SetProgress(this, 0.f);
 	ChargingHandleSpeed = 0.f;
 }
+
+void UTVRPistolSlide::ResetForPool_Implementation()
+{
+	bIsLocked = false;
+	LockedProgress = 0.f;
+	ChargingHandleSpeed = 0.f;
+	bShouldPlayBackSound = false;
+	bShouldPlayCloseSound = false;
+	Execute_SetProgress(this, 0.f);
+}
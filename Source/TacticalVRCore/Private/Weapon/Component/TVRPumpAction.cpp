@@ -6,6 +6,7 @@
 #include "TacticalCollisionProfiles.h"
 #include "Components/AudioComponent.h"
 #include "Sound/SoundCue.h"
+#include "Weapon/Component/TVRGunAudioComponent.h"
 
 UTVRPumpAction::UTVRPumpAction(const FObjectInitializer& OI) : Super(OI)
 {
@@ -24,6 +25,7 @@ UTVRPumpAction::UTVRPumpAction(const FObjectInitializer& OI) : Super(OI)
 
 	InitialProgress = 0.f;
 	AudioComponent = nullptr;
+	GunAudio = nullptr;
 	PumpActionSoundCue = nullptr;
 }
 
@@ -32,12 +34,9 @@ void UTVRPumpAction::BeginPlay()
 	Super::BeginPlay();
 
 	TArray<USceneComponent*> ChildComps;
-	if(PumpActionSoundCue && !AudioComponent)
+	if(PumpActionSoundCue)
 	{
-		AudioComponent = NewObject<UAudioComponent>(GetOwner());
-		AudioComponent->bAutoActivate = false;
-		AudioComponent->AttachToComponent(this, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
-		AudioComponent->SetSound(PumpActionSoundCue);
+		GunAudio = UTVRGunAudioComponent::FindOrCreate(GetOwner());
 	}
 
 	InitialRelativeTransform = GetRelativeTransform();
@@ -56,10 +55,6 @@ void UTVRPumpAction::BeginPlay()
 
 void UTVRPumpAction::BeginDestroy()
 {
-	if(AudioComponent && !AudioComponent->IsPendingKill())
-	{
-		AudioComponent->DestroyComponent();
-	}
 	Super::BeginDestroy();
 }
 
@@ -238,28 +233,54 @@ UGripMotionControllerComponent* UTVRPumpAction::GetGrippingController() const
 	return nullptr;
 }
 
-void UTVRPumpAction::PlayPumpBackSound()
+UAudioComponent* UTVRPumpAction::PreparePumpVoice()
 {
-	if(bShouldPlayRackBackSound && AudioComponent)
+	if(AudioComponent)
 	{
-		bShouldPlayRackBackSound = false;
 		AudioComponent->Stop();
-		AudioComponent->SetVolumeMultiplier(FMath::Clamp(FMath::Abs(PumpSpeed) * 0.5f, 0.7f, 1.f));
-		AudioComponent->SetBoolParameter(FName("PumpBack"), true);
-		AudioComponent->SetBoolParameter(FName("Pump"), true);
-		AudioComponent->Play();
+		return AudioComponent;
+	}
+	return GunAudio ? GunAudio->PrepareOneShot(PumpActionSoundCue, this) : nullptr;
+}
+
+void UTVRPumpAction::PlayPumpBackSound()
+{
+	if(!bShouldPlayRackBackSound)
+	{
+		return;
+	}
+	bShouldPlayRackBackSound = false;
+	if(UAudioComponent* Voice = PreparePumpVoice())
+	{
+		Voice->SetVolumeMultiplier(FMath::Clamp(FMath::Abs(PumpSpeed) * 0.5f, 0.7f, 1.f));
+		Voice->SetBoolParameter(FName("PumpBack"), true);
+		Voice->SetBoolParameter(FName("Pump"), true);
+		Voice->Play();
 	}
 }
 
 void UTVRPumpAction::PlayPumpCloseSound()
 {
-	if(bShouldPlayCloseSound  && AudioComponent)
+	if(!bShouldPlayCloseSound)
 	{
-		bShouldPlayCloseSound = false;
-		AudioComponent->Stop();
-		AudioComponent->SetVolumeMultiplier(FMath::Clamp(FMath::Abs(PumpSpeed) * 0.5f, 0.1f, 1.f));
-		AudioComponent->SetBoolParameter(FName("PumpBack"), false);
-		AudioComponent->SetBoolParameter(FName("Pump"), true);
-		AudioComponent->Play();
+		return;
 	}
+	bShouldPlayCloseSound = false;
+	if(UAudioComponent* Voice = PreparePumpVoice())
+	{
+		Voice->SetVolumeMultiplier(FMath::Clamp(FMath::Abs(PumpSpeed) * 0.5f, 0.1f, 1.f));
+		Voice->SetBoolParameter(FName("PumpBack"), false);
+		Voice->SetBoolParameter(FName("Pump"), true);
+		Voice->Play();
+	}
+}
+
+void UTVRPumpAction::ResetForPool_Implementation()
+{
+	bIsLocked = false;
+	LockedProgress = 0.f;
+	PumpSpeed = 0.f;
+	bShouldPlayRackBackSound = false;
+	bShouldPlayCloseSound = false;
+	Execute_SetProgress(this, 0.f);
 }
@@ -5,6 +5,15 @@
 #include "Player/TVRCharacter.h"
 #include "Weapon/Attachments/WPNA_UnderbarrelWeapon.h"
 #include "GripMotionControllerComponent.h"
+#include "Components/TVRHapticsMixerComponent.h"
+
+namespace TVRTrigger
+{
+	const FName HapticsSource(TEXT("TriggerFeel"));
+
+	/** Samples further apart than this belong to an idle trigger, crossings between them are not interpolated */
+	constexpr double MaxCrossingInterpolationTime = 0.05;
+}
 
 // Sets default values for this component's properties
 UTVRTriggerComponent::UTVRTriggerComponent()
@@ -15,6 +24,11 @@ UTVRTriggerComponent::UTVRTriggerComponent()
 	PrimaryComponentTick.bStartWithTickEnabled = false;
 
 	TriggerAxis = 0.f;
+	LastTickTriggerAxis = 0.f;
+	LastSampleTime = 0.0;
+	LastActivateTime = 0.0;
+	LastResetTime = 0.0;
+	bReceivesTriggerSamples = false;
 	
 	TriggerActivate = 0.4f;
 	TriggerReset = 0.2f;
@@ -65,7 +79,17 @@ void UTVRTriggerComponent::ActivateTrigger(UGripMotionControllerComponent* Activ
 {
 	if(ActivatingController)
 	{
+		if(UsingController)
+		{
+			DeactivateTrigger();
+		}
 		UsingController = ActivatingController;
+		LastSampleTime = FPlatformTime::Seconds();
+		bReceivesTriggerSamples = false;
+		if(ATVRCharacter* UsingCharacter = Cast<ATVRCharacter>(UsingController->GetOwner()))
+		{
+			TriggerSampleHandle = UsingCharacter->OnTriggerAxisSample.AddUObject(this, &UTVRTriggerComponent::OnTriggerAxisSample);
+		}
 		SetComponentTickEnabled(true);
 	}
 }
@@ -79,12 +103,18 @@ void UTVRTriggerComponent::DeactivateTrigger()
 		APawn* PawnOwner = Cast<APawn>(UsingController->GetOwner());
 		if(PawnOwner && PawnOwner->IsLocallyControlled())
 		{
-			if(APlayerController* PC = Cast<APlayerController>(PawnOwner->GetController()))
+			if(UTVRHapticsMixerComponent* Mixer = UTVRHapticsMixerComponent::FindOrCreate(Cast<APlayerController>(PawnOwner->GetController())))
 			{
-				PC->SetHapticsByValue(0.f, 0.f, HandType);
+				Mixer->ClearHaptics(HandType, TVRTrigger::HapticsSource);
 			}
 		}
+		if(ATVRCharacter* UsingCharacter = Cast<ATVRCharacter>(PawnOwner))
+		{
+			UsingCharacter->OnTriggerAxisSample.Remove(TriggerSampleHandle);
+		}
 	}	
+	TriggerSampleHandle.Reset();
+	bReceivesTriggerSamples = false;
 	SetComponentTickEnabled(false);
 	UsingController = nullptr;
 }
@@ -109,6 +139,101 @@ float UTVRTriggerComponent::GetParentTriggerAxis() const
 	return 0.f;
 }
 
+void UTVRTriggerComponent::OnTriggerAxisSample(EControllerHand Hand, float Value, double Timestamp)
+{
+	if(UsingController)
+	{
+		EControllerHand HandType;
+		UsingController->GetHandType(HandType);
+		if(HandType == Hand)
+		{
+			bReceivesTriggerSamples = true;
+			PushTriggerSample(Value, Timestamp);
+		}
+	}
+}
+
+double UTVRTriggerComponent::GetCrossingTime(float PrevValue, double PrevTime, float Threshold) const
+{
+	const float DeltaValue = TriggerAxis - PrevValue;
+	if(FMath::IsNearlyZero(DeltaValue) || LastSampleTime <= PrevTime)
+	{
+		return LastSampleTime;
+	}
+	const float Alpha = FMath::Clamp((Threshold - PrevValue) / DeltaValue, 0.f, 1.f);
+	const double InterpStartTime = FMath::Max(PrevTime, LastSampleTime - TVRTrigger::MaxCrossingInterpolationTime);
+	return InterpStartTime + (LastSampleTime - InterpStartTime) * Alpha;
+}
+
+double UTVRTriggerComponent::GetCurrentPullActivateTime() const
+{
+	if(UsingController && bTriggerNeedsReset && LastActivateTime >= LastResetTime)
+	{
+		return LastActivateTime;
+	}
+	return 0.0;
+}
+
+void UTVRTriggerComponent::PushTriggerSample(float Value, double Timestamp)
+{
+	if(!UsingController)
+	{
+		return;
+	}
+	
+	const float PrevTriggerAxis = TriggerAxis;
+	const double PrevSampleTime = LastSampleTime;
+	TriggerAxis = Value;
+	LastSampleTime = Timestamp;
+
+	if(PrevTriggerAxis != TriggerAxis)
+	{
+		if(TriggerAxis - PrevTriggerAxis > 0.f)
+		{
+			// Trigger Increases
+			if(!bTriggerNeedsReset && TriggerAxis > TriggerActivate)
+			{
+				bTriggerNeedsReset = true;
+				LastActivateTime = GetCrossingTime(PrevTriggerAxis, PrevSampleTime, TriggerActivate);
+				if(OnTriggerActivate.IsBound())
+				{						
+					OnTriggerActivate.Broadcast();
+				}
+			}
+			
+			if(bDualStageTrigger && !bTriggerNeedsReset2 && TriggerAxis > TriggerActivate2)
+			{
+				bTriggerNeedsReset2 = true;
+				if(OnSecondTriggerStageActivate.IsBound())
+				{						
+					OnSecondTriggerStageActivate.Broadcast();
+				}
+			}
+		}
+		else
+		{
+			// Trigger Decreases
+			if(bTriggerNeedsReset && TriggerAxis < TriggerReset)
+			{
+				bTriggerNeedsReset = false;
+				LastResetTime = GetCrossingTime(PrevTriggerAxis, PrevSampleTime, TriggerReset);
+				if(OnTriggerReset.IsBound())
+				{						
+					OnTriggerReset.Broadcast();
+				}
+			}
+			if(bDualStageTrigger && bTriggerNeedsReset2 && TriggerAxis < TriggerReset2)
+			{
+				bTriggerNeedsReset2 = false;
+				if(OnSecondTriggerStageReset.IsBound())
+				{						
+					OnSecondTriggerStageReset.Broadcast();
+				}
+			}
+		}
+	}
+}
+
 // Called every frame
 void UTVRTriggerComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
@@ -119,73 +244,34 @@ void UTVRTriggerComponent::TickComponent(float DeltaTime, ELevelTick TickType, F
 		return;
 	}
 	
-	const float PrevTriggerAxis = TriggerAxis;
+	const float PrevTriggerAxis = LastTickTriggerAxis;
 	if(UsingController)
 	{
-		TriggerAxis = GetParentTriggerAxis();
+		if(!bReceivesTriggerSamples)
+		{
+			// nobody pushes samples to us, so we fall back to polling the axis
+			PushTriggerSample(GetParentTriggerAxis(), FPlatformTime::Seconds());
+		}
 		
 		EControllerHand HandType;
 		UsingController->GetHandType(HandType);
 		APawn* PawnOwner = Cast<APawn>(UsingController->GetOwner());
 		if(PawnOwner && PawnOwner->IsLocallyControlled())
 		{
-			if(APlayerController* PC = Cast<APlayerController>(PawnOwner->GetController()))
+			if(UTVRHapticsMixerComponent* Mixer = UTVRHapticsMixerComponent::FindOrCreate(Cast<APlayerController>(PawnOwner->GetController())))
 			{
 				if(bTriggerNeedsReset)
 				{
-					PC->SetHapticsByValue(0.f, 0.f, HandType);
+					Mixer->ClearHaptics(HandType, TVRTrigger::HapticsSource);
 				}
 				else
 				{
 					const float ClosenessToWall = 1 - FMath::Max(TriggerActivate - TriggerAxis, 0.f)/TriggerActivate;
 					const float DeltaTrigger = (TriggerAxis - PrevTriggerAxis)/DeltaTime;
 					const float DeltaTriggerDeadZone = 0.01f*ClosenessToWall;
-					PC->SetHapticsByValue(0.2f, FMath::Clamp((DeltaTrigger-DeltaTriggerDeadZone)*0.5f*ClosenessToWall, 0.f, 0.1f), HandType);
-				}
-			}
-		}
-
-		if(PrevTriggerAxis != TriggerAxis)
-		{
-			if(TriggerAxis - PrevTriggerAxis > 0.f)
-			{
-				// Trigger Increases
-				if(!bTriggerNeedsReset && TriggerAxis > TriggerActivate)
-				{
-					bTriggerNeedsReset = true;
-					if(OnTriggerActivate.IsBound())
-					{						
-						OnTriggerActivate.Broadcast();
-					}
-				}
-				
-				if(bDualStageTrigger && !bTriggerNeedsReset2 && TriggerAxis > TriggerActivate2)
-				{
-					bTriggerNeedsReset2 = true;
-					if(OnSecondTriggerStageActivate.IsBound())
-					{						
-						OnSecondTriggerStageActivate.Broadcast();
-					}
-				}
-			}
-			else
-			{
-				// Trigger Decreases
-				if(bTriggerNeedsReset && TriggerAxis < TriggerReset)
-				{
-					bTriggerNeedsReset = false;
-					if(OnTriggerReset.IsBound())
-					{						
-						OnTriggerReset.Broadcast();
-					}
-				}
-				if(bDualStageTrigger && bTriggerNeedsReset2 && TriggerAxis < TriggerReset2)
-				{
-					bTriggerNeedsReset2 = false;
-					if(OnSecondTriggerStageReset.IsBound())
-					{						
-						OnSecondTriggerStageReset.Broadcast();
-					}
+					const float Amplitude = FMath::Clamp((DeltaTrigger-DeltaTriggerDeadZone)*0.5f*ClosenessToWall, 0.f, 0.1f);
+					// submitted every tick, so it only lasts one frame and any kick overrides it
+					Mixer->SubmitHaptics(HandType, Amplitude, 0.2f, 0.f, 0, TVRTrigger::HapticsSource);
 				}
 			}
 		}
@@ -194,5 +280,5 @@ void UTVRTriggerComponent::TickComponent(float DeltaTime, ELevelTick TickType, F
 	{
 		TriggerAxis = 0.f;
 	}
+	LastTickTriggerAxis = TriggerAxis;
 }
-
@@ -3,11 +3,15 @@
 #include "Weapon/TVRCartridge.h"
 
 #include "TacticalCollisionProfiles.h"
+#include "Components/TVRAmmoContainerComponent.h"
 #include "Interfaces/TVRHandSocketInterface.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/AudioComponent.h"
 #include "Particles/ParticleSystem.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
+#include "Settings/TVRCoreWeaponSettings.h"
+#include "Subsystems/TVRFXPreloadSubsystem.h"
+#include "Subsystems/TVRImpactAudioSubsystem.h"
 
 // Sets default values
 ATVRCartridge::ATVRCartridge(const FObjectInitializer& OI) : Super(OI)
@@ -16,6 +20,9 @@ ATVRCartridge::ATVRCartridge(const FObjectInitializer& OI) : Super(OI)
 	PrimaryActorTick.bCanEverTick = false;
 
 	GetStaticMeshComponent()->SetNotifyRigidBodyCollision(true); // enable hit events
+	GetStaticMeshComponent()->BodyInstance.bGenerateWakeEvents = true; // net dormancy
+	NetDormancy = DORM_Initial;
+	NetRelevancyPolicy.LooseNetCullDistance = 2000.f;
 	GetStaticMeshComponent()->SetCollisionProfileName(COLLISION_WEAPON);
 
 	CollisionCapsule = CreateDefaultSubobject<UCapsuleComponent>(FName("CollisionCapsule"));
@@ -28,13 +35,20 @@ ATVRCartridge::ATVRCartridge(const FObjectInitializer& OI) : Super(OI)
 	HitAudioComponent->SetupAttachment(GetStaticMeshComponent());
 	HitAudioComponent->SetAutoActivate(false);
 
+	bIsProjectile = false;
+	ProjectileClass = nullptr;
 	bIsBuckshot = false;
 	NumBucks = 1;
 	BuckshotSpread = 0.f;
 	SpentCartridgeMesh = nullptr;
 	bIsSpent = false;
 	TraceDistance = 5000.f;
+	bUseBallisticTrajectory = false;
+	MuzzleVelocity = 90000.f;
+	DragCoefficient = 1.1e-5f;
+	TrajectorySegments = 4;
 	FlyByThresholdDistance = 150.f;
+	LastHitSoundTime = -1.f;
 }
 
 // Called when the game starts or when spawned
@@ -43,6 +57,14 @@ void ATVRCartridge::BeginPlay()
 	Super::BeginPlay();
 
 	GetStaticMeshComponent()->OnComponentHit.AddDynamic(this, &ATVRCartridge::OnComponentHit);
+	GetStaticMeshComponent()->OnComponentSleep.AddDynamic(this, &ATVRCartridge::OnRootBodySleep);
+	GetStaticMeshComponent()->OnComponentWake.AddDynamic(this, &ATVRCartridge::OnRootBodyWake);
+	NetRelevancyPolicy.Apply(this);
+
+	if(UTVRFXPreloadSubsystem* FXPreload = GetWorld()->GetSubsystem<UTVRFXPreloadSubsystem>())
+	{
+		FXPreload->RequestCartridgeFX(GetClass());
+	}
 }
 
 // Called every frame
@@ -54,19 +76,69 @@ void ATVRCartridge::Tick(float DeltaTime)
 void ATVRCartridge::OnComponentHit(UPrimitiveComponent* HitComponent, AActor* OtherActor,
 	UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
 {
+	NetRelevancyPolicy.Wake(this);
+	
 	constexpr float HitSoundThresholdSq = 0.3f*0.3f;
 	const float HitStrength = NormalImpulse.SizeSquared();
 	const float DeltaStrength = HitStrength-HitSoundThresholdSq;
 	if(DeltaStrength > 0)
 	{
-		HitAudioComponent->Stop();
-		HitAudioComponent->SetVolumeMultiplier(FMath::Clamp(DeltaStrength/10.f, 0.f, 1.f));
-		HitAudioComponent->SetIntParameter(FName(TEXT("SurfaceType")),
-			Hit.PhysMaterial.IsValid() ? Hit.PhysMaterial->SurfaceType : EPhysicalSurface::SurfaceType_Default);
-		HitAudioComponent->Play();
+		// a bouncing or rolling casing reports many hits in a row, only the first one is audible anyway
+		const UTVRCoreWeaponSettings* Settings = UTVRCoreWeaponSettings::Get();
+		const float Now = GetWorld()->GetTimeSeconds();
+		if(Now - LastHitSoundTime < Settings->CasingClinkMinInterval)
+		{
+			return;
+		}
+
+		UTVRImpactAudioSubsystem* ImpactAudio = GetWorld()->GetSubsystem<UTVRImpactAudioSubsystem>();
+		if(ImpactAudio && ImpactAudio->PlayImpactSound(HitAudioComponent->Sound, Hit.ImpactPoint,
+			Hit.PhysMaterial.IsValid() ? Hit.PhysMaterial->SurfaceType.GetValue() : EPhysicalSurface::SurfaceType_Default,
+			FMath::Clamp(DeltaStrength/10.f, 0.f, 1.f), HitAudioComponent->AttenuationSettings,
+			Settings->CasingClinkPriorityScale))
+		{
+			LastHitSoundTime = Now;
+		}
+	}
+}
+
+bool ATVRCartridge::IsNetRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation) const
+{
+	return NetRelevancyPolicy.IsNetRelevantFor(this, RealViewer, ViewTarget, SrcLocation);
+}
+
+void ATVRCartridge::OnGrip_Implementation(UGripMotionControllerComponent* GrippingController,
+	const FBPActorGripInformation& GripInformation)
+{
+	Super::OnGrip_Implementation(GrippingController, GripInformation);
+	NetRelevancyPolicy.Wake(this);
+}
+
+void ATVRCartridge::OnGripRelease_Implementation(UGripMotionControllerComponent* ReleasingController,
+	const FBPActorGripInformation& GripInformation, bool bWasSocketed)
+{
+	Super::OnGripRelease_Implementation(ReleasingController, GripInformation, bWasSocketed);
+	if(!HasAuthority() || bWasSocketed || bIsSpent || GetAttachParentActor())
+	{
+		return;
+	}
+
+	if(UTVRAmmoContainerComponent* Container = UTVRAmmoContainerComponent::FindContainerAt(this, GetActorLocation()))
+	{
+		Container->TryAbsorbCartridge(this);
 	}
 }
 
+void ATVRCartridge::OnRootBodySleep(UPrimitiveComponent* SleepingComponent, FName BoneName)
+{
+	NetRelevancyPolicy.TrySleep(this);
+}
+
+void ATVRCartridge::OnRootBodyWake(UPrimitiveComponent* WakingComponent, FName BoneName)
+{
+	NetRelevancyPolicy.Wake(this);
+}
+
 void ATVRCartridge::ClosestGripSlotInRange_Implementation(FVector WorldLocation, bool bSecondarySlot,
                                                              bool& bHadSlotInRange, FTransform& SlotWorldTransform, FName& SlotName,
                                                              UGripMotionControllerComponent* CallingController, FName OverridePrefix)
@@ -84,6 +156,17 @@ void ATVRCartridge::ClosestGripSlotInRange_Implementation(FVector WorldLocation,
 	}
 }
 
+const FTVRTrajectoryTable& ATVRCartridge::GetTrajectoryTable(float GravityZ) const
+{
+	// an invalid result is kept as well, so it is not rebuilt for every shot
+	if(!TrajectoryTable.IsBuiltFor(GravityZ))
+	{
+		constexpr int32 NumTableSamples = 64;
+		TrajectoryTable.Build(MuzzleVelocity, DragCoefficient, GravityZ, TraceDistance, NumTableSamples);
+	}
+	return TrajectoryTable;
+}
+
 const FImpactParticleData* ATVRCartridge::GetImpactParticle(EPhysicalSurface SurfaceType) const
 {
 	if(const auto ParticleRef = ImpactParticles.Find(SurfaceType))
@@ -114,6 +197,32 @@ const FImpactDecalData* ATVRCartridge::GetImpactDecal(EPhysicalSurface SurfaceTy
 	return nullptr;
 }
 
+void ATVRCartridge::GetFXAssets(TArray<FSoftObjectPath>& OutAssets) const
+{
+	for(const auto& Particle: ImpactParticles)
+	{
+		if(!Particle.Value.ParticleSystem.IsNull())
+		{
+			OutAssets.AddUnique(Particle.Value.ParticleSystem.ToSoftObjectPath());
+		}
+	}
+	for(const auto& Decal: ImpactDecals)
+	{
+		if(!Decal.Value.DecalMaterial.IsNull())
+		{
+			OutAssets.AddUnique(Decal.Value.DecalMaterial.ToSoftObjectPath());
+		}
+	}
+	if(!ImpactSound.IsNull())
+	{
+		OutAssets.AddUnique(ImpactSound.ToSoftObjectPath());
+	}
+	if(!FlyBySound.IsNull())
+	{
+		OutAssets.AddUnique(FlyBySound.ToSoftObjectPath());
+	}
+}
+
 float ATVRCartridge::GetFlyByVolume(const float Dist) const
 {
 	return FlyBySoundVolume.GetRichCurveConst()->Eval(Dist);
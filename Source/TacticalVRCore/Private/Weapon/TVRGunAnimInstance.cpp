@@ -2,11 +2,122 @@
 
 #include "Weapon/TVRGunAnimInstance.h"
 #include "Weapon/TVRGunBase.h"
-#include "Weapon/TVRMagazine.h"
-#include "Weapon/Component/TVRChargingHandleInterface.h"
 #include "Weapon/Component/TVRGunFireComponent.h"
-#include "Weapon/Component/TVRMagWellComponent.h"
-#include "Weapon/Component/TVRTriggerComponent.h"
+
+FTVRGunAnimState::FTVRGunAnimState()
+{
+	Trigger = 0.f;
+	Bolt = 0.f;
+	Hammer = 0.f;
+	MagInsertionProgress = 0.f;
+	FiringMode = ETVRFireMode::Single;
+	bMagazineReleasePressed = false;
+	bBoltReleasePressed = false;
+	bIsBoltLocked = false;
+	bHasChargingHandle = false;
+	bIsChargingHandleGrabbed = false;
+	ChargingHandle = 0.f;
+	ChargingHandleStroke = 0.f;
+	ChargingHandleGrabType = ETVRLeftRight::None;
+}
+
+bool FTVRGunAnimState::operator==(const FTVRGunAnimState& Other) const
+{
+	return Trigger == Other.Trigger
+		&& Bolt == Other.Bolt
+		&& Hammer == Other.Hammer
+		&& MagInsertionProgress == Other.MagInsertionProgress
+		&& FiringMode == Other.FiringMode
+		&& bMagazineReleasePressed == Other.bMagazineReleasePressed
+		&& bBoltReleasePressed == Other.bBoltReleasePressed
+		&& bIsBoltLocked == Other.bIsBoltLocked
+		&& bHasChargingHandle == Other.bHasChargingHandle
+		&& bIsChargingHandleGrabbed == Other.bIsChargingHandleGrabbed
+		&& ChargingHandle == Other.ChargingHandle
+		&& ChargingHandleStroke == Other.ChargingHandleStroke
+		&& ChargingHandleGrabType == Other.ChargingHandleGrabType;
+}
+
+FTVRGunAnimInstanceProxy::FTVRGunAnimInstanceProxy()
+{
+	SelectorValue = 0.f;
+	SelectorTarget = 0.f;
+	SelectorLerpSpeed = 0.f;
+	bSelectorInitialized = false;
+	bHasAnimState = false;
+	TimeSinceChange = 0.f;
+	SettleTime = 0.f;
+}
+
+FTVRGunAnimInstanceProxy::FTVRGunAnimInstanceProxy(UAnimInstance* Instance) : FAnimInstanceProxy(Instance)
+{
+	SelectorValue = 0.f;
+	SelectorTarget = 0.f;
+	SelectorLerpSpeed = 0.f;
+	bSelectorInitialized = false;
+	bHasAnimState = false;
+	TimeSinceChange = 0.f;
+	SettleTime = 0.f;
+}
+
+void FTVRGunAnimInstanceProxy::PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds)
+{
+	FAnimInstanceProxy::PreUpdate(InAnimInstance, DeltaSeconds);
+
+	UTVRGunAnimInstance* GunAnimInstance = CastChecked<UTVRGunAnimInstance>(InAnimInstance);
+	bHasAnimState = GunAnimInstance->bHasAnimState;
+	if(!bHasAnimState)
+	{
+		return;
+	}
+
+	if(GunAnimInstance->bAnimStateDirty)
+	{
+		GunAnimInstance->ApplyAnimState();
+		GunAnimInstance->bAnimStateDirty = false;
+		TimeSinceChange = 0.f;
+	}
+	// the target can be overridden, so it is read on the game thread
+	SelectorTarget = GunAnimInstance->GetSelectorTargetValue();
+	SelectorLerpSpeed = GunAnimInstance->SelectorLerpSpeed;
+	SettleTime = GunAnimInstance->SettleTime;
+}
+
+void FTVRGunAnimInstanceProxy::Update(float DeltaSeconds)
+{
+	if(!bHasAnimState)
+	{
+		// wait for the gun, otherwise the selector would start at the default fire mode
+		return;
+	}
+
+	if(!bSelectorInitialized)
+	{
+		SelectorValue = SelectorTarget;
+		bSelectorInitialized = true;
+	}
+	else if(SelectorValue != SelectorTarget)
+	{
+		SelectorValue = FMath::FInterpConstantTo(SelectorValue, SelectorTarget, DeltaSeconds, SelectorLerpSpeed);
+		TimeSinceChange = 0.f;
+	}
+	else
+	{
+		TimeSinceChange += DeltaSeconds;
+	}
+
+	// the graph reads the selector later in this update, the game thread does not write it while the update runs
+	static_cast<UTVRGunAnimInstance*>(GetAnimInstanceObject())->SelectorValue = SelectorValue;
+}
+
+void FTVRGunAnimInstanceProxy::PostUpdate(UAnimInstance* InAnimInstance) const
+{
+	FAnimInstanceProxy::PostUpdate(InAnimInstance);
+
+	UTVRGunAnimInstance* GunAnimInstance = CastChecked<UTVRGunAnimInstance>(InAnimInstance);
+	GunAnimInstance->bSelectorInitialized = bSelectorInitialized;
+	GunAnimInstance->bSettled = bSelectorInitialized && SelectorValue == SelectorTarget && TimeSinceChange >= SettleTime;
+}
 
 UTVRGunAnimInstance::UTVRGunAnimInstance(const FObjectInitializer& OI) : Super(OI)
 {
@@ -22,61 +133,61 @@ UTVRGunAnimInstance::UTVRGunAnimInstance(const FObjectInitializer& OI) : Super(O
 	ChargingHandleStroke = 10.f;
 	bFirstRoundEjected = false;
 	SelectorLerpSpeed = 300.f;
+	SettleTime = 0.2f;
+	bAnimStateDirty = false;
+	bHasAnimState = false;
+	bSettled = false;
+}
+
+FAnimInstanceProxy* UTVRGunAnimInstance::CreateAnimInstanceProxy()
+{
+	return new FTVRGunAnimInstanceProxy(this);
+}
+
+void UTVRGunAnimInstance::DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy)
+{
+	delete static_cast<FTVRGunAnimInstanceProxy*>(InProxy);
 }
 
-void UTVRGunAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
+void UTVRGunAnimInstance::SetAnimState(const FTVRGunAnimState& NewState)
 {
-    Super::NativeUpdateAnimation(DeltaSeconds);
-
-    ATVRGunBase* Gun = GetGunOwner();
-    if(Gun)
-    {
-    	if(const auto TriggerComp = Gun->GetTriggerComponent())
-    	{
-    		Trigger = TriggerComp->GetTriggerValue();
-    	}
-    	else
-    	{
-    		Trigger = 0.f;
-    	}
-    	if(const auto ChargingHandleComp = Gun->GetChargingHandleInterface())
-    	{
-    		ChargingHandleStroke = ITVRChargingHandleInterface::Execute_GetMaxTavel(Gun->GetChargingHandleInterface());
-    		bIsChargingHandleGrabbed = ITVRChargingHandleInterface::Execute_IsInUse(Gun->GetChargingHandleInterface());        	
-    		ChargingHandleGrabType = ITVRChargingHandleInterface::Execute_GetGrabLocation(Gun->GetChargingHandleInterface());
-			ChargingHandle = ITVRChargingHandleInterface::Execute_GetProgress(Gun->GetChargingHandleInterface());
-    		ChargingHandleDistance = ChargingHandle * ChargingHandleStroke;
-    	}
-    	
-        Bolt = Gun->GetBoltProgress();
-    	BoltDistance = Bolt * ChargingHandleStroke;
-    	Hammer = Gun->GetHammerProgress();
-        bBoltReleasePressed = Gun->IsBoltReleasePressed();
-        bMagazineReleasePressed = Gun->IsMagReleasePressed();
-        bIsBoltLocked = Gun->IsBoltLocked();
-    	
-    	FiringMode = Gun->GetFiringComponent()->GetCurrentFireMode();
-
-    	if(bSelectorInitialized)
-    	{
-    		const float SelectorTarget = GetSelectorTargetValue();
-    		SelectorValue = FMath::FInterpConstantTo(SelectorValue, SelectorTarget, DeltaSeconds, SelectorLerpSpeed);
-    	}
-    	else
-    	{
-    		SelectorValue = GetSelectorTargetValue();
-    		bSelectorInitialized = true;
-    	}
-
-    	if(UTVRMagazineCompInterface* MagInterface = Gun->GetMagInterface())
-    	{
-    		MagInsertionProgress = MagInterface->GetAmmoInsertProgress();
-    	}
-    	else
-    	{
-    		MagInsertionProgress = 0.f;
-    	}
-    }
+	if(!bHasAnimState)
+	{
+		bHasAnimState = true;
+		bAnimStateDirty = true;
+	}
+	if(NewState != AnimState)
+	{
+		AnimState = NewState;
+		bAnimStateDirty = true;
+	}
+}
+
+bool UTVRGunAnimInstance::IsSettled() const
+{
+	return bSettled && !bAnimStateDirty && !IsAnyMontagePlaying();
+}
+
+void UTVRGunAnimInstance::ApplyAnimState()
+{
+	Trigger = AnimState.Trigger;
+	if(AnimState.bHasChargingHandle)
+	{
+		ChargingHandleStroke = AnimState.ChargingHandleStroke;
+		bIsChargingHandleGrabbed = AnimState.bIsChargingHandleGrabbed;
+		ChargingHandleGrabType = AnimState.ChargingHandleGrabType;
+		ChargingHandle = AnimState.ChargingHandle;
+		ChargingHandleDistance = ChargingHandle * ChargingHandleStroke;
+	}
+
+	Bolt = AnimState.Bolt;
+	BoltDistance = Bolt * ChargingHandleStroke;
+	Hammer = AnimState.Hammer;
+	bBoltReleasePressed = AnimState.bBoltReleasePressed;
+	bMagazineReleasePressed = AnimState.bMagazineReleasePressed;
+	bIsBoltLocked = AnimState.bIsBoltLocked;
+	FiringMode = AnimState.FiringMode;
+	MagInsertionProgress = AnimState.MagInsertionProgress;
 }
 
 float UTVRGunAnimInstance::GetSelectorTargetValue() const
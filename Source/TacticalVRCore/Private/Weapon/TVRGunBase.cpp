@@ -1,6 +1,7 @@
 // This file is covered by the LICENSE file in the root of this plugin.
 
 #include "Weapon/TVRGunBase.h"
+#include "Net/UnrealNetwork.h"
 
 #include "TacticalCollisionProfiles.h"
 #include "Components/ArrowComponent.h"
@@ -15,6 +16,10 @@
 
 #include "Player/TVREquipmentPoint.h"
 #include "Settings/TVRCoreGameplaySettings.h"
+#include "Settings/TVRCoreWeaponSettings.h"
+#include "Subsystems/TVRFXPreloadSubsystem.h"
+#include "Subsystems/TVRGunWarmupSubsystem.h"
+#include "Subsystems/TVRWeaponProxySubsystem.h"
 
 #include "Weapon/Component/TVRMagWellComponent.h"
 #include "Weapon/Component/TVRMagazineCompInterface.h"
@@ -35,6 +40,7 @@
 #include "Weapon/Component/TVRAttachPoint_Barrel.h"
 #include "Weapon/Component/TVRChargingHandleInterface.h"
 #include "Weapon/Component/TVREjectionPort.h"
+#include "Weapon/Component/TVRGunAudioComponent.h"
 #include "Weapon/Component/TVRGunFireComponent.h"
 
 FName ATVRGunBase::PrimarySlotName(TEXT("Primary"));
@@ -56,12 +62,14 @@ ATVRGunBase::ATVRGunBase(const FObjectInitializer& OI) : Super(OI)
 	VRGripInterfaceSettings.SecondarySlotRange = 10.f;
     
     bReplicates = true;
-    bAlwaysRelevant = true;
+    bAlwaysRelevant = false;
+    NetDormancy = DORM_Initial;
     GameplayTags.AddTag(FGameplayTag::RequestGameplayTag(FName("GripType.Large")));
 
     GetStaticMeshComponent()->SetCollisionProfileName(COLLISION_WEAPON);
 	GetStaticMeshComponent()->SetGenerateOverlapEvents(true);
 	GetStaticMeshComponent()->SetNotifyRigidBodyCollision(true); // hit events
+	GetStaticMeshComponent()->BodyInstance.bGenerateWakeEvents = true; // net dormancy
 
     bIsSocketed = false;
     SavedSecondaryHand = nullptr;
@@ -75,6 +83,8 @@ ATVRGunBase::ATVRGunBase(const FObjectInitializer& OI) : Super(OI)
 	GunManipulationAudioComponent->SetupAttachment(GetStaticMeshComponent());
 	GunManipulationAudioComponent->SetAutoActivate(false);
 
+	GunAudio = CreateDefaultSubobject<UTVRGunAudioComponent>(FName(TEXT("GunAudio")));
+
 	MovablePartsMesh = CreateDefaultSubobject<USkeletalMeshComponent>(FName(TEXT("Movables")));
 	MovablePartsMesh->SetupAttachment(GetStaticMeshComponent());
 	MovablePartsMesh->SetCollisionProfileName(COLLISION_NO_COLLISION);
@@ -88,6 +98,9 @@ ATVRGunBase::ATVRGunBase(const FObjectInitializer& OI) : Super(OI)
 	bDoesCycle = true;
 
     bSkipHandSwap = false;
+	WarmupStage = ETVRGunWarmupStage::Done;
+	bIsPooled = false;
+	bStartAsProxy = false;
 
     PrimaryActorTick.bCanEverTick = true;
 	
@@ -130,7 +143,6 @@ ATVRGunBase::ATVRGunBase(const FObjectInitializer& OI) : Super(OI)
 	ChargingHandleInterface = nullptr;
 	BoltMesh = nullptr;
 	SelectorSound = nullptr;
-	SelectorAudio = nullptr;
 
 	bForceRecompile = false;
 }
@@ -148,21 +160,39 @@ void ATVRGunBase::OnConstruction(const FTransform& Transform)
 	}
 }
 
+void ATVRGunBase::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	const UWorld* World = GetWorld();
+	if(World && World->IsGameWorld() && UTVRCoreWeaponSettings::Get()->bTimeSliceGunWarmup)
+	{
+		WarmupStage = ETVRGunWarmupStage::Attachments;
+	}
+}
+
 void ATVRGunBase::BeginPlay()
 {
     Super::BeginPlay();
 
+	NetRelevancyPolicy.Apply(this);
+	GetStaticMeshComponent()->OnComponentSleep.AddDynamic(this, &ATVRGunBase::OnRootBodySleep);
+	GetStaticMeshComponent()->OnComponentWake.AddDynamic(this, &ATVRGunBase::OnRootBodyWake);
+
 	OnColorVariantChanged(ColorVariant);
-	InitAttachmentPoints();
+	if(!IsWarmupPending())
+	{
+		InitAttachmentPoints();
+	}
 	
 	InitChargingHandle();
 
 	if(GetFiringComponent())
 	{
-		GetFiringComponent()->OnFire.AddDynamic(this, &ATVRGunBase::OnFire);
-		GetFiringComponent()->OnCartridgeSpent.AddDynamic(this, &ATVRGunBase::OnCartridgeSpent);
-		GetFiringComponent()->OnEmpty.AddDynamic(this, &ATVRGunBase::OnEmpty);
-		GetFiringComponent()->OnEndCycle.AddDynamic(this, &ATVRGunBase::OnEndFiringCycle);
+		GetFiringComponent()->OnFireNative.AddUObject(this, &ATVRGunBase::OnFire);
+		GetFiringComponent()->OnCartridgeSpentNative.AddUObject(this, &ATVRGunBase::OnCartridgeSpent);
+		GetFiringComponent()->OnEmptyNative.AddUObject(this, &ATVRGunBase::OnEmpty);
+		GetFiringComponent()->OnEndCycleNative.AddUObject(this, &ATVRGunBase::OnEndFiringCycle);
 	}	
 
 	if(TriggerComponent)
@@ -185,14 +215,67 @@ void ATVRGunBase::BeginPlay()
 	InitMagInterface();
 	InitEjectionPort();
 
+	if(UTVRFXPreloadSubsystem* FXPreload = GetWorld()->GetSubsystem<UTVRFXPreloadSubsystem>())
+	{
+		FXPreload->RequestGunFX(this);
+	}
+
 	OnActorHit.AddDynamic(this, &ATVRGunBase::OnPhysicsHit);
 
-	if(SelectorSound)
+	if(GetMovablePartsMesh())
+	{
+		// the anim instance has to read the state of the current frame, not the one of the last frame
+		GetMovablePartsMesh()->PrimaryComponentTick.AddPrerequisite(this, PrimaryActorTick);
+	}
+	UpdateAnimState();
+
+	if(bStartAsProxy)
+	{
+		UTVRWeaponProxySubsystem* ProxySubsystem = GetWorld()->GetSubsystem<UTVRWeaponProxySubsystem>();
+		if(ProxySubsystem && ProxySubsystem->Dehydrate(this))
+		{
+			return;
+		}
+	}
+
+	if(IsWarmupPending())
+	{
+		GetWorld()->GetSubsystem<UTVRGunWarmupSubsystem>()->RegisterGun(this);
+	}
+}
+
+bool ATVRGunBase::WarmupStep()
+{
+	switch(WarmupStage)
+	{
+	case ETVRGunWarmupStage::Attachments:
+		InitAttachmentPoints();
+		WarmupStage = ETVRGunWarmupStage::Magazine;
+		break;
+	case ETVRGunWarmupStage::Magazine:
+		if(UTVRMagWellComponent* MagWell = Cast<UTVRMagWellComponent>(MagInterface))
+		{
+			MagWell->SpawnMagazineAttached();
+		}
+		WarmupStage = ETVRGunWarmupStage::CartridgePool;
+		break;
+	case ETVRGunWarmupStage::CartridgePool:
+		// one casing per step, the pool is the largest part of the warm-up
+		if(EjectionPort == nullptr || EjectionPort->PopulateCartridgePoolStep())
+		{
+			WarmupStage = ETVRGunWarmupStage::Done;
+		}
+		break;
+	default:
+		break;
+	}
+	return !IsWarmupPending();
+}
+
+void ATVRGunBase::CompleteWarmup()
+{
+	while(!WarmupStep())
 	{
-		SelectorAudio = NewObject<UAudioComponent>(this);
-		SelectorAudio->AttachToComponent(GetRootComponent(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
-		SelectorAudio->SetAutoActivate(false);
-		SelectorAudio->SetSound(SelectorSound);
 	}
 }
 
@@ -225,11 +308,125 @@ void ATVRGunBase::InitAttachmentPoints()
 	}
 }
 
+void ATVRGunBase::ReturnToPool()
+{
+	CompleteWarmup();
+
+	TArray<FBPGripPair> HoldingControllers;
+	bool bIsHeld = false;
+	IVRGripInterface::Execute_IsHeld(this, HoldingControllers, bIsHeld);
+	for(const FBPGripPair& Grip: HoldingControllers)
+	{
+		if(Grip.HoldingController)
+		{
+			Grip.HoldingController->DropObjectByInterface(this, Grip.GripID, FVector::ZeroVector, FVector::ZeroVector);
+		}
+	}
+	if(GetAttachParentActor())
+	{
+		DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+	}
+
+	NetRelevancyPolicy.Wake(this);
+	SetPooled(true);
+}
+
+void ATVRGunBase::IssueFromPool(const FTransform& NewTransform)
+{
+	SetActorTransform(NewTransform, false, nullptr, ETeleportType::ResetPhysics);
+	NetRelevancyPolicy.Wake(this);
+	SetPooled(false);
+}
+
+void ATVRGunBase::SetPooled(bool bNewPooled)
+{
+	if(!HasAuthority() || bIsPooled == bNewPooled)
+	{
+		return;
+	}
+	bIsPooled = bNewPooled;
+	ApplyPooledState();
+	ForceNetUpdate();
+}
+
+void ATVRGunBase::OnRep_IsPooled()
+{
+	ApplyPooledState();
+}
+
+void ATVRGunBase::ApplyPooledState()
+{
+	const bool bNewPooled = bIsPooled;
+	if(bNewPooled)
+	{
+		Execute_ResetForPool(this);
+	}
+
+	// magazine and attachments are separate actors
+	TArray<AActor*> AttachedActors;
+	GetAttachedActors(AttachedActors, true);
+	AttachedActors.Add(this);
+	for(AActor* LoopActor: AttachedActors)
+	{
+		LoopActor->SetActorHiddenInGame(bNewPooled);
+		LoopActor->SetActorEnableCollision(!bNewPooled);
+	}
+	SetActorTickEnabled(!bNewPooled);
+
+	const ATVRGunBase* DefaultGun = GetDefault<ATVRGunBase>(GetClass());
+	GetStaticMeshComponent()->SetSimulatePhysics(!bNewPooled && DefaultGun->GetStaticMeshComponent()->BodyInstance.bSimulatePhysics);
+}
+
+void ATVRGunBase::ResetForPool_Implementation()
+{
+	bIsFiring = false;
+	bHasRoundInChamber = false;
+	RoundInChamber = nullptr;
+	BoltProgress = 0.f;
+	BoltMovePct = -1.f;
+	BoltProgressSpeed = 0.f;
+	bIsBoltLocked = false;
+	bBoltReleasePressed = false;
+	HammerProgress = 0.f;
+	bHammerLocked = false;
+	bIsSocketed = false;
+	SavedSecondaryHand = nullptr;
+	if(LoadedBullet)
+	{
+		LoadedBullet->SetVisibility(false);
+	}
+
+	SetColorVariant(GetDefault<ATVRGunBase>(GetClass())->ColorVariant);
+	for(UTVRAttachmentPoint* AttachPoint: AttachmentPoints)
+	{
+		if(AttachPoint)
+		{
+			AttachPoint->ResetToDefaults();
+		}
+	}
+	InitAttachmentPoints();
+	SetCollisionProfile(COLLISION_WEAPON);
+
+	for(UActorComponent* Comp: GetComponents())
+	{
+		if(Comp && Comp != FiringComponent && Comp->Implements<UTVRPoolableInterface>())
+		{
+			Execute_ResetForPool(Comp);
+		}
+	}
+	// last, because it reads the ammo of the magazine
+	if(FiringComponent)
+	{
+		Execute_ResetForPool(FiringComponent);
+	}
+}
+
 void ATVRGunBase::Tick(float DeltaSeconds)
 {	
     Super::Tick(DeltaSeconds);
 	TickBolt(DeltaSeconds);
 	TickHammer(DeltaSeconds);
+	UpdateAnimState();
 }
 
 void ATVRGunBase::BeginDestroy()
@@ -680,10 +877,38 @@ void ATVRGunBase::SetBoltMesh(UStaticMeshComponent* NewMesh)
 	}
 }
 
+void ATVRGunBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	DOREPLIFETIME(ATVRGunBase, bIsPooled);
+}
+
+bool ATVRGunBase::IsNetRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation) const
+{
+	if(bIsPooled)
+	{
+		return true;
+	}
+	return NetRelevancyPolicy.IsNetRelevantFor(this, RealViewer, ViewTarget, SrcLocation);
+}
+
+void ATVRGunBase::OnRootBodySleep(UPrimitiveComponent* SleepingComponent, FName BoneName)
+{
+	NetRelevancyPolicy.TrySleep(this);
+}
+
+void ATVRGunBase::OnRootBodyWake(UPrimitiveComponent* WakingComponent, FName BoneName)
+{
+	NetRelevancyPolicy.Wake(this);
+}
+
 void ATVRGunBase::OnGrip_Implementation(UGripMotionControllerComponent* GrippingHand,
                                         const FBPActorGripInformation& GripInfo)
 {
     Super::OnGrip_Implementation(GrippingHand, GripInfo);
+	CompleteWarmup();
+	NetRelevancyPolicy.Wake(this);
+	FiringComponent->InvalidateTraceQueryCache();
 	
     if(bIsSocketed)
     {
@@ -747,6 +972,7 @@ void ATVRGunBase::OnGripRelease_Implementation(UGripMotionControllerComponent* G
     }
     
     Super::OnGripRelease_Implementation(GrippingHand, GripInfo, bWasSocketed);
+	FiringComponent->InvalidateTraceQueryCache();
     // todo: Allow Free Gripping
 	bool bPerformedHandSwap = false;
     if(!bSkipHandSwap)
@@ -951,7 +1177,7 @@ void ATVRGunBase::OnStartFire()
 {
     if(CanStartFire())
     {
-    	GetFiringComponent()->StartFire();
+    	GetFiringComponent()->StartFireAtTime(TriggerComponent->GetCurrentPullActivateTime());
     }
 }
 
@@ -1291,10 +1517,9 @@ void ATVRGunBase::OnBoltReleaseReleased()
 void ATVRGunBase::OnCycleFiringMode()
 {
     GetFiringComponent()->CycleFireMode();
-	if(SelectorAudio)
+	if(UAudioComponent* Voice = SelectorSound ? GetGunAudio()->PrepareOneShot(SelectorSound, GetRootComponent()) : nullptr)
 	{
-		SelectorAudio->Stop();
-		SelectorAudio->Play();
+		Voice->Play();
 	}
 }
 
@@ -1371,6 +1596,37 @@ const FBPActorGripInformation* ATVRGunBase::GetSecondaryGripInfo() const
 	return nullptr;
 }
 
+void ATVRGunBase::UpdateAnimState()
+{
+	UTVRGunAnimInstance* GunAnimInstance = GetMovablePartsMesh() ? Cast<UTVRGunAnimInstance>(GetMovablePartsMesh()->GetAnimInstance()) : nullptr;
+	if(GunAnimInstance == nullptr)
+	{
+		return;
+	}
+
+	FTVRGunAnimState State;
+	State.Trigger = TriggerComponent ? TriggerComponent->GetTriggerValue() : 0.f;
+	State.Bolt = GetBoltProgress();
+	State.Hammer = GetHammerProgress();
+	State.bBoltReleasePressed = IsBoltReleasePressed();
+	State.bMagazineReleasePressed = IsMagReleasePressed();
+	State.bIsBoltLocked = IsBoltLocked();
+	State.FiringMode = FiringComponent->GetCurrentFireMode();
+	State.MagInsertionProgress = MagInterface ? MagInterface->GetAmmoInsertProgress() : 0.f;
+	if(USceneComponent* ChargingHandleComp = GetChargingHandleInterface())
+	{
+		State.bHasChargingHandle = true;
+		State.ChargingHandleStroke = ITVRChargingHandleInterface::Execute_GetMaxTavel(ChargingHandleComp);
+		State.bIsChargingHandleGrabbed = ITVRChargingHandleInterface::Execute_IsInUse(ChargingHandleComp);
+		State.ChargingHandleGrabType = ITVRChargingHandleInterface::Execute_GetGrabLocation(ChargingHandleComp);
+		State.ChargingHandle = ITVRChargingHandleInterface::Execute_GetProgress(ChargingHandleComp);
+	}
+	GunAnimInstance->SetAnimState(State);
+
+	// a settled instance would produce the same pose again, so the mesh skips update and evaluation until that changes
+	GetMovablePartsMesh()->SetComponentTickEnabled(!GunAnimInstance->IsSettled());
+}
+
 void ATVRGunBase::OnOpenDustCover()
 {
 	if(GetMovablePartsMesh())
@@ -1380,6 +1636,7 @@ void ATVRGunBase::OnOpenDustCover()
 			if(const auto GunAnimInstance = Cast<UTVRGunAnimInstance>(AnimInstance))
 			{
 				GunAnimInstance->bOpenDustCover = true;
+				GunAnimInstance->MarkStateDirty();
 			}
 		}
 	}
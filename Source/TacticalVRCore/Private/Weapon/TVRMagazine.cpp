@@ -1,9 +1,12 @@
 // This file is covered by the LICENSE file in the root of this plugin.
 
 #include "Weapon/TVRMagazine.h"
+#include "Net/UnrealNetwork.h"
 
 #include "TacticalCollisionProfiles.h"
 #include "Player/TVREquipmentPoint.h"
+#include "Subsystems/TVRMagazineSubsystem.h"
+#include "Subsystems/TVRWeaponProxySubsystem.h"
 #include "Weapon/TVRGunBase.h"
 #include "Weapon/Component/TVRMagWellComponent.h"
 
@@ -11,6 +14,8 @@ ATVRMagazine::ATVRMagazine(const FObjectInitializer& OI) : Super(OI)
 {
     GetStaticMeshComponent()->SetCollisionProfileName(COLLISION_WEAPON);
     GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+    GetStaticMeshComponent()->BodyInstance.bGenerateWakeEvents = true; // net dormancy
+    NetDormancy = DORM_Initial;
     
     GripSlot = CreateDefaultSubobject<USceneComponent>(FName("GripSlot"));
     GripSlot->SetupAttachment(GetStaticMeshComponent());
@@ -44,6 +49,8 @@ ATVRMagazine::ATVRMagazine(const FObjectInitializer& OI) : Super(OI)
 	LimitDisplayAmmo = -1;
 
 	bNotFull = false;
+	bStartAsProxy = false;
+	bIsRecycled = false;
 	RoundRadius = 0.5f;
 	CurveRadius = 0.f;
 	CurveStartIdx = 100;
@@ -64,6 +71,10 @@ ATVRMagazine::ATVRMagazine(const FObjectInitializer& OI) : Super(OI)
 void ATVRMagazine::BeginPlay()
 {
     Super::BeginPlay();
+	NetRelevancyPolicy.Apply(this);
+	GetStaticMeshComponent()->OnComponentSleep.AddDynamic(this, &ATVRMagazine::OnRootBodySleep);
+	GetStaticMeshComponent()->OnComponentWake.AddDynamic(this, &ATVRMagazine::OnRootBodyWake);
+	
 	const float InitAmmo = bNotFull ? CurrentAmmo : AmmoCapacity;
 	CurrentAmmo = -1; // little hack to force update of instances and other components
 	SetAmmo(InitAmmo);
@@ -87,6 +98,14 @@ void ATVRMagazine::BeginPlay()
 	{
 		HandSocket = HandSockets[0];
 	}
+
+	if(bStartAsProxy)
+	{
+		if(UTVRWeaponProxySubsystem* ProxySubsystem = GetWorld()->GetSubsystem<UTVRWeaponProxySubsystem>())
+		{
+			ProxySubsystem->Dehydrate(this);
+		}
+	}
 }
 
 void ATVRMagazine::Destroyed()
@@ -111,6 +130,49 @@ void ATVRMagazine::OnConstruction(const FTransform& Transform)
 	UpdateFollowerLocation();
 }
 
+void ATVRMagazine::PostInitProperties()
+{
+	Super::PostInitProperties();
+	if(!HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
+	{
+		// the baked data is read from the default object, no need to keep a copy per magazine
+		BakedRoundTransforms.Empty();
+	}
+}
+
+#if WITH_EDITOR
+void ATVRMagazine::PreSave(const ITargetPlatform* TargetPlatform)
+{
+	Super::PreSave(TargetPlatform);
+	if(!HasAnyFlags(RF_ClassDefaultObject))
+	{
+		return;
+	}
+
+	BakedRoundTransforms.Empty();
+	const UFunction* RoundTransformFunc = GetClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(ATVRMagazine, GetRoundTransform));
+	if(RoundTransformFunc && RoundTransformFunc->GetOuter() != ATVRMagazine::StaticClass())
+	{
+		// overridden in blueprint, the blueprint might depend on components the default object does not have
+		return;
+	}
+
+	const int32 SavedAmmo = CurrentAmmo;
+	const int32 NumSets = bDoubleStack ? 2 : 1;
+	BakedRoundTransforms.Reserve(NumSets * (AmmoCapacity + 1));
+	for(int32 Parity = 0; Parity < NumSets; Parity++)
+	{
+		// the left/right order of double stack magazines depends on the parity of the round count
+		CurrentAmmo = Parity;
+		for(int32 Idx = 0; Idx <= AmmoCapacity; Idx++)
+		{
+			BakedRoundTransforms.Add(GetRoundTransform_Implementation(Idx));
+		}
+	}
+	CurrentAmmo = SavedAmmo;
+}
+#endif
+
 void ATVRMagazine::ClosestGripSlotInRange_Implementation(FVector WorldLocation, bool bSecondarySlot,
                                                          bool& bHadSlotInRange, FTransform& SlotWorldTransform, FName& SlotName,
                                                          UGripMotionControllerComponent* CallingController, FName OverridePrefix)
@@ -138,11 +200,42 @@ bool ATVRMagazine::DenyGripping_Implementation(UGripMotionControllerComponent* G
 	return false;
 }
 
+void ATVRMagazine::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	DOREPLIFETIME(ATVRMagazine, bIsRecycled);
+}
+
+bool ATVRMagazine::IsNetRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation) const
+{
+	if(bIsRecycled)
+	{
+		return true;
+	}
+	return NetRelevancyPolicy.IsNetRelevantFor(this, RealViewer, ViewTarget, SrcLocation);
+}
+
+void ATVRMagazine::OnRootBodySleep(UPrimitiveComponent* SleepingComponent, FName BoneName)
+{
+	NetRelevancyPolicy.TrySleep(this);
+}
+
+void ATVRMagazine::OnRootBodyWake(UPrimitiveComponent* WakingComponent, FName BoneName)
+{
+	NetRelevancyPolicy.Wake(this);
+}
+
 void ATVRMagazine::OnGrip_Implementation(UGripMotionControllerComponent* GrippingController,
 	const FBPActorGripInformation& GripInformation)
 {
 	Super::OnGrip_Implementation(GrippingController, GripInformation);
+	NetRelevancyPolicy.Wake(this);
 	bIsMagReleasePressed = false;
+
+	if(HasAuthority())
+	{
+		GetWorld()->GetSubsystem<UTVRMagazineSubsystem>()->UnregisterLooseMagazine(this);
+	}
 }
 
 void ATVRMagazine::OnGripRelease_Implementation(UGripMotionControllerComponent* ReleasingController,
@@ -150,6 +243,11 @@ void ATVRMagazine::OnGripRelease_Implementation(UGripMotionControllerComponent*
 {
 	Super::OnGripRelease_Implementation(ReleasingController, GripInformation, bWasSocketed);
 	bIsMagReleasePressed = false;
+
+	if(HasAuthority() && !bWasSocketed && !IsInserted())
+	{
+		GetWorld()->GetSubsystem<UTVRMagazineSubsystem>()->RegisterLooseMagazine(this);
+	}
 }
 
 bool ATVRMagazine::SimulateOnDrop_Implementation()
@@ -213,6 +311,11 @@ void ATVRMagazine::OnMagFullyEjected(const FVector& AngularVelocity, const FVect
     MagInsertPercentage = 0.f;
     ReInitGrip();
     BP_OnMagFullyEjected();
+
+	if(HasAuthority())
+	{
+		GetWorld()->GetSubsystem<UTVRMagazineSubsystem>()->RegisterLooseMagazine(this);
+	}
 }
 
 bool ATVRMagazine::TryAttachToWeapon(USceneComponent* AttachComponent, UTVRMagWellComponent* MagWell, const FTransform& AttachTransform)
@@ -289,6 +392,44 @@ void ATVRMagazine::SetAmmo(int32 NewAmmo)
     }
 }
 
+void ATVRMagazine::SetRecycled(bool bNewRecycled)
+{
+	if(!HasAuthority() || bIsRecycled == bNewRecycled)
+	{
+		return;
+	}
+	bIsRecycled = bNewRecycled;
+	ApplyRecycledState();
+	ForceNetUpdate();
+}
+
+void ATVRMagazine::OnRep_IsRecycled()
+{
+	ApplyRecycledState();
+}
+
+void ATVRMagazine::ApplyRecycledState()
+{
+	if(bIsRecycled)
+	{
+		Execute_ResetForPool(this);
+	}
+	SetActorHiddenInGame(bIsRecycled);
+	SetActorEnableCollision(!bIsRecycled);
+	// recycled magazines are reissued straight into a mag well, which does not simulate physics
+	GetStaticMeshComponent()->SetSimulatePhysics(false);
+}
+
+void ATVRMagazine::ResetForPool_Implementation()
+{
+	const ATVRMagazine* DefaultMag = GetDefault<ATVRMagazine>(GetClass());
+	SetAmmo(DefaultMag->bNotFull ? DefaultMag->CurrentAmmo : AmmoCapacity);
+	AttachedMagWell = nullptr;
+	MagInsertPercentage = 0.f;
+	bIsMagReleasePressed = false;
+	GetStaticMeshComponent()->SetCollisionProfileName(COLLISION_WEAPON);
+}
+
 bool ATVRMagazine::IsMagReleasePressed() const
 {
 	return bIsMagReleasePressed;
@@ -349,6 +490,18 @@ FTransform ATVRMagazine::GetRoundTransform_Implementation(int32 Index) const
 	}
 }
 
+FTransform ATVRMagazine::GetBakedRoundTransform(int32 Index) const
+{
+	const TArray<FTransform>& Baked = GetDefault<ATVRMagazine>(GetClass())->BakedRoundTransforms;
+	const int32 NumPerSet = AmmoCapacity + 1;
+	if(Baked.Num() == (bDoubleStack ? 2 : 1) * NumPerSet && Index >= 0 && Index < NumPerSet)
+	{
+		const int32 SetIdx = bDoubleStack && (CurrentAmmo % 2) > 0 ? 1 : 0;
+		return Baked[SetIdx * NumPerSet + Index];
+	}
+	return GetRoundTransform(Index);
+}
+
 void ATVRMagazine::UpdateFollowerLocation_Implementation()
 {
 	if(USkeletalMeshComponent* Spring = GetSpringComponent())
@@ -366,7 +519,7 @@ void ATVRMagazine::UpdateFollowerLocation_Implementation()
 
 void ATVRMagazine::GetFollowerLocationAndRotation_Implementation(FVector& OutVector, FRotator& OutRotator) const
 {
-	const FTransform AmmoTransform = GetRoundTransform(GetDisplayAmmo());
+	const FTransform AmmoTransform = GetBakedRoundTransform(GetDisplayAmmo());
 	const FRotator TempRot = AmmoTransform.GetRotation().Rotator();
 	OutVector = AmmoTransform.GetLocation() * FVector(1.f, 0.f, 1.f) + FollowerOffset;
 	const float TempY = OutVector.Y;
@@ -404,7 +557,7 @@ void ATVRMagazine::UpdateRoundInstances_Implementation()
 
 		for(int32 i = 0; i < Rounds->GetInstanceCount(); i++)
 		{
-			const FTransform NewTransform = GetRoundTransform(i);
+			const FTransform NewTransform = GetBakedRoundTransform(i);
 			Rounds->UpdateInstanceTransform(i, NewTransform, false, false, true);
 		}
 		Rounds->MarkRenderStateDirty();
@@ -5,22 +5,11 @@
 // Sets default values
 ATVRProjectile::ATVRProjectile()
 {
- 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
+	// Projectiles are simulated by the ballistics subsystem, this actor only holds the data
+	PrimaryActorTick.bCanEverTick = false;
 
+	MuzzleVelocity = 7600.f;
+	DragCoefficient = 0.f;
+	GravityScale = 1.f;
+	MaxLifeTime = 10.f;
 }
-
-// Called when the game starts or when spawned
-void ATVRProjectile::BeginPlay()
-{
-	Super::BeginPlay();
-	
-}
-
-// Called every frame
-void ATVRProjectile::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-
-}
-
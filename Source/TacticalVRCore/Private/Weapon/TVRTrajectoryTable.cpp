@@ -0,0 +1,54 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#include "Weapon/TVRTrajectoryTable.h"
+
+void FTVRTrajectoryTable::Build(float MuzzleVelocity, float DragCoefficient, float InGravityZ, float MaxDistance, int32 NumSamples)
+{
+	bIsBuilt = true;
+	GravityZ = InGravityZ;
+	NumSamples = FMath::Max(NumSamples, 2);
+	DistanceStep = MaxDistance / (NumSamples - 1);
+	Drop.SetNumZeroed(NumSamples);
+	if(MuzzleVelocity <= 0.f || DistanceStep <= 0.f)
+	{
+		return;
+	}
+
+	// integrate in 2D (X along the bore, Z up) with a small step and record whenever we pass a sample distance
+	constexpr float StepTime = 0.0005f;
+	constexpr float MaxTime = 20.f;
+	FVector2D Position(0.f, 0.f);
+	FVector2D Velocity(MuzzleVelocity, 0.f);
+	float Time = 0.f;
+	int32 NextSample = 1;
+	while(NextSample < NumSamples && Time < MaxTime && Velocity.X > KINDA_SMALL_NUMBER)
+	{
+		const FVector2D PrevPosition = Position;
+		const FVector2D Accel = Velocity * (-DragCoefficient * Velocity.Size()) + FVector2D(0.f, GravityZ);
+		Velocity += Accel * StepTime;
+		Position += Velocity * StepTime;
+		Time += StepTime;
+
+		while(NextSample < NumSamples && Position.X >= NextSample * DistanceStep)
+		{
+			const float Alpha = (NextSample * DistanceStep - PrevPosition.X) / (Position.X - PrevPosition.X);
+			Drop[NextSample] = -FMath::Lerp(PrevPosition.Y, Position.Y, Alpha);
+			NextSample++;
+		}
+	}
+
+	// the bullet never reaches the remaining samples, the table ends at the last one it did reach
+	Drop.SetNum(NextSample);
+}
+
+float FTVRTrajectoryTable::Sample(const TArray<float>& Values, float Distance) const
+{
+	if(!IsValid())
+	{
+		return 0.f;
+	}
+	const float Index = FMath::Clamp(Distance / DistanceStep, 0.f, static_cast<float>(Values.Num() - 1));
+	const int32 Lower = FMath::FloorToInt(Index);
+	const int32 Upper = FMath::Min(Lower + 1, Values.Num() - 1);
+	return FMath::Lerp(Values[Lower], Values[Upper], Index - Lower);
+}
@@ -0,0 +1,160 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#include "Weapon/TVRWeaponProxyActor.h"
+
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Net/UnrealNetwork.h"
+
+ATVRWeaponProxyActor::ATVRWeaponProxyActor(const FObjectInitializer& OI) : Super(OI)
+{
+	PrimaryActorTick.bCanEverTick = false;
+	bReplicates = true;
+	bAlwaysRelevant = true;
+	RootComponent = CreateDefaultSubobject<USceneComponent>(FName("Root"));
+}
+
+void ATVRWeaponProxyActor::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	DOREPLIFETIME(ATVRWeaponProxyActor, Instances);
+}
+
+void ATVRWeaponProxyActor::AddInstance(UStaticMesh* Mesh, const FTransform& Transform)
+{
+	Instances.Add(FTVRWeaponProxyInstance(Mesh, Transform));
+	AddRenderInstance();
+}
+
+void ATVRWeaponProxyActor::RemoveInstanceAtSwap(int32 Idx)
+{
+	if(Instances.IsValidIndex(Idx))
+	{
+		RemoveRenderInstanceAtSwap(Idx);
+		Instances.RemoveAtSwap(Idx);
+	}
+}
+
+void ATVRWeaponProxyActor::OnRep_Instances()
+{
+	// the server only appends and removes at swap, so most entries are unchanged
+	while(RenderInstances.Num() > Instances.Num())
+	{
+		RemoveRenderInstanceAtSwap(RenderInstances.Num() - 1);
+	}
+	for(int32 Idx = 0; Idx < RenderInstances.Num(); ++Idx)
+	{
+		SetRenderInstance(Idx, Instances[Idx].Mesh, Instances[Idx].Transform);
+	}
+	while(RenderInstances.Num() < Instances.Num())
+	{
+		const int32 Idx = RenderInstances.AddDefaulted();
+		SetRenderInstance(Idx, Instances[Idx].Mesh, Instances[Idx].Transform);
+	}
+}
+
+void ATVRWeaponProxyActor::AddRenderInstance()
+{
+	if(GetNetMode() == NM_DedicatedServer)
+	{
+		return;
+	}
+	const int32 Idx = Instances.Num() - 1;
+	RenderInstances.SetNum(Instances.Num());
+	SetRenderInstance(Idx, Instances[Idx].Mesh, Instances[Idx].Transform);
+}
+
+void ATVRWeaponProxyActor::RemoveRenderInstanceAtSwap(int32 Idx)
+{
+	if(!RenderInstances.IsValidIndex(Idx))
+	{
+		return;
+	}
+	ReleaseMeshInstance(Idx);
+
+	const int32 LastIdx = RenderInstances.Num() - 1;
+	if(Idx != LastIdx)
+	{
+		RenderInstances[Idx] = RenderInstances[LastIdx];
+		const FTVRWeaponProxyRenderInstance& Moved = RenderInstances[Idx];
+		if(Moved.MeshCompIdx != INDEX_NONE)
+		{
+			MeshInstanceOwners[Moved.MeshCompIdx][Moved.MeshInstanceIdx] = Idx;
+		}
+	}
+	RenderInstances.RemoveAt(LastIdx, 1, false);
+}
+
+void ATVRWeaponProxyActor::SetRenderInstance(int32 Idx, UStaticMesh* Mesh, const FTransform& Transform)
+{
+	FTVRWeaponProxyRenderInstance& RenderInstance = RenderInstances[Idx];
+	if(RenderInstance.MeshCompIdx != INDEX_NONE && RenderInstance.Mesh == Mesh)
+	{
+		if(!RenderInstance.Transform.Equals(Transform))
+		{
+			// the proxy actor stays at the origin, so world transforms can be used as they are
+			MeshComponents[RenderInstance.MeshCompIdx]->UpdateInstanceTransform(RenderInstance.MeshInstanceIdx, Transform, false, true, true);
+			RenderInstance.Transform = Transform;
+		}
+		return;
+	}
+
+	ReleaseMeshInstance(Idx);
+	RenderInstance.Mesh = Mesh;
+	RenderInstance.Transform = Transform;
+	if(Mesh == nullptr)
+	{
+		return;
+	}
+	const int32 MeshCompIdx = FindOrAddMeshComponent(Mesh);
+	RenderInstance.MeshCompIdx = MeshCompIdx;
+	RenderInstance.MeshInstanceIdx = MeshComponents[MeshCompIdx]->AddInstance(Transform);
+	MeshInstanceOwners[MeshCompIdx].Add(Idx);
+}
+
+void ATVRWeaponProxyActor::ReleaseMeshInstance(int32 Idx)
+{
+	FTVRWeaponProxyRenderInstance& RenderInstance = RenderInstances[Idx];
+	if(RenderInstance.MeshCompIdx == INDEX_NONE)
+	{
+		return;
+	}
+
+	UInstancedStaticMeshComponent* MeshComp = MeshComponents[RenderInstance.MeshCompIdx];
+	TArray<int32>& Owners = MeshInstanceOwners[RenderInstance.MeshCompIdx];
+	const int32 LastMeshInstanceIdx = Owners.Num() - 1;
+	if(RenderInstance.MeshInstanceIdx != LastMeshInstanceIdx)
+	{
+		// removing from the middle would shift all following instances of the component
+		FTransform LastTransform;
+		MeshComp->GetInstanceTransform(LastMeshInstanceIdx, LastTransform);
+		MeshComp->UpdateInstanceTransform(RenderInstance.MeshInstanceIdx, LastTransform, false, true, true);
+		const int32 MovedIdx = Owners[LastMeshInstanceIdx];
+		Owners[RenderInstance.MeshInstanceIdx] = MovedIdx;
+		RenderInstances[MovedIdx].MeshInstanceIdx = RenderInstance.MeshInstanceIdx;
+	}
+	MeshComp->RemoveInstance(LastMeshInstanceIdx);
+	Owners.RemoveAt(LastMeshInstanceIdx, 1, false);
+
+	RenderInstance.MeshCompIdx = INDEX_NONE;
+	RenderInstance.MeshInstanceIdx = INDEX_NONE;
+}
+
+int32 ATVRWeaponProxyActor::FindOrAddMeshComponent(UStaticMesh* Mesh)
+{
+	const int32 FoundIdx = MeshComponents.IndexOfByPredicate([Mesh](const UInstancedStaticMeshComponent* MeshComp)
+	{
+		return MeshComp->GetStaticMesh() == Mesh;
+	});
+	if(FoundIdx != INDEX_NONE)
+	{
+		return FoundIdx;
+	}
+
+	UInstancedStaticMeshComponent* MeshComp = NewObject<UInstancedStaticMeshComponent>(this);
+	MeshComp->SetStaticMesh(Mesh);
+	MeshComp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	MeshComp->SetupAttachment(RootComponent);
+	MeshComp->RegisterComponent();
+	MeshInstanceOwners.AddDefaulted();
+	return MeshComponents.Add(MeshComp);
+}
@@ -0,0 +1,120 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Grippables/GrippableBoxComponent.h"
+#include "TVRAmmoContainerComponent.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnAmmoContainerChanged);
+
+/**
+ * Number of loose rounds of one cartridge type
+ */
+USTRUCT(BlueprintType)
+struct TACTICALVRCORE_API FTVRAmmoCount
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Category="Ammo", BlueprintReadOnly, EditAnywhere)
+	TSubclassOf<class ATVRCartridge> CartridgeClass;
+
+	UPROPERTY(Category="Ammo", BlueprintReadOnly, EditAnywhere, meta=(ClampMin=0))
+	int32 Count;
+
+	FTVRAmmoCount() : CartridgeClass(nullptr), Count(0) {}
+	FTVRAmmoCount(TSubclassOf<class ATVRCartridge> InClass, int32 InCount) : CartridgeClass(InClass), Count(InCount) {}
+};
+
+/**
+ * Ammo box or pouch that stores loose rounds as counts instead of cartridge actors.
+ * Gripping the volume hands out a single cartridge actor, which can be loaded like any other cartridge. Releasing a
+ * cartridge inside the volume puts it back. The volume has to respond to the VR trace channel to be gripped.
+ */
+UCLASS(Blueprintable, meta = (BlueprintSpawnableComponent), ClassGroup = (TacticalVR))
+class TACTICALVRCORE_API UTVRAmmoContainerComponent : public UGrippableBoxComponent
+{
+	GENERATED_BODY()
+
+public:
+	UTVRAmmoContainerComponent(const FObjectInitializer& OI);
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	virtual void OnGrip_Implementation(UGripMotionControllerComponent* GrippingHand, const FBPActorGripInformation& GripInfo) override;
+
+	/**
+	 * Spawns one cartridge from the container and grips it with a hand. Only works on the authority.
+	 * @param Hand Hand that should hold the cartridge
+	 * @returns the spawned cartridge, nullptr if the container is empty
+	 */
+	UFUNCTION(Category="Ammo Container", BlueprintCallable)
+	class ATVRCartridge* TakeCartridge(class UGripMotionControllerComponent* Hand);
+
+	/**
+	 * Puts a loose cartridge back into the container and destroys the actor. Only works on the authority.
+	 * @param Cartridge Cartridge to absorb
+	 * @returns true if the cartridge was absorbed
+	 */
+	UFUNCTION(Category="Ammo Container", BlueprintCallable)
+	bool TryAbsorbCartridge(class ATVRCartridge* Cartridge);
+
+	/**
+	 * Adds rounds of one type, limited by the capacity. Only works on the authority.
+	 * @param CartridgeClass Type of the rounds
+	 * @param Num Number of rounds
+	 * @returns the number of rounds that were added
+	 */
+	UFUNCTION(Category="Ammo Container", BlueprintCallable)
+	int32 AddRounds(TSubclassOf<class ATVRCartridge> CartridgeClass, int32 Num);
+
+	/**
+	 * @param CartridgeClass Type of the rounds
+	 * @returns true if rounds of this type may be stored in the container
+	 */
+	UFUNCTION(Category="Ammo Container", BlueprintPure)
+	bool IsAllowedCartridge(TSubclassOf<class ATVRCartridge> CartridgeClass) const;
+
+	/**
+	 * @returns the number of rounds of all types in the container
+	 */
+	UFUNCTION(Category="Ammo Container", BlueprintPure)
+	int32 GetRoundCount() const;
+
+	const TArray<FTVRAmmoCount>& GetContents() const { return Contents; }
+
+	/**
+	 * Finds a container whose volume contains a location
+	 * @param WorldContext Object in the world to search
+	 * @param Location World location
+	 * @returns the container, nullptr if there is none
+	 */
+	static UTVRAmmoContainerComponent* FindContainerAt(const UObject* WorldContext, const FVector& Location);
+
+	/** Called on all machines when the number of rounds changed */
+	UPROPERTY(Category="Ammo Container", BlueprintAssignable)
+	FOnAmmoContainerChanged EventOnContentsChanged;
+
+protected:
+	/**
+	 * Releases the grip on the container and hands out a cartridge instead. Called a tick after the grip, so the grip
+	 * is not modified while it is processed.
+	 * @param Hand Hand that gripped the container
+	 */
+	void HandOutCartridge(TWeakObjectPtr<class UGripMotionControllerComponent> Hand);
+
+	UFUNCTION()
+	void OnRep_Contents();
+
+	/** Rounds in the container, the last entry with rounds is handed out first */
+	UPROPERTY(Category="Ammo Container", EditAnywhere, ReplicatedUsing=OnRep_Contents)
+	TArray<FTVRAmmoCount> Contents;
+
+	/** Cartridge types that can be put into the container. All types are allowed if empty */
+	UPROPERTY(Category="Ammo Container", EditAnywhere)
+	TArray<TSubclassOf<class ATVRCartridge>> AllowedCartridges;
+
+	/** Max number of rounds of all types, 0 means unlimited */
+	UPROPERTY(Category="Ammo Container", EditAnywhere, meta=(ClampMin=0))
+	int32 Capacity;
+};
@@ -33,8 +33,25 @@ public:
 	UFUNCTION(Category = "Gun Haptics", BlueprintCallable, Unreliable, Client)
 	void ClientPistolKick(uint8 Strength, float Duration, ETVRLeftRight Type);
 
+	/**
+	 * Plays a buttstock kick. Plays it directly if the owning player controller is local, otherwise sends it to the
+	 * owning client.
+	 */
+	UFUNCTION(Category = "Gun Haptics", BlueprintCallable)
+	void PlayButtstockKick(uint8 Strength, float Duration);
+
+	/**
+	 * Plays a pistol grip kick. Plays it directly if the owning player controller is local, otherwise sends it to the
+	 * owning client.
+	 */
+	UFUNCTION(Category = "Gun Haptics", BlueprintCallable)
+	void PlayPistolKick(uint8 Strength, float Duration, ETVRLeftRight Type);
+
 	UFUNCTION(Category = "Gun Haptics", BlueprintCallable)
 	virtual class APlayerController* GetOwnerPlayerController() const;
+
+	/** True if the owning player controller is local, in that case no RPC is needed */
+	bool IsLocalOwner() const;
 	
 protected:
 	UFUNCTION(Category = "Gun Hapctics", BlueprintNativeEvent)
@@ -0,0 +1,80 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "InputCoreTypes.h"
+#include "TVRHapticsMixerComponent.generated.h"
+
+/**
+ * Mixes the controller haptics of all sources (trigger feel, kicks, ...) per hand.
+ * Sources submit requests with a priority, the mixer plays the strongest request of the highest priority and only
+ * sends it to the device once per frame and when it has changed. Lives on the local player controller.
+ */
+UCLASS(ClassGroup=(TacticalVR), meta=(BlueprintSpawnableComponent))
+class TACTICALVRCORE_API UTVRHapticsMixerComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UTVRHapticsMixerComponent(const FObjectInitializer& OI);
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/**
+	 * Finds the mixer of a player controller and creates one if it does not have one yet
+	 * @param PC A local player controller
+	 * @returns the haptics mixer of the player controller
+	 */
+	static UTVRHapticsMixerComponent* FindOrCreate(APlayerController* PC);
+
+	/**
+	 * Submits a haptic request. A request of the same source on the same hand is replaced.
+	 * @param Hand Hand to play the haptics on
+	 * @param Amplitude Amplitude between 0 and 1
+	 * @param Frequency Frequency between 0 and 1
+	 * @param Duration Duration in s, 0 means only for the next frame (for sources that submit every tick)
+	 * @param Priority Requests with a higher priority override lower ones
+	 * @param Source Name of the source, None never replaces other requests
+	 */
+	UFUNCTION(Category="Haptics", BlueprintCallable)
+	void SubmitHaptics(EControllerHand Hand, float Amplitude, float Frequency, float Duration = 0.f, uint8 Priority = 0, FName Source = NAME_None);
+
+	/**
+	 * Removes the request of a source
+	 * @param Hand Hand of the request
+	 * @param Source Name of the source
+	 */
+	UFUNCTION(Category="Haptics", BlueprintCallable)
+	void ClearHaptics(EControllerHand Hand, FName Source);
+
+protected:
+	struct FHapticRequest
+	{
+		FName Source;
+		float Amplitude;
+		float Frequency;
+		/** World time when the request ends, negative for requests that only last one frame */
+		float EndTime;
+		uint8 Priority;
+	};
+
+	struct FHapticChannel
+	{
+		EControllerHand Hand;
+		TArray<FHapticRequest, TInlineAllocator<4>> Requests;
+		float SubmittedAmplitude;
+		float SubmittedFrequency;
+	};
+
+	FHapticChannel& GetChannel(EControllerHand Hand);
+
+	/**
+	 * Mixes the requests of a channel and sends the result to the device if it has changed
+	 * @returns true if the channel is still active
+	 */
+	bool UpdateChannel(FHapticChannel& Channel, APlayerController* PC, float Now);
+
+	TArray<FHapticChannel, TInlineAllocator<2>> Channels;
+};
@@ -0,0 +1,119 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "TVRHitboxComponent.generated.h"
+
+UENUM(BlueprintType)
+enum class ETVRHitZone : uint8
+{
+	None,
+	Head,
+	Torso,
+	Arm,
+	Leg
+};
+
+/**
+ * A capsule that is attached to a bone and used for hit-scan hits
+ */
+USTRUCT(BlueprintType)
+struct TACTICALVRCORE_API FTVRHitboxCapsule
+{
+	GENERATED_BODY()
+
+	FTVRHitboxCapsule()
+	{
+		BoneName = NAME_None;
+		Start = FVector::ZeroVector;
+		End = FVector::ZeroVector;
+		Radius = 10.f;
+		Zone = ETVRHitZone::Torso;
+	}
+
+	/** Bone (or socket) the capsule follows */
+	UPROPERTY(Category="Hitbox", EditAnywhere, BlueprintReadWrite)
+	FName BoneName;
+
+	/** Start of the capsule segment in bone space */
+	UPROPERTY(Category="Hitbox", EditAnywhere, BlueprintReadWrite)
+	FVector Start;
+
+	/** End of the capsule segment in bone space */
+	UPROPERTY(Category="Hitbox", EditAnywhere, BlueprintReadWrite)
+	FVector End;
+
+	UPROPERTY(Category="Hitbox", EditAnywhere, BlueprintReadWrite, meta=(ClampMin=0.1f))
+	float Radius;
+
+	UPROPERTY(Category="Hitbox", EditAnywhere, BlueprintReadWrite)
+	ETVRHitZone Zone;
+};
+
+/**
+ * Registers a small set of bone attached capsules with the hitbox subsystem, so hit-scan shots can hit characters
+ * without per bone physics bodies. The hits report the hit zone, which can be used to scale damage.
+ * Bone transforms are read from the hitbox mesh, so make sure it keeps its pose updated on the server.
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class TACTICALVRCORE_API UTVRHitboxComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UTVRHitboxComponent(const FObjectInitializer& OI);
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/**
+	 * Sets the mesh the capsules follow. If it is not set, the first skeletal mesh of the owner will be used.
+	 * @param NewMesh Mesh with the bones of the hitboxes
+	 */
+	UFUNCTION(Category="Hitbox", BlueprintCallable)
+	void SetHitboxMesh(class USkinnedMeshComponent* NewMesh);
+
+	UFUNCTION(Category="Hitbox", BlueprintCallable)
+	class USkinnedMeshComponent* GetHitboxMesh() const { return HitboxMesh; }
+
+	const TArray<FTVRHitboxCapsule>& GetCapsules() const { return Capsules; }
+
+	class UPhysicalMaterial* GetPhysicalMaterial() const { return PhysicalMaterial; }
+
+	/**
+	 * @param Zone The hit zone
+	 * @returns the damage multiplier for this hit zone
+	 */
+	UFUNCTION(Category="Hitbox", BlueprintCallable)
+	float GetDamageMultiplier(ETVRHitZone Zone) const;
+
+	/**
+	 * @param Hit A hit that was generated by the hitbox subsystem
+	 * @returns the hit zone of the hit or None if it did not hit a hitbox
+	 */
+	UFUNCTION(Category="Hitbox", BlueprintCallable)
+	static ETVRHitZone GetHitZone(const FHitResult& Hit);
+
+protected:
+	UPROPERTY(Category="Hitbox", EditDefaultsOnly)
+	TArray<FTVRHitboxCapsule> Capsules;
+
+	UPROPERTY(Category="Hitbox", EditDefaultsOnly)
+	TMap<ETVRHitZone, float> DamageMultipliers;
+
+	/** Physical material reported for hits on the hitboxes (for impact effects) */
+	UPROPERTY(Category="Hitbox", EditDefaultsOnly)
+	class UPhysicalMaterial* PhysicalMaterial;
+
+	/**
+	 * If true, the primitives of the owner ignore the weapon trace channel, so the physics trace only needs to
+	 * consider world geometry and the hitboxes are the only way to hit this actor.
+	 */
+	UPROPERTY(Category="Hitbox", EditDefaultsOnly)
+	uint8 bIgnoreWeaponTraceChannel: 1;
+
+	UPROPERTY(Transient)
+	class USkinnedMeshComponent* HitboxMesh;
+};
@@ -0,0 +1,32 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "TVRPoolableInterface.generated.h"
+
+// This class does not need to be modified.
+UINTERFACE(BlueprintType)
+class UTVRPoolableInterface : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Reset contract for pooled actors and their components.
+ * Every implementer restores its own runtime state to the state it had after spawning, so a pooled actor can be
+ * reissued without spawning it again.
+ */
+class TACTICALVRCORE_API ITVRPoolableInterface
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Restores the state after spawning. Called when the owning actor returns to its pool.
+	 */
+	UFUNCTION(Category="Pooling", BlueprintCallable, BlueprintNativeEvent)
+	void ResetForPool();
+	virtual void ResetForPool_Implementation() {}
+};
@@ -0,0 +1,66 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TVRNetRelevancyPolicy.generated.h"
+
+/**
+ * Relevancy and dormancy policy shared by guns, magazines and cartridges.
+ * Held or holstered items follow the relevancy of the actor they are attached to or held by, while loose items are
+ * culled by distance and go fully net dormant while they are lying around untouched.
+ */
+USTRUCT(BlueprintType)
+struct TACTICALVRCORE_API FTVRNetRelevancyPolicy
+{
+	GENERATED_BODY()
+
+	FTVRNetRelevancyPolicy()
+	{
+		bFollowOwnerRelevancy = true;
+		bDormantWhenIdle = true;
+		LooseNetCullDistance = 5000.f;
+	}
+
+	/** If true, held or attached items are relevant whenever their attach parent or owner is relevant */
+	UPROPERTY(Category="Replication", EditDefaultsOnly)
+	bool bFollowOwnerRelevancy;
+
+	/** If true, loose items go fully net dormant once their physics went to sleep. Gripping or hitting wakes them. */
+	UPROPERTY(Category="Replication", EditDefaultsOnly)
+	bool bDormantWhenIdle;
+
+	/** Distance in cm up to which a loose item is relevant to a connection */
+	UPROPERTY(Category="Replication", EditDefaultsOnly, meta=(ClampMin=0.f))
+	float LooseNetCullDistance;
+
+	/**
+	 * Applies the static part of the policy (cull distance, initial dormancy) to the actor.
+	 * Should be called from BeginPlay.
+	 * @param Actor The actor the policy belongs to
+	 */
+	void Apply(AActor* Actor) const;
+
+	/**
+	 * Relevancy check that should be forwarded from AActor::IsNetRelevantFor
+	 * @returns true if the actor is relevant for the given viewer
+	 */
+	bool IsNetRelevantFor(const AActor* Actor, const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation) const;
+
+	/**
+	 * Wakes the actor from net dormancy. Only has an effect on the server.
+	 * @param Actor The actor the policy belongs to
+	 */
+	void Wake(AActor* Actor) const;
+
+	/**
+	 * Sends the actor to net dormancy if it is loose. Only has an effect on the server.
+	 * @param Actor The actor the policy belongs to
+	 */
+	void TrySleep(AActor* Actor) const;
+
+	/**
+	 * @returns true if the actor is neither held nor attached to anything
+	 */
+	static bool IsLoose(const AActor* Actor);
+};
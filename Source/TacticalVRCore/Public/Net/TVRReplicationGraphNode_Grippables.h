@@ -0,0 +1,32 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReplicationGraph.h"
+#include "TVRReplicationGraphNode_Grippables.generated.h"
+
+/**
+ * Replication graph node for TVR grippables (guns, magazines, cartridges).
+ * Projects using a replication graph can route these actors to this node. It asks each actor's relevancy policy
+ * (through IsNetRelevantFor) whether it should be gathered for a connection, so held items follow their owner and
+ * loose items are culled by distance. Dormancy is handled by the replication graph itself.
+ */
+UCLASS()
+class TACTICALVRCORE_API UTVRReplicationGraphNode_Grippables : public UReplicationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo) override;
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound = true) override;
+	virtual void NotifyResetAllNetworkActors() override;
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+protected:
+	/** All grippables routed to this node */
+	TArray<AActor*> GrippableActors;
+
+	/** Actors gathered for the connection that is currently processed */
+	FActorRepListRefView RelevantActorList;
+};
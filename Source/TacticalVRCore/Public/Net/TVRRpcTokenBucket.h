@@ -0,0 +1,48 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Simple token bucket to limit how often a client may call a server RPC.
+ * Tokens refill with a constant rate up to the burst size, every call consumes tokens.
+ */
+struct TACTICALVRCORE_API FTVRRpcTokenBucket
+{
+	FTVRRpcTokenBucket()
+		: Tokens(-1.f)
+		, LastRefillTime(0.f)
+	{}
+
+	/**
+	 * Refills the bucket and tries to consume tokens. The bucket starts full on first use.
+	 * @param Now Current time in s
+	 * @param RatePerSecond Tokens that are refilled per second
+	 * @param Burst Max number of tokens in the bucket
+	 * @param Cost Tokens needed for this call
+	 * @returns true if there were enough tokens and they have been consumed
+	 */
+	bool TryConsume(float Now, float RatePerSecond, float Burst, float Cost = 1.f)
+	{
+		if(Tokens < 0.f)
+		{
+			Tokens = Burst;
+		}
+		else
+		{
+			Tokens = FMath::Min(Burst, Tokens + FMath::Max(Now - LastRefillTime, 0.f) * RatePerSecond);
+		}
+		LastRefillTime = Now;
+		
+		if(Tokens < Cost)
+		{
+			return false;
+		}
+		Tokens -= Cost;
+		return true;
+	}
+
+	float Tokens;
+	float LastRefillTime;
+};
@@ -55,6 +55,8 @@ public:
 	FName SlotName;	
 };
 
+/** Native event for trigger axis samples. Carries the hand, the axis value and the platform time of the sample. */
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FTVRTriggerSampleEvent, EControllerHand, float, double);
 
 /**
  * Abstract base class for a Character. You should not be able to spawn an instance.
@@ -71,6 +73,14 @@ public:
 	 */
 	ATVRCharacter(const FObjectInitializer& OI);
 
+	/**
+	 * Event that is broadcast for every trigger axis sample received through OnTriggerAxisL/R.
+	 * Trigger components listen to this instead of polling the input axis each tick.
+	 * Axis bindings carry no device timestamp, so samples are stamped with the platform time at which the game thread
+	 * processes them. Latency before input processing, e.g. in the runtime or the driver, is not covered.
+	 */
+	FTVRTriggerSampleEvent OnTriggerAxisSample;
+
 	/**
 	 * @param OutLifetimeProps Reference to the replicated properties
      */
@@ -4,8 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "VRPlayerController.h"
+#include "Net/TVRRpcTokenBucket.h"
 #include "TVRPlayerController.generated.h"
 
+/** Event for gunfire that is too far away to be simulated in detail. */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FTVRDistantGunfireEvent, const FVector&, Location, TSubclassOf<AActor>, WeaponClass);
+
 /**
  * 
  */
@@ -26,4 +30,52 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Hapctics", BlueprintNativeEvent)
 	class UTVRGunHapticsComponent* GetGunHapticsComponent() const;
 	virtual class UTVRGunHapticsComponent* GetGunHapticsComponent_Implementation() const;
+
+	/**
+	 * Event called when a gun fired out of the detailed simulation range of this player, or when a gun in range fired
+	 * that does not exist on this client (e.g. not relevant). Use it to play cheap distant gunfire sounds.
+	 */
+	UPROPERTY(Category="Gun", BlueprintAssignable)
+	FTVRDistantGunfireEvent OnDistantGunfire;
+
+	/**
+	 * Interest managed fire event. Sent by the server to clients that are in range of the firing gun.
+	 * If the component does not resolve on this client, the event is passed on to OnDistantGunfire.
+	 * @param FiringComponent the component that has fired
+	 * @param Location location of the muzzle
+	 * @param WeaponClass class of the weapon that has fired
+	 */
+	UFUNCTION(Category="Gun", Unreliable, Client)
+	void ClientSimulateGunFire(class UTVRGunFireComponent* FiringComponent, FVector_NetQuantize Location, TSubclassOf<AActor> WeaponClass);
+	void ClientSimulateGunFire_Implementation(class UTVRGunFireComponent* FiringComponent, FVector_NetQuantize Location, TSubclassOf<AActor> WeaponClass);
+
+	/**
+	 * Interest managed hit event. Sent by the server to clients that are in range of the impact.
+	 * If the component does not resolve on this client, only the impact and fly-by are played.
+	 * @param FiringComponent the component that has fired
+	 * @param Hit the hit result of the shot
+	 * @param Cartridge the fired cartridge type
+	 */
+	UFUNCTION(Category="Gun", Unreliable, Client)
+	void ClientSimulateGunHit(class UTVRGunFireComponent* FiringComponent, const FHitResult& Hit, TSubclassOf<class ATVRCartridge> Cartridge);
+	void ClientSimulateGunHit_Implementation(class UTVRGunFireComponent* FiringComponent, const FHitResult& Hit, TSubclassOf<class ATVRCartridge> Cartridge);
+
+	/**
+	 * Aggregated event for gunfire far away from this player. Only carries location and weapon class.
+	 * @param Location location of the gunfire
+	 * @param WeaponClass class of the weapon that has fired
+	 */
+	UFUNCTION(Category="Gun", Unreliable, Client)
+	void ClientDistantGunfire(FVector_NetQuantize Location, TSubclassOf<AActor> WeaponClass);
+	void ClientDistantGunfire_Implementation(FVector_NetQuantize Location, TSubclassOf<AActor> WeaponClass);
+
+	/**
+	 * Rate limit for weapon server RPCs of this connection. Should only be used on the server.
+	 * @returns true if the RPC may be processed, false if it should be dropped
+	 */
+	bool ConsumeWeaponRpcToken();
+
+protected:
+	/** Token bucket that limits weapon server RPCs of this connection */
+	FTVRRpcTokenBucket WeaponRpcBucket;
 };
@@ -0,0 +1,162 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "TVRCoreWeaponSettings.generated.h"
+
+
+/**
+ * Project wide settings for the weapon systems (ballistics, effects, networking).
+ * Unlike the gameplay settings these are not meant to be changed by the player.
+ */
+UCLASS(Config = Game, DefaultConfig, meta=(DisplayName="Tactical VR Core Weapons"))
+class TACTICALVRCORE_API UTVRCoreWeaponSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+	UTVRCoreWeaponSettings(const FObjectInitializer& OI);
+
+public:
+	/** Fixed time step of the projectile simulation in s */
+	UPROPERTY(Category = "Ballistics", EditAnywhere, Config, meta=(ClampMin=0.001f))
+	float ProjectileFixedStep;
+
+	/** Max simulation steps per frame. Remaining time is dropped to prevent the simulation from spiraling after hitches */
+	UPROPERTY(Category = "Ballistics", EditAnywhere, Config, meta=(ClampMin=1))
+	int32 MaxProjectileStepsPerFrame;
+
+	/** Number of projectiles that are processed by one parallel task */
+	UPROPERTY(Category = "Ballistics", EditAnywhere, Config, meta=(ClampMin=1))
+	int32 ProjectileBatchSize;
+
+	/** Max number of projectiles in flight. New projectiles are rejected when the limit is reached */
+	UPROPERTY(Category = "Ballistics", EditAnywhere, Config, meta=(ClampMin=1))
+	int32 MaxProjectiles;
+
+	/**
+	 * If true, all point damage a victim receives from weapons in one frame is applied as one aggregated event
+	 * (see FTVRAggregatedDamageEvent), so reactions run once per shell or burst instead of once per pellet.
+	 */
+	UPROPERTY(Category = "Damage", EditAnywhere, Config)
+	bool bAggregateDamage;
+
+	/** Max number of impact decals in the world. When the limit is reached the oldest decal is reused */
+	UPROPERTY(Category = "Effects", EditAnywhere, Config, meta=(ClampMin=1))
+	int32 MaxImpactDecals;
+
+	/** Max number of impact effects (particle and decal) that are spawned per frame */
+	UPROPERTY(Category = "Effects", EditAnywhere, Config, meta=(ClampMin=1))
+	int32 MaxImpactEffectsPerFrame;
+
+	/** Impacts closer than this distance in cm to a recent impact are merged into it */
+	UPROPERTY(Category = "Effects", EditAnywhere, Config, meta=(ClampMin=0.f))
+	float ImpactMergeRadius;
+
+	/** Time in s in which impacts can be merged */
+	UPROPERTY(Category = "Effects", EditAnywhere, Config, meta=(ClampMin=0.f))
+	float ImpactMergeTime;
+
+	/** Impacts further away from all local views than this distance in cm do not spawn effects */
+	UPROPERTY(Category = "Effects", EditAnywhere, Config, meta=(ClampMin=0.f))
+	float MaxImpactEffectDistance;
+
+	/** Screen size at which impact decals fade out */
+	UPROPERTY(Category = "Effects", EditAnywhere, Config, meta=(ClampMin=0.f))
+	float ImpactDecalFadeScreenSize;
+
+	/** Cheap impact particle used while the impact effects of a cartridge are still loading */
+	UPROPERTY(Category = "Effects", EditAnywhere, Config)
+	TSoftObjectPtr<class UParticleSystem> FallbackImpactParticle;
+
+	/** Cheap impact decal used while the impact effects of a cartridge are still loading */
+	UPROPERTY(Category = "Effects", EditAnywhere, Config)
+	TSoftObjectPtr<class UMaterialInterface> FallbackImpactDecal;
+
+	/** Impact sound used while the impact effects of a cartridge are still loading */
+	UPROPERTY(Category = "Effects", EditAnywhere, Config)
+	TSoftObjectPtr<class USoundBase> FallbackImpactSound;
+
+	/** Max number of pooled voices for impact sounds (bullet impacts, casings) */
+	UPROPERTY(Category = "Audio", EditAnywhere, Config, meta=(ClampMin=1))
+	int32 MaxImpactVoices;
+
+	/** Max number of impact voices that play sounds of the same surface type at once */
+	UPROPERTY(Category = "Audio", EditAnywhere, Config, meta=(ClampMin=1))
+	int32 MaxImpactVoicesPerSurface;
+
+	/** Impact sounds further away from all listeners than this distance in cm are not played */
+	UPROPERTY(Category = "Audio", EditAnywhere, Config, meta=(ClampMin=0.f))
+	float MaxImpactAudioDistance;
+
+	/** Min time in s between two hit sounds of the same cartridge (casings bouncing on the floor) */
+	UPROPERTY(Category = "Audio", EditAnywhere, Config, meta=(ClampMin=0.f))
+	float CasingClinkMinInterval;
+
+	/** Priority of casing sounds relative to bullet impacts of the same loudness */
+	UPROPERTY(Category = "Audio", EditAnywhere, Config, meta=(ClampMin=0.f))
+	float CasingClinkPriorityScale;
+
+	/** Max number of bullet fly-by sounds a local listener hears per frame */
+	UPROPERTY(Category = "Audio", EditAnywhere, Config, meta=(ClampMin=1))
+	int32 MaxFlyBysPerListener;
+
+	/** Weapon server RPCs (start fire, hit reports) a single connection may send per second */
+	UPROPERTY(Category = "Network|Validation", EditAnywhere, Config, meta=(ClampMin=1.f))
+	float MaxWeaponRpcsPerSecond;
+
+	/** Weapon server RPCs a single connection may send in a burst */
+	UPROPERTY(Category = "Network|Validation", EditAnywhere, Config, meta=(ClampMin=1.f))
+	float WeaponRpcBurst;
+
+	/** If true, hits reported by clients are checked against the fire cadence, ammo and range of the gun on the server */
+	UPROPERTY(Category = "Network|Validation", EditAnywhere, Config)
+	bool bValidateClientHits;
+
+	/** Number of shots a client may report hits for ahead of the server's fire cadence (latency, hitches) */
+	UPROPERTY(Category = "Network|Validation", EditAnywhere, Config, meta=(ClampMin=1.f))
+	float HitReportBurstShots;
+
+	/** Time in s a hit report may arrive after the server has fired the last shot */
+	UPROPERTY(Category = "Network|Validation", EditAnywhere, Config, meta=(ClampMin=0.f))
+	float HitReportDelayTolerance;
+
+	/** Additional distance in cm a reported hit may be away from the muzzle beyond the range of the cartridge */
+	UPROPERTY(Category = "Network|Validation", EditAnywhere, Config, meta=(ClampMin=0.f))
+	float HitReportDistanceTolerance;
+
+	/**
+	 * If true, the heavy part of a gun's initialization (attachments, starting magazine, casing pool) is spread over
+	 * several frames instead of running in BeginPlay. Guns closest to players are initialized first.
+	 */
+	UPROPERTY(Category = "Streaming", EditAnywhere, Config)
+	bool bTimeSliceGunWarmup;
+
+	/** Time in ms per frame that may be spent on warming up guns */
+	UPROPERTY(Category = "Streaming", EditAnywhere, Config, meta=(ClampMin=0.1f, EditCondition="bTimeSliceGunWarmup"))
+	float GunWarmupBudgetMs;
+
+	/** Max number of guns of the same class that are kept in the gun pool, released guns beyond that are destroyed */
+	UPROPERTY(Category = "Streaming", EditAnywhere, Config, meta=(ClampMin=0))
+	int32 MaxPooledGunsPerClass;
+
+	/** Distance in cm between a hand and a weapon proxy at which the real weapon is spawned */
+	UPROPERTY(Category = "Streaming", EditAnywhere, Config, meta=(ClampMin=0.f))
+	float ProxyHydrateRadius;
+
+	/** Time in s a hydrated weapon has to be left alone before it is replaced by a proxy again */
+	UPROPERTY(Category = "Streaming", EditAnywhere, Config, meta=(ClampMin=0.f))
+	float ProxyDehydrateDelay;
+
+	/** Max number of dropped magazines in the world, the oldest and farthest ones beyond that are recycled */
+	UPROPERTY(Category = "Streaming", EditAnywhere, Config, meta=(ClampMin=0))
+	int32 MaxLooseMagazines;
+
+	/** Max number of recycled magazines of the same class that are kept for reuse, more are destroyed */
+	UPROPERTY(Category = "Streaming", EditAnywhere, Config, meta=(ClampMin=0))
+	int32 MaxRecycledMagazinesPerClass;
+
+	UFUNCTION(Category = "Settings", BlueprintCallable, BlueprintPure, meta=(DisplayName="Get Tactical VR Core Weapon Settings"))
+	static UTVRCoreWeaponSettings* Get();
+};
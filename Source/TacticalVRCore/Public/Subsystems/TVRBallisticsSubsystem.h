@@ -0,0 +1,115 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "TVRBallisticsSubsystem.generated.h"
+
+/** Actor ids that a projectile trace ignores (usually the firing gun and its parent). */
+typedef TArray<uint32, TInlineAllocator<2>> FTVRProjectileIgnoreList;
+
+/**
+ * Parameters to launch a projectile into the ballistics simulation
+ */
+struct TACTICALVRCORE_API FTVRProjectileLaunchParams
+{
+	FTVRProjectileLaunchParams()
+		: Origin(FVector::ZeroVector)
+		, Velocity(FVector::ZeroVector)
+		, DragCoefficient(0.f)
+		, GravityScale(1.f)
+		, LifeTime(5.f)
+		, Cartridge(nullptr)
+	{}
+	
+	/** Start location in world space */
+	FVector Origin;
+	/** Start velocity in cm/s */
+	FVector Velocity;
+	/** Quadratic drag coefficient */
+	float DragCoefficient;
+	/** Multiplier for the world gravity */
+	float GravityScale;
+	/** Time in s until the projectile is removed */
+	float LifeTime;
+	/** Component that fired the projectile and that will receive the hit */
+	TWeakObjectPtr<class UTVRGunFireComponent> FiringComponent;
+	/** Fired cartridge type */
+	TSubclassOf<class ATVRCartridge> Cartridge;
+	/** Actors that are ignored by the projectile traces */
+	FTVRProjectileIgnoreList IgnoredActors;
+	/** Character that fired the projectile, its hitboxes are ignored */
+	TWeakObjectPtr<const AActor> Shooter;
+};
+
+/**
+ * Simulates projectiles as plain data instead of actors.
+ * All projectiles are stored as structure of arrays and advanced with a fixed time step. Integration and the swept
+ * segment traces run in parallel batches, while hits are routed back to the firing component on the game thread.
+ * Characters with a UTVRHitboxComponent do not block the weapon trace channel, so every step also tests the hitboxes.
+ */
+UCLASS()
+class TACTICALVRCORE_API UTVRBallisticsSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UTVRBallisticsSubsystem();
+	
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Conditional; }
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+	/**
+	 * Adds a new projectile to the simulation
+	 * @param Params Launch parameters of the projectile
+	 * @returns true if the projectile was added, false if the projectile limit is reached
+	 */
+	bool LaunchProjectile(const FTVRProjectileLaunchParams& Params);
+
+	/**
+	 * @returns the number of projectiles currently in flight
+	 */
+	int32 GetNumProjectiles() const { return Positions.Num(); }
+
+protected:
+	/**
+	 * Advances all projectiles by one fixed step and processes their hits
+	 * @param StepTime time of the step in s
+	 */
+	void StepSimulation(float StepTime);
+
+	/**
+	 * Removes a projectile by swapping the last one into its place
+	 * @param Index index of the projectile
+	 */
+	void RemoveProjectileAtSwap(int32 Index);
+
+	/** Time that has not been simulated yet */
+	float TimeAccumulator;
+
+	// Projectile data, all arrays share the same index
+	TArray<FVector> Positions;
+	TArray<FVector> Velocities;
+	TArray<float> DragCoefficients;
+	TArray<float> GravityScales;
+	TArray<float> LifeTimes;
+	TArray<TWeakObjectPtr<class UTVRGunFireComponent>> FiringComponents;
+	TArray<TSubclassOf<class ATVRCartridge>> Cartridges;
+	TArray<FTVRProjectileIgnoreList> IgnoredActors;
+	TArray<TWeakObjectPtr<const AActor>> Shooters;
+
+	/** Shooters resolved on the game thread before each step, so the batches do not touch weak pointers */
+	TArray<const AActor*> StepShooters;
+
+	// Per step results, written by the parallel batches
+	TArray<FHitResult> StepHits;
+	TArray<uint8> StepFlags;
+};
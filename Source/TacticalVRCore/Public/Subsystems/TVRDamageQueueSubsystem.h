@@ -0,0 +1,113 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "TVRDamageQueueSubsystem.generated.h"
+
+/**
+ * A single hit that contributed to an aggregated damage event
+ */
+struct TACTICALVRCORE_API FTVRDamageHit
+{
+	FTVRDamageHit()
+		: Damage(0.f)
+		, ShotDirection(FVector::ZeroVector)
+	{}
+	
+	float Damage;
+	FVector ShotDirection;
+	FHitResult Hit;
+};
+
+/**
+ * Point damage event that carries all hits a victim received from one causer in one frame or one held sequence
+ * (e.g. all pellets of a buckshot shell).
+ * It is a point damage event, so TakeDamage and the point damage events still work and report the strongest hit.
+ * Use IsOfType(FTVRAggregatedDamageEvent::ClassID) in TakeDamage to access the per hit detail.
+ */
+struct TACTICALVRCORE_API FTVRAggregatedDamageEvent : public FPointDamageEvent
+{
+	FTVRAggregatedDamageEvent() {}
+
+	/** All hits of this event, Damage of the event is the sum of their damage */
+	TArray<FTVRDamageHit> Hits;
+
+	/** ID for this class. NOTE this must be unique for all damage events. */
+	static const int32 ClassID = 0x54565244;
+
+	virtual int32 GetTypeID() const override { return FTVRAggregatedDamageEvent::ClassID; }
+	virtual bool IsOfType(int32 InID) const override { return (FTVRAggregatedDamageEvent::ClassID == InID) || FPointDamageEvent::IsOfType(InID); }
+};
+
+/**
+ * Collects the point damage of all weapons and applies it once per victim, causer and frame.
+ * A causer can hold its damage over several frames (e.g. a buckshot shell that is traced over multiple frames), so all
+ * of it arrives in one event. The first queued hit defines the instigator and damage type of the aggregated event.
+ */
+UCLASS()
+class TACTICALVRCORE_API UTVRDamageQueueSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Conditional; }
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+	/**
+	 * Queues point damage for the victim. If aggregation is disabled in the weapon settings the damage is applied
+	 * immediately.
+	 * @param Victim The actor that was hit
+	 * @param Damage Damage of this hit
+	 * @param ShotDirection Direction of the shot
+	 * @param Hit The hit against the victim
+	 * @param EventInstigator Controller that was responsible for the damage
+	 * @param DamageCauser Actor that actually caused the damage (e.g. the gun)
+	 * @param DamageTypeClass Type of the damage
+	 */
+	void QueuePointDamage(AActor* Victim, float Damage, const FVector& ShotDirection, const FHitResult& Hit,
+		AController* EventInstigator, AActor* DamageCauser, TSubclassOf<UDamageType> DamageTypeClass);
+
+	/**
+	 * Keeps the damage of a causer queued until ReleaseDamage is called
+	 * @param DamageCauser The causer whose damage is held
+	 */
+	void HoldDamage(AActor* DamageCauser);
+
+	/**
+	 * Allows the held damage of a causer to be applied with the next flush
+	 * @param DamageCauser The causer whose damage was held
+	 */
+	void ReleaseDamage(AActor* DamageCauser);
+
+	/**
+	 * Applies all queued damage
+	 */
+	void Flush();
+
+protected:
+	struct FPendingDamage
+	{
+		TWeakObjectPtr<AActor> Victim;
+		TWeakObjectPtr<AController> EventInstigator;
+		TWeakObjectPtr<AActor> DamageCauser;
+		FTVRAggregatedDamageEvent Event;
+	};
+
+	/** @returns true if the damage of the causer has to stay queued */
+	bool IsDamageHeld(AActor* DamageCauser) const;
+
+	TArray<FPendingDamage> PendingDamage;
+
+	/** Causers that hold their damage and the number of holds */
+	TMap<TWeakObjectPtr<AActor>, int32> HeldCausers;
+};
@@ -0,0 +1,55 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TVRFXPreloadSubsystem.generated.h"
+
+/**
+ * Loads the effect assets (impact particles, decals and sounds) of cartridges asynchronously.
+ * Cartridges only soft reference their effects, so a bundle is requested once a gun or cartridge using them becomes
+ * relevant and is kept loaded for the lifetime of the world. Until a bundle arrived the fallback effects of the
+ * weapon settings are used. Nothing is loaded on dedicated servers.
+ */
+UCLASS()
+class TACTICALVRCORE_API UTVRFXPreloadSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/**
+	 * Requests the effect bundle of a cartridge class, if it was not requested already
+	 * @param Cartridge Class of the cartridge
+	 */
+	void RequestCartridgeFX(TSubclassOf<class ATVRCartridge> Cartridge);
+
+	/**
+	 * Requests the effect bundles of all cartridges a gun can fire
+	 * @param Gun The gun
+	 */
+	void RequestGunFX(const class ATVRGunBase* Gun);
+
+	/**
+	 * @param Cartridge Class of the cartridge
+	 * @returns true if the effect bundle of the cartridge finished loading
+	 */
+	bool IsCartridgeFXLoaded(TSubclassOf<class ATVRCartridge> Cartridge) const;
+
+protected:
+	/**
+	 * @returns true if effects are needed in this world
+	 */
+	bool ShouldLoadFX() const;
+
+	FStreamableManager StreamableManager;
+
+	/** Handles keep the loaded bundles in memory */
+	TMap<UClass*, TSharedPtr<FStreamableHandle>> CartridgeHandles;
+
+	TSharedPtr<FStreamableHandle> FallbackHandle;
+};
@@ -0,0 +1,71 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "TVRFlyBySubsystem.generated.h"
+
+/**
+ * Plays the fly-by sounds of bullets for all local listeners.
+ * The shot segments of a frame are collected and tested against every local listener at the end of the frame. Each
+ * listener hears at most MaxFlyBysPerListener of the closest fly-bys, one per shooter and cartridge type, so a
+ * buckshot shell or several guns firing at once can't flood the audio.
+ */
+UCLASS()
+class TACTICALVRCORE_API UTVRFlyBySubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Conditional; }
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+	/**
+	 * Adds the segment of a shot that will be tested for fly-bys in this frame
+	 * @param Start Start of the segment
+	 * @param End End of the segment (impact point)
+	 * @param Cartridge Cartridge that was fired, it defines the fly-by sound and distance
+	 * @param Shooter Pawn that fired the shot, it does not hear its own fly-bys
+	 */
+	void AddShotSegment(const FVector& Start, const FVector& End, TSubclassOf<class ATVRCartridge> Cartridge, const AActor* Shooter);
+
+protected:
+	struct FShotSegment
+	{
+		FVector Start;
+		FVector End;
+		TSubclassOf<class ATVRCartridge> Cartridge;
+		TWeakObjectPtr<const AActor> Shooter;
+	};
+
+	struct FFlyByCandidate
+	{
+		float DistSq;
+		FVector Location;
+		int32 Segment;
+	};
+
+	struct FListener
+	{
+		FVector Location;
+		TWeakObjectPtr<AActor> Pawn;
+	};
+
+	/**
+	 * Collects the listener locations of all local players
+	 */
+	void GatherListeners(TArray<FListener>& OutListeners) const;
+
+	TArray<FShotSegment> PendingSegments;
+
+	/** Reused between frames */
+	TArray<FFlyByCandidate> Candidates;
+};
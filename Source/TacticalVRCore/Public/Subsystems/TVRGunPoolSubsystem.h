@@ -0,0 +1,41 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TVRGunPoolSubsystem.generated.h"
+
+/**
+ * Keeps released guns for reuse, so respawning loadouts does not spawn whole weapon actor trees again.
+ * Released guns are reset to their spawn state (see ITVRPoolableInterface) and hidden until they are acquired again.
+ * Only used on the authority, the pooled state is replicated by the guns themselves.
+ */
+UCLASS()
+class TACTICALVRCORE_API UTVRGunPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/**
+	 * Gets a gun from the pool or spawns a new one if there is none of this class
+	 * @param GunClass Class of the gun
+	 * @param Transform World transform of the gun
+	 * @param NewOwner Owner of the gun
+	 * @returns the gun, nullptr if called on a client
+	 */
+	UFUNCTION(Category="Gun Pool", BlueprintCallable)
+	class ATVRGunBase* AcquireGun(TSubclassOf<class ATVRGunBase> GunClass, const FTransform& Transform, AActor* NewOwner = nullptr);
+
+	/**
+	 * Resets a gun and returns it to the pool. Destroys it if the pool of its class is full.
+	 * @param Gun Gun to release
+	 */
+	UFUNCTION(Category="Gun Pool", BlueprintCallable)
+	void ReleaseGun(class ATVRGunBase* Gun);
+
+protected:
+	TMap<UClass*, TArray<TWeakObjectPtr<class ATVRGunBase>>> PooledGuns;
+};
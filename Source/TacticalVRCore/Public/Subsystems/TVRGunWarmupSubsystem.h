@@ -0,0 +1,43 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "TVRGunWarmupSubsystem.generated.h"
+
+/**
+ * Spreads the initialization of guns over several frames.
+ * Guns that spawn or stream in register here during BeginPlay and are warmed up step by step within a per frame time
+ * budget, closest to a player first. A gun that is needed right away (e.g. gripped) completes its warm-up itself.
+ */
+UCLASS()
+class TACTICALVRCORE_API UTVRGunWarmupSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Conditional; }
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+	/**
+	 * Queues a gun for warm-up
+	 * @param Gun Gun that has a pending warm-up
+	 */
+	void RegisterGun(class ATVRGunBase* Gun);
+
+protected:
+	/**
+	 * Sorts the pending guns by their distance to the closest player, closest last
+	 */
+	void SortPendingGuns();
+
+	TArray<TWeakObjectPtr<class ATVRGunBase>> PendingGuns;
+};
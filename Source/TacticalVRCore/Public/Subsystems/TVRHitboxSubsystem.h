@@ -0,0 +1,104 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TVRHitboxSubsystem.generated.h"
+
+/**
+ * Broadphase for character hitboxes.
+ * All registered hitbox capsules are transformed to world space and sorted into a BVH once per frame (on the first
+ * query). Rays are tested against four capsules at once with a SIMD segment distance test, only candidates are
+ * intersected exactly.
+ */
+UCLASS()
+class TACTICALVRCORE_API UTVRHitboxSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UTVRHitboxSubsystem();
+
+	virtual void Deinitialize() override;
+
+	void RegisterHitboxes(class UTVRHitboxComponent* HitboxComp);
+	void UnregisterHitboxes(class UTVRHitboxComponent* HitboxComp);
+
+	/**
+	 * @returns true if there are any hitboxes in the world
+	 */
+	bool HasHitboxes() const { return HitboxComponents.Num() > 0; }
+
+	/**
+	 * Brings the hitboxes up to date for this frame. Afterwards RaycastHitboxes only reads, so it can be called from
+	 * worker threads until the next frame.
+	 */
+	void PrepareQueries() { UpdateHitboxes(); }
+
+	/**
+	 * Finds the closest hitbox along a segment. Segments that start inside of a hitbox do not hit it.
+	 * @param OutHit The hit result, the capsule index is stored in MyItem
+	 * @param Start Start of the segment
+	 * @param End End of the segment
+	 * @param QueryParams Query params of the trace, only the ignored actors are respected
+	 * @param Shooter Character that fired the shot, its hitboxes are ignored
+	 * @returns true if a hitbox was hit
+	 */
+	bool RaycastHitboxes(FHitResult& OutHit, const FVector& Start, const FVector& End, const FCollisionQueryParams& QueryParams,
+		const AActor* Shooter = nullptr);
+
+protected:
+	/** A hitbox capsule in world space */
+	struct FWorldCapsule
+	{
+		FVector A;
+		FVector B;
+		float Radius;
+		int32 ComponentIndex;
+		int32 CapsuleIndex;
+	};
+
+	/** Four capsules as structure of arrays, so they can be tested at once */
+	struct alignas(16) FCapsuleLeaf
+	{
+		float Ax[4];
+		float Ay[4];
+		float Az[4];
+		float Bx[4];
+		float By[4];
+		float Bz[4];
+		float RadiusSq[4];
+		int32 Capsule[4];
+	};
+
+	struct FBVHNode
+	{
+		FBox Bounds;
+		int32 Left;
+		int32 Right;
+		int32 Leaf;
+	};
+
+	/** Rebuilds the world capsules and the BVH if that did not happen in this frame yet */
+	void UpdateHitboxes();
+
+	/**
+	 * Recursively builds the BVH over SortedCapsules
+	 * @param First first index in SortedCapsules
+	 * @param Num number of capsules of this node
+	 * @returns the index of the node
+	 */
+	int32 BuildNode(int32 First, int32 Num);
+
+	UPROPERTY(Transient)
+	TArray<class UTVRHitboxComponent*> HitboxComponents;
+
+	TArray<FWorldCapsule> WorldCapsules;
+	TArray<int32> SortedCapsules;
+	TArray<FBVHNode> Nodes;
+	TArray<FCapsuleLeaf> Leaves;
+
+	/** Frame number of the last update */
+	uint64 LastUpdateFrame;
+};
@@ -0,0 +1,70 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TVRImpactAudioSubsystem.generated.h"
+
+/**
+ * Small pool of audio components for short impact sounds (bullet impacts, casing clinks).
+ * The number of voices is capped in total and per surface type. Sounds that are too far away from the listeners are
+ * culled, when no voice is free the voice with the lowest priority is taken over if the new sound is more important.
+ * The priority of a sound is its volume scaled by its proximity to the closest listener and fades out with its age.
+ */
+UCLASS()
+class TACTICALVRCORE_API UTVRImpactAudioSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/**
+	 * Plays an impact sound on a pooled voice.
+	 * @param Sound The sound to play, the surface type is passed as int parameter "SurfaceType"
+	 * @param Location Location of the impact
+	 * @param SurfaceType Surface that was hit
+	 * @param Volume Volume multiplier of the sound
+	 * @param Attenuation Attenuation override, uses the attenuation of the sound if null
+	 * @param PriorityScale Scales the priority of the sound, e.g. to prefer bullet impacts over casings
+	 * @returns true if the sound is played
+	 */
+	bool PlayImpactSound(USoundBase* Sound, const FVector& Location, EPhysicalSurface SurfaceType, float Volume = 1.f,
+		class USoundAttenuation* Attenuation = nullptr, float PriorityScale = 1.f);
+
+protected:
+	struct FVoiceState
+	{
+		float Priority;
+		float StartTime;
+		EPhysicalSurface SurfaceType;
+	};
+
+	/**
+	 * @param Location Location of the sound
+	 * @returns the distance of the closest local listener or a negative value if there is none
+	 */
+	float GetClosestListenerDistance(const FVector& Location) const;
+
+	/**
+	 * @returns the priority of the voice, decayed by its age
+	 */
+	float GetEffectivePriority(int32 VoiceIdx, float Now) const;
+
+	/**
+	 * Finds the voice that should play a new sound
+	 * @param SurfaceType Surface of the new sound
+	 * @param Priority Priority of the new sound
+	 * @param Now Current world time
+	 * @returns the index of the voice or INDEX_NONE if the sound should not be played
+	 */
+	int32 FindVoice(EPhysicalSurface SurfaceType, float Priority, float Now);
+
+	UPROPERTY(Transient)
+	TArray<class UAudioComponent*> Voices;
+
+	/** State of the voice with the same index */
+	TArray<FVoiceState> VoiceStates;
+};
@@ -0,0 +1,95 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "Weapon/TVRCartridge.h"
+#include "TVRImpactFXSubsystem.generated.h"
+
+/**
+ * Spawns the impact particles and decals of all weapons.
+ * Impacts are queued and spawned with a per frame budget. Impacts close to an impact of the last moments are merged
+ * into one effect and impacts far away from all local views are culled. Decals are kept in a fixed size ring buffer,
+ * so when it is full the oldest decal is moved to the new impact instead of creating a new component.
+ */
+UCLASS()
+class TACTICALVRCORE_API UTVRImpactFXSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UTVRImpactFXSubsystem();
+
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Conditional; }
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+	/**
+	 * Queues the impact effects of a cartridge for the hit.
+	 * @param Hit The hit of the bullet
+	 * @param CartridgeCDO Default object of the cartridge, which defines the effects per surface
+	 */
+	void AddImpact(const FHitResult& Hit, const ATVRCartridge* CartridgeCDO);
+
+	/**
+	 * Removes all impact decals
+	 */
+	void ClearDecals();
+
+protected:
+	struct FPendingImpact
+	{
+		FVector Location;
+		FVector Normal;
+		FVector TraceDir;
+		TWeakObjectPtr<USceneComponent> HitComponent;
+		FName BoneName;
+		FImpactParticleData Particle;
+		FImpactDecalData Decal;
+		float Time;
+	};
+
+	struct FRecentImpact
+	{
+		FVector Location;
+		float Time;
+	};
+
+	/**
+	 * @param Location Location of the impact
+	 * @returns true if the impact is close enough to a local view to be visible
+	 */
+	bool IsInViewRange(const FVector& Location);
+
+	/**
+	 * @param Location Location of the impact
+	 * @param Now Current world time
+	 * @returns true if there has been an impact close to the location a moment ago
+	 */
+	bool IsMergedWithRecentImpact(const FVector& Location, float Now);
+
+	void SpawnImpactParticle(const FPendingImpact& Impact);
+	void SpawnImpactDecal(const FPendingImpact& Impact);
+
+	TArray<FPendingImpact> PendingImpacts;
+
+	/** Impacts that have been queued recently, used to merge impacts */
+	TArray<FRecentImpact> RecentImpacts;
+
+	/** Ring buffer of the impact decals */
+	TArray<TWeakObjectPtr<class UDecalComponent>> Decals;
+
+	/** Index of the next decal slot in the ring buffer */
+	int32 NextDecal;
+
+	/** Local view locations, updated once per frame */
+	TArray<FVector> ViewLocations;
+	uint64 ViewLocationsFrame;
+};
@@ -0,0 +1,69 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TVRMagazineSubsystem.generated.h"
+
+/**
+ * Keeps the number of loose magazines in a world bounded.
+ * Magazines that are dropped or ejected register as loose. Once there are more than MaxLooseMagazines, the oldest
+ * magazine farthest from any player is evicted and kept hidden for reuse, so mag wells that spawn a magazine take an
+ * evicted one instead of spawning a new actor.
+ */
+UCLASS()
+class TACTICALVRCORE_API UTVRMagazineSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/**
+	 * Gets an evicted magazine of a class or spawns a new one if there is none
+	 * @param MagazineClass Class of the magazine
+	 * @param Transform World transform of the magazine
+	 * @returns the magazine
+	 */
+	UFUNCTION(Category="Magazine Manager", BlueprintCallable)
+	class ATVRMagazine* AcquireMagazine(TSubclassOf<class ATVRMagazine> MagazineClass, const FTransform& Transform);
+
+	/**
+	 * Tracks a magazine that is lying around. May evict another loose magazine.
+	 * @param Magazine Magazine that was dropped or ejected
+	 */
+	void RegisterLooseMagazine(class ATVRMagazine* Magazine);
+
+	/**
+	 * Stops tracking a magazine, e.g. because it was gripped
+	 * @param Magazine Magazine that is not loose anymore
+	 */
+	void UnregisterLooseMagazine(class ATVRMagazine* Magazine);
+
+	/**
+	 * Takes back a magazine that is not needed anymore, e.g. the magazine of a gun that returns to its pool.
+	 * The magazine is detached and kept for reuse like an evicted one.
+	 * @param Magazine Magazine to take back
+	 */
+	void ReleaseMagazine(class ATVRMagazine* Magazine);
+
+	int32 GetNumLooseMagazines() const { return LooseMagazines.Num(); }
+
+protected:
+	/**
+	 * Evicts the loose magazine with the highest age times distance to the closest player
+	 */
+	void EvictMagazine();
+
+	/**
+	 * Hides a magazine and keeps it for reuse, destroys it if there are enough magazines of its class already
+	 * @param Magazine Magazine to recycle
+	 */
+	void RecycleMagazine(class ATVRMagazine* Magazine);
+
+	/** Loose magazines and the world time they became loose */
+	TArray<TPair<TWeakObjectPtr<class ATVRMagazine>, float>> LooseMagazines;
+
+	TMap<UClass*, TArray<TWeakObjectPtr<class ATVRMagazine>>> RecycledMagazines;
+};
@@ -0,0 +1,138 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "TVRWeaponProxySubsystem.generated.h"
+
+/**
+ * Server side state of a dehydrated weapon, restored when it is hydrated again
+ */
+USTRUCT()
+struct FTVRWeaponProxyState
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TSubclassOf<AActor> ActorClass;
+
+	UPROPERTY()
+	FTransform Transform;
+
+	/** Rounds in the magazine, -1 keeps the default of the class */
+	UPROPERTY()
+	int32 Ammo;
+
+	/** Magazine inserted in the mag well of a gun, nullptr if the gun has none */
+	UPROPERTY()
+	TSubclassOf<class ATVRMagazine> MagazineClass;
+
+	/** Round in the chamber of a gun */
+	UPROPERTY()
+	TSubclassOf<class ATVRCartridge> ChamberedRound;
+
+	/** Attachment classes of a gun, in the order of its attachment points */
+	UPROPERTY()
+	TArray<TSubclassOf<class ATVRWeaponAttachment>> Attachments;
+
+	UPROPERTY()
+	uint8 ColorVariant;
+
+	UPROPERTY()
+	bool bSimulatePhysics;
+
+	/** True if a gun still has the magazine and ammo of its class, e.g. because its warm-up never ran */
+	UPROPERTY()
+	bool bDefaultLoadout;
+
+	FTVRWeaponProxyState() : Ammo(-1), ColorVariant(0), bSimulatePhysics(false), bDefaultLoadout(false) {}
+};
+
+/**
+ * Replaces placed guns and magazines that nobody interacts with by lightweight proxies.
+ * A dehydrated weapon is only an instance in the ATVRWeaponProxyActor of the level, until a hand of any player comes
+ * into grip range and the real actor is spawned again with its ammo and attachment state. Hydrated weapons that are
+ * left alone for a while are dehydrated again.
+ * Only runs on the authority, clients only see the replicated proxy actor and the replicated weapons.
+ */
+UCLASS()
+class TACTICALVRCORE_API UTVRWeaponProxySubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Conditional; }
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+	/**
+	 * Replaces a gun or magazine by a proxy and destroys it. Only works on the authority and for weapons that are
+	 * not held or attached to anything.
+	 * @param Weapon Gun or magazine to dehydrate
+	 * @returns true if the weapon was replaced
+	 */
+	UFUNCTION(Category="Weapon Proxy", BlueprintCallable)
+	bool Dehydrate(AActor* Weapon);
+
+	/**
+	 * Hydrates the proxy closest to a location, e.g. when game code needs the real weapon.
+	 * @param Location World location to search from
+	 * @param MaxDistance Max distance of the proxy to the location
+	 * @returns the spawned weapon, nullptr if there is no proxy in range or if called on a client
+	 */
+	UFUNCTION(Category="Weapon Proxy", BlueprintCallable)
+	AActor* HydrateClosest(const FVector& Location, float MaxDistance);
+
+	/** Number of weapons that are currently dehydrated */
+	int32 GetNumProxies() const { return ProxyStates.Num(); }
+
+protected:
+	/**
+	 * Spawns the real weapon of a proxy and removes the proxy
+	 * @param Idx Index of the proxy
+	 * @returns the spawned weapon
+	 */
+	AActor* Hydrate(int32 Idx);
+
+	/**
+	 * Captures the state of a weapon that should be restored on hydration
+	 * @param Weapon Gun or magazine
+	 * @param OutState Captured state
+	 * @returns false if the state can't be captured, e.g. while a magazine is only partially inserted
+	 */
+	bool CaptureState(AActor* Weapon, FTVRWeaponProxyState& OutState) const;
+
+	/**
+	 * Checks if a hydrated weapon is still in use
+	 * @param Weapon Gun or magazine
+	 * @returns true if the weapon is held, attached or pooled
+	 */
+	bool IsWeaponInUse(AActor* Weapon) const;
+
+	/**
+	 * Collects the motion controller locations of all players. Players without a VR character use their pawn location.
+	 * @param OutLocations Hand locations
+	 */
+	void GetHandLocations(TArray<FVector>& OutLocations) const;
+
+	class ATVRWeaponProxyActor* GetOrSpawnProxyActor();
+
+	/** Server state of the proxies, same order as the instances of the proxy actor */
+	UPROPERTY()
+	TArray<FTVRWeaponProxyState> ProxyStates;
+
+	UPROPERTY()
+	class ATVRWeaponProxyActor* ProxyActor;
+
+	/** Weapons that were hydrated and the time a hand was last near them */
+	TMap<TWeakObjectPtr<AActor>, float> HydratedWeapons;
+
+	float TimeSinceCheck;
+};
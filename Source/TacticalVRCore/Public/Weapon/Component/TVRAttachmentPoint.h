@@ -53,6 +53,13 @@ public:
 	
 	UFUNCTION(Category = "WeaponAttachment", BlueprintCallable)
 	void SetPreferredColorVariant(uint8 NewVariant);
+
+	/**
+	 * Restores the attachment class and the requested variants from the archetype of this component,
+	 * so swaps done at runtime do not survive when the owning gun is recycled.
+	 * Attachment points of the attachment are reset as well.
+	 */
+	virtual void ResetToDefaults();
 	
 	UPROPERTY(Category = "WeaponAttachment", EditDefaultsOnly)
 	bool bSpawnAttachmentOnBeginPlay;
@@ -6,23 +6,30 @@
 #include "VRGripInterface.h"
 #include "Grippables/GrippableBoxComponent.h"
 #include "Weapon/Component/TVRChargingHandleInterface.h"
+#include "Interfaces/TVRPoolableInterface.h"
 #include "TVRChargingHandle.generated.h"
 
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FTickChargignHandleGripDelegate, UGripMotionControllerComponent*, GrippingController, const FBPActorGripInformation&, GripInformation, float, DeltaTime);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FTickChargingHandleDelegate, float, DeltaTime);
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FTVRTickChargingHandleGripNativeEvent, UGripMotionControllerComponent*, const FBPActorGripInformation&, float);
+DECLARE_MULTICAST_DELEGATE_OneParam(FTVRTickChargingHandleNativeEvent, float);
 
 /**
  * 
  */
 UCLASS(Blueprintable, meta = (BlueprintSpawnableComponent),  ClassGroup = (TacticalVR))
-class TACTICALVRCORE_API UTVRChargingHandle : public UGrippableBoxComponent , public ITVRChargingHandleInterface
+class TACTICALVRCORE_API UTVRChargingHandle : public UGrippableBoxComponent , public ITVRChargingHandleInterface, public ITVRPoolableInterface
 {
 	GENERATED_BODY()
 public:
 	UTVRChargingHandle(const FObjectInitializer& OI);
 
 	virtual void BeginPlay() override;
+
+	// PoolableInterface
+	virtual void ResetForPool_Implementation() override;
+
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	
 	virtual void OnGrip_Implementation(UGripMotionControllerComponent* GrippingController, const FBPActorGripInformation& GripInformation) override;
@@ -60,6 +67,10 @@ public:
 	FTickChargignHandleGripDelegate EventTickGrip;
 	UPROPERTY(Category="Charging Handle", BlueprintAssignable)
 	FTickChargingHandleDelegate EventTick;
+
+	/** Native versions of the tick events for C++ listeners, they are broadcast every frame without reflection */
+	FTVRTickChargingHandleGripNativeEvent EventTickGripNative;
+	FTVRTickChargingHandleNativeEvent EventTickNative;
 	
 protected:
 	float InitialProgress;
@@ -86,8 +97,9 @@ protected:
 
 	ETVRLeftRight GrabLocation;
 	
+	/** Voices of the gun, the handle sounds are played as one-shots on them */
 	UPROPERTY()
-	class UAudioComponent* AudioComponent;
+	class UTVRGunAudioComponent* GunAudio;
 	
 	UPROPERTY(Category="PumpAction", EditDefaultsOnly)
 	class USoundBase* ChargingHandleSoundCue;
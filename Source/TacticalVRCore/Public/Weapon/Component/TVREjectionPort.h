@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/BoxComponent.h"
+#include "Interfaces/TVRPoolableInterface.h"
 #include "TVREjectionPort.generated.h"
 
 /**
@@ -12,7 +13,7 @@
  * unused object in the pool. This is more efficient and probably beneficial as we might be rapid firing cartridges.
  */
 UCLASS(Blueprintable, meta = (BlueprintSpawnableComponent), ClassGroup = (TacticalVR))
-class TACTICALVRCORE_API UTVREjectionPort : public UBoxComponent
+class TACTICALVRCORE_API UTVREjectionPort : public UBoxComponent, public ITVRPoolableInterface
 {
 	GENERATED_BODY()
 
@@ -22,6 +23,9 @@ class TACTICALVRCORE_API UTVREjectionPort : public UBoxComponent
 public:
 	UTVREjectionPort(const FObjectInitializer& OI);
 	virtual void BeginPlay() override;
+
+	// PoolableInterface
+	virtual void ResetForPool_Implementation() override;
 	virtual void OnComponentDestroyed(bool bDestroyingHierarchy) override;
 
 #if WITH_EDITOR
@@ -45,6 +49,12 @@ public:
 
 	
 	virtual void PopulateCartridgePool();
+
+	/**
+	 * Spawns one casing into the pool
+	 * @returns true if the pool is full
+	 */
+	virtual bool PopulateCartridgePoolStep();
 	virtual class ATVRSpentCartridge* GetCartridgeFromPool();
 	
 	UFUNCTION(Category="Ejection", BlueprintCallable)
@@ -85,8 +95,9 @@ protected:
 	UPROPERTY(Category="Chamber", EditDefaultsOnly)
 	USoundBase* EjectSound;
 
+	/** Audio emitter of the gun */
 	UPROPERTY()
-	UAudioComponent* EjectAudioComp;
+	class UTVRGunAudioComponent* GunAudio;
 
 	FRandomStream CartridgeEjectRandomStream;
 
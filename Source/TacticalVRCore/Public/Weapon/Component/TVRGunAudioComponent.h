@@ -0,0 +1,114 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "TVRGunAudioComponent.generated.h"
+
+/**
+ * Identifies one sound played on a voice of a UTVRGunAudioComponent. The handle becomes invalid once the voice is
+ * used for another sound, so it is safe to keep it around.
+ */
+struct TACTICALVRCORE_API FTVRGunVoiceHandle
+{
+	FTVRGunVoiceHandle()
+		: VoiceIdx(INDEX_NONE)
+		, Generation(0)
+	{}
+
+	int32 VoiceIdx;
+	uint32 Generation;
+};
+
+/**
+ * Audio emitter of a gun. All components of the gun (firing, ejection port, magazine) play their sounds on a small
+ * set of voices of this component instead of having their own audio components.
+ * A voice is moved to the component that plays a sound, when all voices are busy the oldest one-shot is stolen.
+ * One voice can be reserved for a looping sound (automatic fire).
+ */
+UCLASS(Blueprintable, BlueprintType,
+	meta = (BlueprintSpawnableComponent),
+	ClassGroup = (TacticalVR)
+)
+class TACTICALVRCORE_API UTVRGunAudioComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UTVRGunAudioComponent(const FObjectInitializer& OI);
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/**
+	 * Finds the audio emitter of an actor and creates one if it does not have one yet
+	 * @param Actor The gun (or other actor) that plays the sound
+	 * @returns the audio emitter of the actor
+	 */
+	static UTVRGunAudioComponent* FindOrCreate(AActor* Actor);
+
+	/**
+	 * Prepares a voice for a one-shot sound. Set the parameters of the sound on the returned voice and call Play.
+	 * Do not keep the returned voice, it can be stolen by other sounds. Use OutHandle to access it later.
+	 * @param Sound Sound to play
+	 * @param AttachParent Component the sound is played at
+	 * @param OutHandle Optional handle of the sound
+	 * @returns the voice or nullptr if no sound can be played
+	 */
+	class UAudioComponent* PrepareOneShot(USoundBase* Sound, USceneComponent* AttachParent, FTVRGunVoiceHandle* OutHandle = nullptr);
+
+	/**
+	 * @param Handle Handle of a sound returned by PrepareOneShot
+	 * @returns the voice of the sound or nullptr if the voice is playing another sound by now
+	 */
+	class UAudioComponent* GetVoice(const FTVRGunVoiceHandle& Handle) const;
+
+	/**
+	 * Prepares the loop voice. Set the parameters of the sound on the returned voice and call Play.
+	 * The voice will not be stolen by one-shots until the loop is stopped.
+	 * @param Sound Looping sound
+	 * @param AttachParent Component the sound is played at
+	 * @returns the voice or nullptr if no sound can be played
+	 */
+	class UAudioComponent* PrepareLoop(USoundBase* Sound, USceneComponent* AttachParent);
+
+	/**
+	 * Stops the looping sound
+	 * @param FadeOutTime Fade out duration in s
+	 */
+	void StopLoop(float FadeOutTime = 0.f);
+
+	/**
+	 * @returns true if the loop voice is playing
+	 */
+	bool IsLoopPlaying() const;
+
+protected:
+	/**
+	 * Finds a free voice or steals the oldest one-shot voice
+	 * @returns the index of the voice or INDEX_NONE
+	 */
+	int32 AcquireVoice();
+
+	/**
+	 * Moves the voice to the attach parent and sets the sound
+	 * @returns the voice
+	 */
+	class UAudioComponent* SetupVoice(int32 VoiceIdx, USoundBase* Sound, USceneComponent* AttachParent);
+
+	/** Max number of sounds this gun can play at once */
+	UPROPERTY(Category="Audio", EditDefaultsOnly, meta=(ClampMin=1))
+	int32 MaxVoices;
+
+	UPROPERTY(Transient)
+	TArray<class UAudioComponent*> Voices;
+
+	/** World time each voice was last started */
+	TArray<float> VoiceStartTimes;
+
+	/** Incremented every time a voice is set up for a new sound, invalidates older handles */
+	TArray<uint32> VoiceGenerations;
+
+	/** Index of the voice that is playing the loop or INDEX_NONE */
+	int32 LoopVoice;
+};
@@ -4,6 +4,9 @@
 
 #include "CoreMinimal.h"
 #include "Components/SceneComponent.h"
+#include "Interfaces/TVRPoolableInterface.h"
+#include "Net/TVRRpcTokenBucket.h"
+#include "Weapon/Component/TVRGunAudioComponent.h"
 #include "TVRGunFireComponent.generated.h"
 
 
@@ -21,14 +24,57 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FFiringCompEvent);
 /** Event for hit events. */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FFireHitEvent, const FHitResult&, Hit, TSubclassOf<class ATVRCartridge>, CartridgeClass);
 
+/** Native counterpart of FFiringCompEvent for C++ listeners. */
+DECLARE_MULTICAST_DELEGATE(FTVRFiringCompNativeEvent);
+
+/** Native counterpart of FFireHitEvent for C++ listeners. */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FTVRFireHitNativeEvent, const FHitResult&, TSubclassOf<class ATVRCartridge>);
+
 /** Event for overriding the firing logic. */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FFireOverrideEvent, const FVector&, FireDirection, TSubclassOf<class ATVRCartridge>, CartridgeClass);
 
+/**
+ * Replicated result of the shots on the server
+ */
+USTRUCT()
+struct FTVRAuthShotState
+{
+	GENERATED_BODY()
+
+	FTVRAuthShotState()
+	{
+		ShotSequence = 0;
+		FiredShotCounter = 0;
+		AmmoCount = -1;
+	}
+
+	/** Sequence number of the last shot the server has processed (fired or rejected) */
+	UPROPERTY()
+	uint16 ShotSequence;
+
+	/** Incremented for every shot the server actually fired */
+	UPROPERTY()
+	uint8 FiredShotCounter;
+
+	/** Rounds available on the server (unspent chambered round and magazine). -1 if unknown */
+	UPROPERTY()
+	int16 AmmoCount;
+};
+
+/**
+ * A shot the owning client has fired ahead of the server
+ */
+struct FTVRPredictedShot
+{
+	uint16 Sequence;
+	float Time;
+};
+
 UCLASS(
 	ClassGroup=(Custom),
 	HideCategories=(Rendering, ComponentTick, ComponentReplication, Activation, Physics, LOD, Collision),
 	meta=(BlueprintSpawnableComponent) )
-class TACTICALVRCORE_API UTVRGunFireComponent : public USceneComponent
+class TACTICALVRCORE_API UTVRGunFireComponent : public USceneComponent, public ITVRPoolableInterface
 {
 	GENERATED_BODY()
 
@@ -95,8 +141,45 @@ public:
 	UPROPERTY(Category="Events", BlueprintAssignable)
 	FFireOverrideEvent FireOverride;
 
+	/**
+	 * Event called on the owning client when the server has rejected a predicted shot. The cosmetics of the shot
+	 * have already been stopped, use this to roll back additional effects.
+	 */
+	UPROPERTY(Category="Events", BlueprintAssignable)
+	FFiringCompEvent OnShotRejected;
+
+	/**
+	 * Event called on remote clients when the server has confirmed a shot of this gun.
+	 */
+	UPROPERTY(Category="Events", BlueprintAssignable)
+	FFiringCompEvent OnShotConfirmed;
+
+	/**
+	 * Native versions of the per shot events. They are broadcast before the Blueprint events and do not go through
+	 * reflection, so C++ listeners (recoil, haptics, audio, ...) should bind to these. The Blueprint events are only
+	 * broadcast if something is bound to them.
+	 */
+	FTVRFiringCompNativeEvent OnFireNative;
+	FTVRFiringCompNativeEvent OnEndCycleNative;
+	FTVRFiringCompNativeEvent OnSimulateFireNative;
+	FTVRFiringCompNativeEvent OnEmptyNative;
+	FTVRFireHitNativeEvent OnSimulateHitNative;
+	FTVRFiringCompNativeEvent OnCartridgeSpentNative;
+
 	virtual void SetSuppressed(bool NewValue);
 	virtual void ResetSuppressed();
+
+	/**
+	 * Marks the cached trace query params as outdated. Should be called whenever the actors that are ignored by the
+	 * trace change, e.g. when the gun is gripped, dropped or attached to another weapon.
+	 */
+	void InvalidateTraceQueryCache();
+
+	/**
+	 * Updates the replicated ammo count on the server. Has to be called whenever the rounds available to the gun
+	 * change outside of firing, e.g. when a magazine is inserted or removed.
+	 */
+	void UpdateAuthAmmoCount();
 	
 	UPROPERTY()
 	class UParticleSystemComponent* MuzzleFlashOverride;
@@ -112,12 +195,12 @@ protected:
 	class UParticleSystemComponent* MuzzleFlashPSC;
 	
 
-	/** Audio component for gunshots. Will be set during BeginPlay if this component has a suitable child component */
+	/** Audio emitter of the gun, all sounds of this component are played on its voices */
 	UPROPERTY()
-	class UAudioComponent* FireAudioComp;
-	
-	UPROPERTY()
-	class UAudioComponent* EmptyAudioComp;
+	class UTVRGunAudioComponent* GunAudio;
+
+	/** Handle of the last gunshot, the voice may be used by other sounds of the gun by now */
+	FTVRGunVoiceHandle FireVoice;
 
 	
 	UPROPERTY(Category = "Firing", EditDefaultsOnly)
@@ -125,6 +208,20 @@ protected:
 	
 	UPROPERTY(Category = "Firing", EditDefaultsOnly)
 	class USoundBase* EmptySoundCue;
+
+	/**
+	 * Looping sound for continuous fire. If set, consecutive shots at the rate of fire keep this loop playing
+	 * instead of restarting the gunshot sound for every shot. The first shot still plays the gunshot sound.
+	 */
+	UPROPERTY(Category = "Firing", EditDefaultsOnly)
+	class USoundBase* AutoFireLoopSound;
+
+	/** Played when the continuous fire loop stops */
+	UPROPERTY(Category = "Firing", EditDefaultsOnly)
+	class USoundBase* AutoFireTailSound;
+
+	/** Runs while shots follow each other at the rate of fire, stops the loop when it expires */
+	FTimerHandle FireLoopTimer;
 	
 
 	/** Type of the currently loaded cartridge. Will be used to determine data about the shot that is fired. */
@@ -176,21 +273,118 @@ protected:
 	/** Whether or not to initiate a kick with haptic feedback device at pistol grip (like Provolver) */
 	UPROPERTY(Category="Firing|Haptics", EditDefaultsOnly)
 	uint8 bUseGunHapticsPistolGrip: 1;
+
+	/** Amplitude of the kick on the motion controller of the trigger hand, 0 disables it */
+	UPROPERTY(Category="Firing|Haptics", EditDefaultsOnly, meta=(ClampMin=0.f, ClampMax=1.f))
+	float ControllerKickAmplitude;
+
+	/** Frequency of the kick on the motion controller of the trigger hand */
+	UPROPERTY(Category="Firing|Haptics", EditDefaultsOnly, meta=(ClampMin=0.f, ClampMax=1.f))
+	float ControllerKickFrequency;
+
+	/** Duration of the kick on the motion controller of the trigger hand */
+	UPROPERTY(Category="Firing|Haptics", EditDefaultsOnly, meta=(ClampMin=0.f))
+	float ControllerKickDuration;
+
+	/** Priority of the kick in the haptics mixer, it overrides the trigger feel */
+	UPROPERTY(Category="Firing|Haptics", EditDefaultsOnly)
+	uint8 ControllerKickPriority;
 	
 	UPROPERTY(Category="Firing", EditDefaultsOnly, meta=(ClampMin=0.f))
 	float BaseDamageMod;
+
+	/**
+	 * If true, shots fired by the local player use the most recent pose of the aiming controller instead of the
+	 * component transform after physics. The offset between controller and muzzle (grip offset and current
+	 * constraint error) is preserved, so the shot goes where the late updated sights were pointing.
+	 */
+	UPROPERTY(Category="Firing", EditDefaultsOnly)
+	uint8 bUseLateUpdatedMuzzlePose: 1;
 	
 	/** Timer that tracks when the weapon can fire again */
 	FTimerHandle RefireTimer;
 
+	/**
+	 * Time that passed between the trigger break and the call to StartFire. The first refire cooldown is shortened by
+	 * this amount so that the cadence is measured from the actual trigger break. The break time comes from input
+	 * processing on the game thread, so this only covers the delay within the frame.
+	 */
+	float TriggerBreakLatency;
+
+	/** Buckshot shells of the owning client whose pellets are still traced, their hits are reported together */
+	uint8 NumCollectingShells;
+
+	/** Pellet hits of the owning client that were not reported to the server yet */
+	TArray<FHitResult> PendingPelletHits;
+
 	/** Random Stream for Firing Logic */
 	FRandomStream RandomFiringStream;
 
 	/** True if the Cartridge was spent and cannot be used anymore. */
 	bool bCartridgeIsSpent;
 
-	UPROPERTY()
-	UAudioComponent* ImpactSoundComp;
+	/**
+	 * If true, cosmetic fire and hit events are only sent to clients that are close enough to perceive them.
+	 * Clients further away receive an aggregated distant gunfire event instead.
+	 */
+	UPROPERTY(Category="Firing|Network", EditDefaultsOnly)
+	uint8 bUseNetInterestManagement: 1;
+
+	/** Distance in cm up to which clients receive full fire and hit events */
+	UPROPERTY(Category="Firing|Network", EditDefaultsOnly, meta=(EditCondition="bUseNetInterestManagement", ClampMin=0.f))
+	float FullEventRange;
+
+	/** Distance in cm up to which clients receive the distant gunfire event. Clients further away receive nothing. */
+	UPROPERTY(Category="Firing|Network", EditDefaultsOnly, meta=(EditCondition="bUseNetInterestManagement", ClampMin=0.f))
+	float DistantEventRange;
+
+	/** Minimum time in seconds between two distant gunfire events of this component */
+	UPROPERTY(Category="Firing|Network", EditDefaultsOnly, meta=(EditCondition="bUseNetInterestManagement", ClampMin=0.f))
+	float DistantEventInterval;
+
+	/** World time of the last distant gunfire event */
+	float LastDistantEventTime;
+
+	/** World time of the last shot fired on the server, used to validate client hit reports */
+	float LastAuthorityFireTime;
+
+	/** Hit reports of the owning client, refilled with the fire cadence of the gun */
+	FTVRRpcTokenBucket HitReportBucket;
+
+	/**
+	 * If true, the owning client fires without waiting for the server. Every shot is sent with a sequence number,
+	 * the server fires it if it can and replicates the result, mispredicted shots and ammo are corrected.
+	 * Opt-in, because predicted guns do not send the start and stop fire RPCs (e.g. the server does not simulate
+	 * the empty click for other players).
+	 */
+	UPROPERTY(Category="Firing|Network", EditDefaultsOnly)
+	uint8 bPredictShots: 1;
+
+	/** Part of the refire time a predicted shot may arrive early on the server (network jitter) */
+	UPROPERTY(Category="Firing|Network", EditDefaultsOnly, meta=(EditCondition="bPredictShots", ClampMin=0.f, ClampMax=1.f))
+	float PredictedShotCadenceTolerance;
+
+	/** Result of the shots on the server */
+	UPROPERTY(ReplicatedUsing=OnRep_AuthShotState)
+	FTVRAuthShotState AuthShotState;
+
+	/** Shot that arrived while the gun was still cycling on the server, it will be retried once */
+	uint16 DeferredShotSequence;
+	FTimerHandle DeferredShotTimer;
+
+	/** Sequence number of the last shot predicted by the owning client */
+	uint16 LocalShotSequence;
+
+	/** Shots of the owning client that have not been confirmed yet */
+	TArray<FTVRPredictedShot> PredictedShots;
+
+	/** Query params including the ignored actors, reused for every shot until invalidated */
+	FCollisionQueryParams CachedTraceQueryParams;
+
+	/** Attachment root the cached query params were built for. A different root invalidates the cache as well. */
+	TWeakObjectPtr<AActor> CachedTraceAttachRoot;
+
+	uint8 bTraceQueryCacheValid: 1;
 	
 protected:	
 	// Called when the game starts
@@ -200,6 +394,76 @@ protected:
 
 	virtual void BeginDestroy() override;
 
+	// PoolableInterface
+	virtual void ResetForPool_Implementation() override;
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	/**
+	 * @returns true if shots of this component are predicted by the owning client
+	 */
+	bool IsPredictingShots() const;
+
+	/**
+	 * Records a predicted shot and sends it to the server
+	 */
+	void PredictShot();
+
+	/**
+	 * Fires a shot predicted by the owning client
+	 * @param Sequence Sequence number of the shot
+	 */
+	UFUNCTION(Unreliable, Server)
+	void ServerFireShot(uint16 Sequence);
+	void ServerFireShot_Implementation(uint16 Sequence);
+
+	/**
+	 * @returns true if the server can fire a predicted shot now
+	 */
+	virtual bool CanAuthorityFirePredictedShot() const;
+
+	/**
+	 * Fires a predicted shot on the server
+	 * @param Sequence Sequence number of the shot
+	 */
+	void AuthorityFirePredictedShot(uint16 Sequence);
+
+	/**
+	 * Retries a shot that arrived while the gun was still cycling, rejects it if it still can't be fired
+	 */
+	void RetryDeferredShot();
+
+	/**
+	 * Tells the owning client that a predicted shot was not fired on the server
+	 * @param Sequence Sequence number of the shot
+	 */
+	UFUNCTION(Unreliable, Client)
+	void ClientRejectShot(uint16 Sequence);
+	void ClientRejectShot_Implementation(uint16 Sequence);
+
+	UFUNCTION()
+	virtual void OnRep_AuthShotState(const FTVRAuthShotState& PrevState);
+
+	/**
+	 * Stops the cosmetics of the last shot (muzzle flash, fire sound)
+	 */
+	virtual void RollbackShotCosmetics();
+
+	/**
+	 * @returns the rounds available to the gun (unspent chambered round and magazine)
+	 */
+	int32 GetAvailableAmmoCount() const;
+
+	/**
+	 * Corrects the local ammo on the owning client by the server state and the shots that are still in flight
+	 */
+	void ReconcileAmmo();
+
+	/**
+	 * @returns true if the shot sequence A is newer than B (handles wrap around)
+	 */
+	static bool IsShotSequenceNewer(uint16 A, uint16 B) { return static_cast<int16>(A - B) > 0; }
+
 	/**
 	 * Provides easier access to the timer manager
 	 * @returns the owner's World Timer Manager
@@ -211,6 +475,12 @@ protected:
 	 */
 	bool IsOwnerLocalPlayerController() const;
 
+	/**
+	 * @returns true on the server if a remote player fires this gun. That player traces the shot and reports the hits,
+	 * so the trace of the server does not apply damage.
+	 */
+	bool IsShotReportedByClient() const;
+
 	/**
 	 * @returns the character in the owner chain. Can also be null
 	 */
@@ -221,6 +491,23 @@ protected:
 	 */
 	class ATVRCharacter* GetVRCharacterOwner() const;
 
+	/**
+	 * @returns the gun this component belongs to, either directly or through an attachment. Can also be null
+	 */
+	class ATVRGunBase* GetGunOwner() const;
+
+	/**
+	 * @returns the motion controller that is currently aiming the gun. Can also be null
+	 */
+	class UGripMotionControllerComponent* GetAimingController() const;
+
+	/**
+	 * Computes the muzzle transform based on the latest polled pose of the aiming controller.
+	 * @param OutTransform The late updated muzzle transform in world space
+	 * @returns true if a late updated pose was available
+	 */
+	bool GetLateUpdatedMuzzleTransform(FTransform& OutTransform) const;
+
 	/**
 	 * @returns true if the gun should Refire (or even fire at all). Mostly used to handle ending bursts, etc.
 	 */
@@ -233,6 +520,11 @@ protected:
 	virtual void Fire();
 	virtual void ReFire();
 
+	/**
+	 * Finishes the current firing cycle: clears the refire timer and broadcasts the end of cycle events
+	 */
+	void EndCycle();
+
 	/**
 	 * Calls the function that simulates fire.
 	 * If this is called on the server it will send an multicast event to all clients.
@@ -248,12 +540,34 @@ protected:
 	void MulticastSimulateFire();
 	void MulticastSimulateFire_Implementation();
 
+	/**
+	 * Server only. Sends the fire event to each client depending on its distance to the muzzle.
+	 */
+	virtual void SendSimulateFireToClients();
+
+	/**
+	 * Server only. Sends the hit event to each client that is in range of the impact.
+	 * @param Hit the hit to simulate
+	 * @param Cartridge the fired cartridge type
+	 */
+	virtual void SendSimulateHitToClients(const FHitResult& Hit, TSubclassOf<class ATVRCartridge> Cartridge);
+
 	/**
 	 * Anything that is needed to simulate the weapon firing, such as Muzzle Flash, Firing Sound, etc.
 	 * Only effects, no gameplay.
 	 */
 	virtual void LocalSimulateFire();
 
+	/**
+	 * Plays the sound of a shot, either as one-shot or by keeping the continuous fire loop alive
+	 */
+	void PlayFireSound();
+
+	/**
+	 * Stops the continuous fire loop and plays the tail
+	 */
+	void StopFireLoop();
+
 	/**
 	 * Called to simulate an empty gun (click) for all simulating instances (whether they are proxies or not
 	 */
@@ -278,10 +592,19 @@ protected:
 	 * itself in the next frame to process all the other pending buckshots until it is done.
 	 * @param PendingBuckshot Number of pending bucks to process
 	 * @param AmmoCDO constant default object of the fired ammunition
+	 * @param PendingBuckshotOrigin origin of the pending shot
 	 * @param PendingBuckshotDir direction of the pending shot (otherwise recoil will affect this)
 	 */
 	UFUNCTION()
-	virtual void FireBuckshot(uint8 PendingBuckshot, const ATVRCartridge* AmmoCDO, FVector PendingBuckshotDir);
+	virtual void FireBuckshot(uint8 PendingBuckshot, const ATVRCartridge* AmmoCDO, FVector PendingBuckshotOrigin, FVector PendingBuckshotDir);
+
+	/**
+	 * Launches a projectile into the ballistics simulation
+	 * @param AmmoCDO constant default object of the fired ammunition
+	 * @param Origin start location of the projectile
+	 * @param Direction normalized launch direction
+	 */
+	virtual void LaunchProjectile(const ATVRCartridge* AmmoCDO, const FVector& Origin, const FVector& Direction);
 
 	/**
 	 * Adds ignored actors to the trace query params.
@@ -290,12 +613,52 @@ protected:
 	virtual void AddTraceIgnoreActors(struct FCollisionQueryParams& QueryParams);
 
 	/**
-	 * Trace functionality for gun fire
+	 * @returns the cached query params for weapon traces. Rebuilds them if they have been invalidated.
+	 */
+	const FCollisionQueryParams& GetTraceQueryParams();
+
+	/**
+	 * @param AmmoCDO constant default object of the fired ammunition
+	 * @returns true if the shot needs all hits along the trace (e.g. for penetration). Otherwise a single hit trace is used.
+	 */
+	virtual bool ShouldTraceMultiHit(const ATVRCartridge* AmmoCDO) const;
+
+	/**
+	 * Trace functionality for gun fire. Physical materials are not resolved here, see ResolveHitPhysicalMaterial.
 	 * @param Hits Reference to the array where hits will be stored to
+	 * @param TraceStart Origin of the trace
 	 * @param TraceDir Direction of the trace
+	 * @param bMultiHit If true all hits along the trace are returned, otherwise only the first blocking hit
 	 * @return True if we have hit anything (even overlaps/penetration)
 	 */
-	virtual bool TraceFire(TArray<FHitResult>& Hits, const FVector& TraceDir);
+	virtual bool TraceFire(TArray<FHitResult>& Hits, const FVector& TraceStart, const FVector& TraceDir, bool bMultiHit = false);
+
+	/**
+	 * Looks up the physical material of a hit after the trace, so only the hit that is actually processed pays for it.
+	 * @param Hit The hit whose PhysMaterial will be filled
+	 */
+	static void ResolveHitPhysicalMaterial(FHitResult& Hit);
+
+	/**
+	 * Traces a complete shot. Depending on the cartridge this is a single straight trace or several segments along
+	 * the cartridge's ballistic trajectory, ending at the first blocking hit.
+	 * @param Hits Reference to the array where hits will be stored to
+	 * @param TraceStart Origin of the shot
+	 * @param ShotDir Normalized direction of the shot
+	 * @param AmmoCDO constant default object of the fired ammunition
+	 * @return True if we have hit anything (even overlaps/penetration)
+	 */
+	virtual bool TraceShot(TArray<FHitResult>& Hits, const FVector& TraceStart, const FVector& ShotDir, const ATVRCartridge* AmmoCDO);
+
+	/**
+	 * Traces the segments along the cartridge's ballistic trajectory until the first blocking hit.
+	 * @param Hits Reference to the array where hits will be stored to
+	 * @param TraceStart Origin of the shot
+	 * @param ShotDir Normalized direction of the shot
+	 * @param AmmoCDO constant default object of the fired ammunition
+	 * @param bMultiHit If true all hits along the segments are returned
+	 */
+	void TraceTrajectory(TArray<FHitResult>& Hits, const FVector& TraceStart, const FVector& ShotDir, const ATVRCartridge* AmmoCDO, bool bMultiHit);
 
 	/**
 	 * Processes the hits we encountered during our trace
@@ -303,12 +666,61 @@ protected:
 	 * @param Cartridge Class of the Cartridge that was fired
 	 */
 	virtual void ProcessHits(TArray<FHitResult>& Hits, TSubclassOf<class ATVRCartridge> Cartridge);
+
+	/**
+	 * Sends a shot that hit nothing like a hit from the muzzle to the end of the trace, without any damage or impact.
+	 * @param TraceStart Origin of the shot
+	 * @param ShotDir Normalized direction of the shot
+	 * @param AmmoCDO constant default object of the fired ammunition
+	 */
+	void ProcessMiss(const FVector& TraceStart, const FVector& ShotDir, const ATVRCartridge* AmmoCDO);
+
+	/**
+	 * Queues point damage for the victim, so all hits of a frame are applied as one aggregated damage event.
+	 * @param Victim The actor that was hit
+	 * @param Damage Damage of this hit
+	 * @param ShotDirection Direction of the shot
+	 * @param Hit The hit against the victim
+	 * @param EventInstigator Controller that was responsible for the damage
+	 * @param DamageCauser Actor that actually caused the damage
+	 * @param DamageTypeClass Type of the damage
+	 */
+	void ApplyHitDamage(AActor* Victim, float Damage, const FVector& ShotDirection, const FHitResult& Hit,
+		AController* EventInstigator, AActor* DamageCauser, TSubclassOf<UDamageType> DamageTypeClass);
 	
 
 	UFUNCTION(Category = "Firing", Reliable, Server, WithValidation)
 	void ServerReceiveHit(const FHitResult& Hit, TSubclassOf<class ATVRCartridge> Cartridge = nullptr);
 	void ServerReceiveHit_Implementation(const FHitResult& Hit, TSubclassOf<class ATVRCartridge> Cartridge = nullptr);
-	bool ServerReceiveHit_Validate(const FHitResult& Hit, TSubclassOf<class ATVRCartridge> Cartridge = nullptr) {return true;}
+	bool ServerReceiveHit_Validate(const FHitResult& Hit, TSubclassOf<class ATVRCartridge> Cartridge = nullptr) {return Cartridge != nullptr;}
+
+	/** Reports all pellet hits of a buckshot shell at once, so their damage is applied together */
+	UFUNCTION(Category = "Firing", Reliable, Server, WithValidation)
+	void ServerReceiveHits(const TArray<FHitResult>& Hits, TSubclassOf<class ATVRCartridge> Cartridge);
+	void ServerReceiveHits_Implementation(const TArray<FHitResult>& Hits, TSubclassOf<class ATVRCartridge> Cartridge);
+	bool ServerReceiveHits_Validate(const TArray<FHitResult>& Hits, TSubclassOf<class ATVRCartridge> Cartridge) {return Cartridge != nullptr && Hits.Num() <= MAX_uint8;}
+
+	/**
+	 * Applies a hit on the server: replicates the hit effects and applies the damage.
+	 * @param Hit The hit result
+	 * @param Cartridge Class of the Cartridge that was fired
+	 */
+	void AuthorityReceiveHit(const FHitResult& Hit, TSubclassOf<class ATVRCartridge> Cartridge);
+
+	/**
+	 * Cheap plausibility checks for a hit reported by the owning client. Runs before any damage work.
+	 * Checks the rate limit of the connection, the fire cadence and ammo of the gun and the distance to the muzzle.
+	 * @param Hit The reported hit
+	 * @param Cartridge Class of the Cartridge that was fired
+	 * @returns true if the hit should be processed
+	 */
+	virtual bool AcceptClientHit(const FHitResult& Hit, TSubclassOf<class ATVRCartridge> Cartridge);
+
+	/**
+	 * Applies the per connection rate limit of weapon RPCs.
+	 * @returns true if the RPC of the owning connection may be processed
+	 */
+	bool ConsumeOwnerRpcToken() const;
     
 	void SimulateHit(const FHitResult& Hit, TSubclassOf<class ATVRCartridge> Cartridge = nullptr);
 	
@@ -318,22 +730,32 @@ protected:
     
 	void LocalSimulateHit(const FHitResult& Hit, TSubclassOf<class ATVRCartridge> Cartridge = nullptr);
 
-	void SimulateFlyBy(const FVector_NetQuantize& Origin, const FVector_NetQuantize& Target, TSubclassOf<class ATVRCartridge> Cartridge);
 	void LocalSimulateFlyBy(const FVector_NetQuantize& Origin, const FVector_NetQuantize& Target, TSubclassOf<class ATVRCartridge> Cartridge);
 
-	void SpawnImpactSound(const FHitResult& Hit, USoundBase* Sound);
+	static void SpawnImpactSound(UWorld* World, const FHitResult& Hit, USoundBase* Sound);
 public:
 	/**
 	 * @returns the time it takes to fire the weapon again (min cooldown for the weapon to be ready to shoot)
 	 */
 	float GetRefireTime() const;
 
+	/**
+	 * @returns the transform used as origin and direction (X-Axis) of shots. Will be late updated if enabled.
+	 */
+	UFUNCTION(Category="Firing", BlueprintCallable)
+	FTransform GetMuzzleTransform() const;
+
 	/**
 	 * @returns the current fire mode
 	 */
 	UFUNCTION(Category="Firing", BlueprintCallable)
 	ETVRFireMode GetCurrentFireMode() const {return CurrentFireMode;}
 
+	/**
+	 * @returns the fire mode the gun starts in
+	 */
+	ETVRFireMode GetInitialFireMode() const;
+
 	/**
 	 * Gets the next firing mode based on the input
 	 * @param PrevFireMode the previous fire mode
@@ -376,6 +798,12 @@ public:
 	
 	UFUNCTION(Category = "Firing", BlueprintCallable)
 	virtual void StartFire();
+
+	/**
+	 * Starts firing with a known trigger break time (e.g. interpolated by the trigger component)
+	 * @param TriggerBreakTime platform time (FPlatformTime::Seconds) at which the trigger broke
+	 */
+	virtual void StartFireAtTime(double TriggerBreakTime);
 	
 	UFUNCTION(Category = "Firing", Reliable, Server, WithValidation)
 	void ServerStartFire();
@@ -408,4 +836,38 @@ public:
 	bool IsCartridgeSpent() const { return bCartridgeIsSpent; }
 	
 	virtual float GetDamage(TSubclassOf<ATVRCartridge> Cartridge) const;
+
+	/**
+	 * @returns the combined muzzle velocity modifier of all attachments
+	 */
+	virtual float GetMuzzleVelocityModifier() const;
+
+	/**
+	 * Called by the ballistics subsystem when a projectile fired by this component has hit something.
+	 * The hit is processed the same way as a hit-scan hit.
+	 * @param Hit the hit of the projectile
+	 * @param Cartridge the fired cartridge type
+	 */
+	void ReceiveProjectileHit(const FHitResult& Hit, TSubclassOf<class ATVRCartridge> Cartridge);
+
+	/**
+	 * Receives an interest managed fire event from the player controller. Does nothing for the owning client.
+	 */
+	void ReceiveSimulateFire();
+
+	/**
+	 * Receives an interest managed hit event from the player controller. Does nothing for the owning client.
+	 * @param Hit the hit to simulate
+	 * @param Cartridge the fired cartridge type
+	 */
+	void ReceiveSimulateHit(const FHitResult& Hit, TSubclassOf<class ATVRCartridge> Cartridge);
+
+	/**
+	 * Plays the impact particles, decal and sound of a hit. Does not need a firing component, so it can be used for hits
+	 * of guns that do not exist on this client.
+	 * @param World the world to play the effects in
+	 * @param Hit the hit to simulate
+	 * @param Cartridge the fired cartridge type
+	 */
+	static void SimulateImpact(UWorld* World, const FHitResult& Hit, TSubclassOf<class ATVRCartridge> Cartridge);
 };
@@ -18,8 +18,9 @@ class TACTICALVRCORE_API UTVRInternalMagazineComponent : public UTVRMagazineComp
 {
 	GENERATED_BODY()
 	
+	/** Audio emitter of the gun */
 	UPROPERTY()
-	class UAudioComponent* MagAudioComp;
+	class UTVRGunAudioComponent* GunAudio;
 	
 public:
 	UTVRInternalMagazineComponent(const FObjectInitializer& OI);
@@ -44,6 +45,9 @@ public:
 	virtual bool IsEmpty() const override;
 	virtual bool CanFeedAmmo() const override;
 	virtual TSubclassOf<class ATVRCartridge> TryFeedAmmo() override;
+	virtual int32 GetAmmoCount() const override { return InsertedAmmo.Num(); }
+	virtual void SetAmmoCount(int32 NewAmmo) override;
+	virtual void ReconcileAmmoCount(int32 NewAmmo) override;
 	virtual bool CanBoltLock() const override;
 	
 	// ================================================
@@ -65,6 +69,9 @@ protected:
 	
 	virtual void BeginPlay() override;
 
+	// PoolableInterface
+	virtual void ResetForPool_Implementation() override;
+
 	void BeginInsertCartridge(class ATVRCartridge* Cartridge);
 
 	void FullyInsertCartridge();
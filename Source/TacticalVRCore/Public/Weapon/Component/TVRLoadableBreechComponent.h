@@ -30,11 +30,9 @@ class TACTICALVRCORE_API ULoadableBreechComponent : public UTVRMagazineCompInter
 {
 	GENERATED_BODY()
 	
+	/** Audio emitter of the gun */
 	UPROPERTY()
-	UAudioComponent* CartridgeInsertAudioComp;
-	
-	UPROPERTY()
-	UAudioComponent* OpenCloseAudioComp;
+	class UTVRGunAudioComponent* GunAudio;
 	
 	UPROPERTY()
 	class UTVRGunFireComponent* FiringComp;
@@ -46,6 +44,9 @@ public:
 	ULoadableBreechComponent(const FObjectInitializer& OI);
 
 	virtual void BeginPlay() override;
+
+	// PoolableInterface
+	virtual void ResetForPool_Implementation() override;
 	virtual void BeginDestroy() override;
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
@@ -119,11 +120,6 @@ public:
 
 	float GetOpenDuration() const { return BreechOpenTime > 0.01f ? BreechOpenTime : 0.01f;}
 
-	UFUNCTION(Category="Weapon", BlueprintCallable)
-	UAudioComponent* GetCartridgeInsertAudioComp() const {return CartridgeInsertAudioComp;}
-	
-	UFUNCTION(Category="Weapon", BlueprintCallable)
-	UAudioComponent* GetOpenCloseAudioComp() const {return OpenCloseAudioComp; }
 	UFUNCTION(Category="Weapon", BlueprintCallable)
 	UTVRGunFireComponent* GetFiringComp() const {return FiringComp; }
 
@@ -25,13 +25,17 @@ class TACTICALVRCORE_API UTVRMagWellComponent : public UTVRMagazineCompInterface
 	GENERATED_BODY()
 
 
+	/** Audio emitter of the gun */
 	UPROPERTY()
-	class UAudioComponent* MagAudioComp;
+	class UTVRGunAudioComponent* GunAudio;
 	
 public:
 	UTVRMagWellComponent(const FObjectInitializer& OI);
 
 	virtual void BeginPlay() override;
+
+	// PoolableInterface
+	virtual void ResetForPool_Implementation() override;
 	virtual void BeginDestroy() override;
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction * ThisTickFunction) override;
 
@@ -70,6 +74,9 @@ public:
 	virtual bool CanFeedAmmo() const override;
 
 	virtual TSubclassOf<class ATVRCartridge> TryFeedAmmo() override;
+
+	virtual int32 GetAmmoCount() const override;
+	virtual void SetAmmoCount(int32 NewAmmo) override;
 	
 	// ================================================
 	// End MagazineComponentInterface
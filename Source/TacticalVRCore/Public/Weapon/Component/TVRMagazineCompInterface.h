@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/BoxComponent.h"
+#include "Interfaces/TVRPoolableInterface.h"
 #include "TVRMagazineCompInterface.generated.h"
 
 /**
@@ -13,7 +14,7 @@ UCLASS(Abstract,
 	hideCategories = (ComponentTick, Navigation, Physics, Collision), 
 	ClassGroup = (TacticalVR)
 )
-class TACTICALVRCORE_API UTVRMagazineCompInterface : public UBoxComponent
+class TACTICALVRCORE_API UTVRMagazineCompInterface : public UBoxComponent, public ITVRPoolableInterface
 {
 	GENERATED_BODY()
 
@@ -48,6 +49,24 @@ public:
 
 	virtual bool IsEmpty() const {return true;}
 
+	/**
+	 * @returns the number of rounds that can still be fed
+	 */
+	virtual int32 GetAmmoCount() const {return 0;}
+
+	/**
+	 * Overrides the number of rounds, e.g. to correct a mispredicted count on a client
+	 * @param NewAmmo the new number of rounds
+	 */
+	virtual void SetAmmoCount(int32 NewAmmo) {}
+
+	/**
+	 * Corrects the number of rounds after a mispredicted shot. Only the count is changed, so magazines that track the
+	 * type of each round do not add rounds of a guessed type.
+	 * @param NewAmmo the number of rounds the server has
+	 */
+	virtual void ReconcileAmmoCount(int32 NewAmmo) { SetAmmoCount(NewAmmo); }
+
 	virtual void OnMagReleasePressed(bool bAlternatePress = false) {}
 	virtual void OnMagReleaseReleased(bool bAlternatePress = false) {}
 
@@ -59,4 +78,11 @@ public:
 	virtual void OnOwnerGripReleased(class ATVRCharacter* OwningChar, class UGripMotionControllerComponent*);
 
 	virtual void GetAllowedCatridges(TArray<TSubclassOf<class ATVRCartridge>>& OutCartridges) const;
+
+protected:
+	/**
+	 * Tells the firing component of the gun that the number of rounds changed, so it can replicate it.
+	 * Has to be called on every change of GetAmmoCount, except for feeding a round.
+	 */
+	void NotifyAmmoCountChanged() const;
 };
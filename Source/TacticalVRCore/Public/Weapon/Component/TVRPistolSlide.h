@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Grippables/GrippableStaticMeshComponent.h"
 #include "Weapon/Component/TVRChargingHandleInterface.h"
+#include "Interfaces/TVRPoolableInterface.h"
 #include "TVRPistolSlide.generated.h"
 
 
@@ -14,7 +15,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FProgressChangeDelegate, class UTVR
  * 
  */
 UCLASS(Blueprintable, meta = (BlueprintSpawnableComponent),  ClassGroup = (TacticalVR))
-class TACTICALVRCORE_API UTVRPistolSlide : public UGrippableStaticMeshComponent, public ITVRChargingHandleInterface
+class TACTICALVRCORE_API UTVRPistolSlide : public UGrippableStaticMeshComponent, public ITVRChargingHandleInterface, public ITVRPoolableInterface
 {
 	GENERATED_BODY()
 
@@ -22,6 +23,10 @@ public:
 	UTVRPistolSlide(const FObjectInitializer& OI);
 
 	virtual void BeginPlay() override;
+
+	// PoolableInterface
+	virtual void ResetForPool_Implementation() override;
+
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	
 	virtual void OnGrip_Implementation(UGripMotionControllerComponent* GrippingController, const FBPActorGripInformation& GripInformation) override;
@@ -79,8 +84,9 @@ protected:
 	bool bShouldPlayBackSound;
 	bool bShouldPlayCloseSound;
 	
+	/** Voices of the gun, the slide sounds are played as one-shots on them */
 	UPROPERTY()
-	class UAudioComponent* AudioComponent;
+	class UTVRGunAudioComponent* GunAudio;
 	
 	UPROPERTY(Category="PumpAction", EditDefaultsOnly)
 	class USoundBase* SlideSoundCue;
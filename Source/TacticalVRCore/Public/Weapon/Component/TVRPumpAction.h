@@ -6,13 +6,14 @@
 #include "TVRChargingHandleInterface.h"
 #include "VRBPDatatypes.h"
 #include "Components/StaticMeshComponent.h"
+#include "Interfaces/TVRPoolableInterface.h"
 #include "TVRPumpAction.generated.h"
 
 /**
  * 
  */
 UCLASS(Blueprintable, meta = (BlueprintSpawnableComponent),  ClassGroup = (TacticalVR))
-class TACTICALVRCORE_API UTVRPumpAction : public UStaticMeshComponent, public ITVRChargingHandleInterface
+class TACTICALVRCORE_API UTVRPumpAction : public UStaticMeshComponent, public ITVRChargingHandleInterface, public ITVRPoolableInterface
 {
 	GENERATED_BODY()
 
@@ -21,6 +22,9 @@ public:
 	virtual void BeginPlay() override;
 	virtual void BeginDestroy() override;
 
+	// PoolableInterface
+	virtual void ResetForPool_Implementation() override;
+
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 	virtual void TickGrip(float DeltaTime, class UGripMotionControllerComponent* GrippingController);
@@ -60,8 +64,17 @@ protected:
 	virtual void PlayPumpBackSound();
 	virtual void PlayPumpCloseSound();
 
+	/**
+	 * @returns the audio component set through SetAudioComponent, otherwise a one-shot voice of the gun
+	 */
+	class UAudioComponent* PreparePumpVoice();
+
+	/** Audio component set through SetAudioComponent, the pump sounds use the voices of the gun if there is none */
 	UPROPERTY()
 	class UAudioComponent* AudioComponent;
+
+	UPROPERTY()
+	class UTVRGunAudioComponent* GunAudio;
 	
 	UPROPERTY(Category="PumpAction", EditDefaultsOnly)
 	class USoundBase* PumpActionSoundCue;
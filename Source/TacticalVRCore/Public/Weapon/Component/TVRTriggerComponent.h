@@ -48,6 +48,24 @@ protected:
 	
 	float TriggerAxis;
 
+	/** Trigger axis at the end of the last tick. Used for the trigger haptics. */
+	float LastTickTriggerAxis;
+
+	/** Platform time of the last trigger sample */
+	double LastSampleTime;
+
+	/** Interpolated platform time of the last time the trigger crossed the activation threshold */
+	double LastActivateTime;
+
+	/** Interpolated platform time of the last time the trigger crossed the reset threshold */
+	double LastResetTime;
+
+	/** True if the using character pushes timestamped samples, in that case the axis is not polled anymore */
+	bool bReceivesTriggerSamples;
+
+	/** Handle for the sample event of the character that is using this trigger */
+	FDelegateHandle TriggerSampleHandle;
+
 	class UGripMotionControllerComponent* UsingController;
 	
 public:	
@@ -59,6 +77,9 @@ public:
 	class APlayerController* GetOwnerPlayerController() const;
 	bool IsOwnerLocallyControlled() const;
 
+	/** Motion controller of the hand that is currently using the trigger, nullptr if not in use */
+	class UGripMotionControllerComponent* GetUsingController() const { return UsingController; }
+
 	UFUNCTION(Category="Trigger", BlueprintCallable)
 	void ActivateTrigger(UGripMotionControllerComponent* ActivatingController);
 	
@@ -74,6 +95,31 @@ public:
 
 	UFUNCTION(Category="Trigger", BlueprintCallable)
 	bool DoesTriggerNeedReset() const {return bTriggerNeedsReset;}
+
+	/**
+	 * @returns the interpolated platform time (FPlatformTime::Seconds) at which the trigger last crossed the activation value
+	 */
+	double GetLastActivateTime() const {return LastActivateTime;}
+
+	/**
+	 * @returns the activation time of the trigger pull that is currently held, 0.0 if the trigger is not pulled
+	 */
+	double GetCurrentPullActivateTime() const;
+
+	/**
+	 * @returns the interpolated platform time (FPlatformTime::Seconds) at which the trigger last crossed the reset value
+	 */
+	double GetLastResetTime() const {return LastResetTime;}
+
+	/**
+	 * Feeds a new timestamped trigger sample. Activation and reset crossings are detected against the previous sample
+	 * and their time is linearly interpolated between both samples.
+	 * Samples of ATVRCharacter are stamped when the game thread processes the input, so the compensation derived
+	 * from them only covers the processing delay within the frame, not the latency of the device.
+	 * @param Value the new trigger axis value
+	 * @param Timestamp platform time (FPlatformTime::Seconds) of the sample
+	 */
+	void PushTriggerSample(float Value, double Timestamp);
 	
 
 	
@@ -87,6 +133,18 @@ protected:
 	 * @returns the value of the controller's trigger aixs
 	 */
 	float GetParentTriggerAxis() const;
+
+	/** Called by the sample event of the using character */
+	void OnTriggerAxisSample(EControllerHand Hand, float Value, double Timestamp);
+
+	/**
+	 * Interpolates the time at which the trigger crossed a threshold between two samples
+	 * @param PrevValue axis value of the previous sample
+	 * @param PrevTime timestamp of the previous sample
+	 * @param Threshold the crossed threshold
+	 * @returns the estimated time of the crossing
+	 */
+	double GetCrossingTime(float PrevValue, double PrevTime, float Threshold) const;
 	
 public:	
 	// Called every frame
@@ -3,29 +3,18 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "GameFramework/Actor.h"
+#include "Weapon/TVRProjectile.h"
 #include "TVRBullet.generated.h"
 
+/**
+ * Projectile with defaults for a rifle bullet.
+ */
 UCLASS()
-class TACTICALVRCORE_API ATVRBullet : public AActor
+class TACTICALVRCORE_API ATVRBullet : public ATVRProjectile
 {
 	GENERATED_BODY()
 	
 public:	
 	// Sets default values for this actor's properties
 	ATVRBullet();
-
-protected:
-	// Called when the game starts or when spawned
-	virtual void BeginPlay() override;
-
-public:	
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
-
-
-	bool bIsActive;
-	FVector Velocity;
-	float DragCoefficient;
-
 };
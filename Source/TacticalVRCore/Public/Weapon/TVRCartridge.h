@@ -5,6 +5,9 @@
 #include "CoreMinimal.h"
 #include "Interfaces/TVRHandSocketInterface.h"
 #include "Grippables/GrippableStaticMeshActor.h"
+#include "Net/TVRNetRelevancyPolicy.h"
+#include "Sound/SoundBase.h"
+#include "Weapon/TVRTrajectoryTable.h"
 #include "TVRCartridge.generated.h"
 
 USTRUCT()
@@ -14,13 +17,13 @@ struct TACTICALVRCORE_API FImpactParticleData
 	
 	FImpactParticleData()
 	{
-		ParticleSystem = nullptr;		
 		UpAxis = EAxisOption::Z;
 		ScaleFactor = 1.f;
 	}
 
+	/** Loaded asynchronously through UTVRFXPreloadSubsystem */
 	UPROPERTY(Category="Impact Particle", EditDefaultsOnly)
-	UParticleSystem* ParticleSystem;
+	TSoftObjectPtr<UParticleSystem> ParticleSystem;
 	UPROPERTY(Category="Impact Particle", EditDefaultsOnly)
 	TEnumAsByte<EAxisOption::Type> UpAxis;
 	UPROPERTY(Category="Impact Particle", EditDefaultsOnly)
@@ -34,12 +37,12 @@ struct TACTICALVRCORE_API FImpactDecalData
 	
 	FImpactDecalData()
 	{
-		DecalMaterial = nullptr;		
 		ScaleFactor = 1.f;
 	}
 
+	/** Loaded asynchronously through UTVRFXPreloadSubsystem */
 	UPROPERTY(Category="Impact Particle", EditDefaultsOnly)
-	UMaterialInterface* DecalMaterial;
+	TSoftObjectPtr<UMaterialInterface> DecalMaterial;
 	UPROPERTY(Category="Impact Particle", EditDefaultsOnly)
 	float ScaleFactor;
 };
@@ -69,6 +72,19 @@ public:
 
 	UFUNCTION()
 	virtual void OnComponentHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
+
+	virtual bool IsNetRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation) const override;
+	virtual void OnGrip_Implementation(UGripMotionControllerComponent* GrippingController, const FBPActorGripInformation& GripInformation) override;
+	/** Puts the cartridge back into an ammo container, if it is released inside of one */
+	virtual void OnGripRelease_Implementation(UGripMotionControllerComponent* ReleasingController, const FBPActorGripInformation& GripInformation, bool bWasSocketed) override;
+
+	/** Called when the physics body of the cartridge went to sleep. Puts a loose cartridge to net dormancy. */
+	UFUNCTION()
+	virtual void OnRootBodySleep(UPrimitiveComponent* SleepingComponent, FName BoneName);
+
+	/** Called when the physics body of the cartridge woke up (e.g. due to an impact). Wakes the cartridge from net dormancy. */
+	UFUNCTION()
+	virtual void OnRootBodyWake(UPrimitiveComponent* WakingComponent, FName BoneName);
 	
 	virtual void ClosestGripSlotInRange_Implementation(FVector WorldLocation, bool bSecondarySlot, bool& bHadSlotInRange, FTransform& SlotWorldTransform, FName& SlotName, UGripMotionControllerComponent* CallingController, FName OverridePrefix) override;
 	
@@ -84,6 +100,12 @@ public:
 	UFUNCTION(Category="Cartridge", BlueprintCallable)
 	float GetBuckshotSpread() const { return BuckshotSpread; }
 
+	UFUNCTION(Category="Cartridge", BlueprintCallable)
+	bool IsProjectile() const { return bIsProjectile && ProjectileClass != nullptr; }
+
+	UFUNCTION(Category="Cartridge", BlueprintCallable)
+	TSubclassOf<class ATVRProjectile> GetProjectileClass() const { return ProjectileClass; }
+
 	class UCapsuleComponent* GetCollisionCapsule() const {return CollisionCapsule;}
 	class UAudioComponent* GetHitAudioComponent() const {return HitAudioComponent;}
 
@@ -93,15 +115,37 @@ public:
 	UFUNCTION(Category="Cartridge", BlueprintCallable)
 	float GetTraceDistance() const { return TraceDistance; }
 
+	UFUNCTION(Category="Cartridge", BlueprintCallable)
+	bool UsesBallisticTrajectory() const { return bUseBallisticTrajectory; }
+
+	UFUNCTION(Category="Cartridge", BlueprintCallable)
+	int32 GetTrajectorySegments() const { return TrajectorySegments; }
+
+	/**
+	 * @returns the trajectory table of this cartridge. The table is built on first use, so call this on the default object.
+	 * @param GravityZ gravity of the world the shot is fired in, the table is rebuilt if it changes
+	 */
+	const FTVRTrajectoryTable& GetTrajectoryTable(float GravityZ) const;
+
 	const FImpactParticleData* GetImpactParticle(EPhysicalSurface SurfaceType) const;
 	const FImpactDecalData* GetImpactDecal(EPhysicalSurface SurfaceType) const;
-	USoundBase* GetImpactSound() const { return ImpactSound; }
+	/** @returns the impact sound, nullptr while it is not loaded yet */
+	USoundBase* GetImpactSound() const { return ImpactSound.Get(); }
+	bool HasImpactSound() const { return !ImpactSound.IsNull(); }
 	
 	UFUNCTION(Category="Cartridge", BlueprintCallable)
 	float GetBaseDamage() const { return BaseDamage; }
 
+	/** @returns the fly-by sound, nullptr while it is not loaded yet */
 	UFUNCTION(Category="Cartridge", BlueprintCallable)
-	USoundBase* GetFlyBySound() const { return FlyBySound; }
+	USoundBase* GetFlyBySound() const { return FlyBySound.Get(); }
+	bool HasFlyBySound() const { return !FlyBySound.IsNull(); }
+
+	/**
+	 * Collects all effect assets of the cartridge, so they can be loaded before the first shot or impact
+	 * @param OutAssets Soft paths of the particles, decals and sounds
+	 */
+	void GetFXAssets(TArray<FSoftObjectPath>& OutAssets) const;
 	UFUNCTION(Category="Cartridge", BlueprintCallable)
 	float GetFlyByVolume(const float Dist) const;
 	UFUNCTION(Category="Cartridge", BlueprintCallable)
@@ -135,6 +179,28 @@ protected:
 
 	UPROPERTY(Category="Firing", EditDefaultsOnly)
 	float TraceDistance;
+
+	/**
+	 * If true, hit-scan shots follow a precomputed ballistic curve (drop) along TraceDistance instead of a straight line.
+	 * Cheaper than a projectile simulation, but does not account for time of flight.
+	 */
+	UPROPERTY(Category="Firing|Ballistics", EditDefaultsOnly)
+	bool bUseBallisticTrajectory;
+
+	/** Start velocity of the bullet in cm/s, used to build the trajectory table */
+	UPROPERTY(Category="Firing|Ballistics", EditDefaultsOnly, meta=(EditCondition=bUseBallisticTrajectory, ClampMin=1.f))
+	float MuzzleVelocity;
+
+	/** Quadratic drag (deceleration = DragCoefficient * Speed^2), used to build the trajectory table */
+	UPROPERTY(Category="Firing|Ballistics", EditDefaultsOnly, meta=(EditCondition=bUseBallisticTrajectory, ClampMin=0.f))
+	float DragCoefficient;
+
+	/** Number of straight trace segments along the curve. Trades accuracy against trace count. */
+	UPROPERTY(Category="Firing|Ballistics", EditDefaultsOnly, meta=(EditCondition=bUseBallisticTrajectory, ClampMin=1, ClampMax=32))
+	int32 TrajectorySegments;
+
+	/** Drop and time of flight table, lazily built on the default object */
+	mutable FTVRTrajectoryTable TrajectoryTable;
 	
 	UPROPERTY(Category="Firing", EditDefaultsOnly)
 	TMap< TEnumAsByte<EPhysicalSurface>, FImpactParticleData> ImpactParticles;
@@ -143,10 +209,10 @@ protected:
 	TMap< TEnumAsByte<EPhysicalSurface>, FImpactDecalData> ImpactDecals;
 	
 	UPROPERTY(Category="Firing", EditDefaultsOnly)
-	USoundBase* ImpactSound;
+	TSoftObjectPtr<USoundBase> ImpactSound;
 
 	UPROPERTY(Category="Firing", EditDefaultsOnly)
-	USoundBase* FlyBySound;
+	TSoftObjectPtr<USoundBase> FlyBySound;
 
 	UPROPERTY(Category="Firing", EditDefaultsOnly)
 	FRuntimeFloatCurve FlyBySoundVolume;
@@ -156,4 +222,11 @@ protected:
 
 	UPROPERTY(Category="Firing", EditDefaultsOnly)
 	float BaseDamage;
+
+	/** Relevancy and dormancy policy of this cartridge */
+	UPROPERTY(Category="Replication", EditDefaultsOnly)
+	FTVRNetRelevancyPolicy NetRelevancyPolicy;
+
+	/** World time of the last hit sound, used to throttle the sounds of bouncing casings */
+	float LastHitSoundTime;
 };
\ No newline at end of file
@@ -4,10 +4,83 @@
 
 #include "CoreMinimal.h"
 #include "Animation/AnimInstance.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "TVRTypes.h"
 #include "TVRGunAnimInstance.generated.h"
 
 enum class ETVRFireMode : uint8;
-enum class ETVRLeftRight : uint8;
+
+/**
+ * Compact snapshot of the gun state the animation depends on.
+ * The gun pushes it once per frame, so the anim instance does not need to call into the gun or its components.
+ */
+USTRUCT()
+struct TACTICALVRCORE_API FTVRGunAnimState
+{
+	GENERATED_BODY()
+
+	FTVRGunAnimState();
+
+	UPROPERTY()
+	float Trigger;
+	UPROPERTY()
+	float Bolt;
+	UPROPERTY()
+	float Hammer;
+	UPROPERTY()
+	float MagInsertionProgress;
+	UPROPERTY()
+	ETVRFireMode FiringMode;
+	UPROPERTY()
+	bool bMagazineReleasePressed;
+	UPROPERTY()
+	bool bBoltReleasePressed;
+	UPROPERTY()
+	bool bIsBoltLocked;
+
+	/** The charging handle values are only valid if the gun has a charging handle */
+	UPROPERTY()
+	bool bHasChargingHandle;
+	UPROPERTY()
+	bool bIsChargingHandleGrabbed;
+	UPROPERTY()
+	float ChargingHandle;
+	UPROPERTY()
+	float ChargingHandleStroke;
+	UPROPERTY()
+	ETVRLeftRight ChargingHandleGrabType;
+
+	bool operator==(const FTVRGunAnimState& Other) const;
+	bool operator!=(const FTVRGunAnimState& Other) const { return !(*this == Other); }
+};
+
+/**
+ * Runs the per frame work of the gun anim instance as part of the animation update. The snapshot of the gun is copied
+ * on the game thread before the update, the selector is interpolated on the worker thread with the rest of the graph.
+ */
+USTRUCT()
+struct TACTICALVRCORE_API FTVRGunAnimInstanceProxy : public FAnimInstanceProxy
+{
+	GENERATED_BODY()
+
+	FTVRGunAnimInstanceProxy();
+	FTVRGunAnimInstanceProxy(UAnimInstance* Instance);
+
+	virtual void PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds) override;
+	virtual void Update(float DeltaSeconds) override;
+	virtual void PostUpdate(UAnimInstance* InAnimInstance) const override;
+
+private:
+	float SelectorValue;
+	float SelectorTarget;
+	float SelectorLerpSpeed;
+	bool bSelectorInitialized;
+	bool bHasAnimState;
+
+	/** Time since the snapshot or the selector changed */
+	float TimeSinceChange;
+	float SettleTime;
+};
 
 /**
  * 
@@ -18,10 +91,26 @@ class TACTICALVRCORE_API UTVRGunAnimInstance : public UAnimInstance
 	GENERATED_BODY()
 
 	friend class ATVRGunBse;
+	friend struct FTVRGunAnimInstanceProxy;
 public:
     UTVRGunAnimInstance(const FObjectInitializer& OI);
-    
-    virtual void NativeUpdateAnimation(float DeltaSeconds) override;
+
+	/**
+	 * Stores the gun state to be applied on the next animation update. Called by the gun once per frame.
+	 * @param NewState Current state of the gun
+	 */
+	void SetAnimState(const FTVRGunAnimState& NewState);
+
+	/**
+	 * Forces the next animation update for changes that are not part of the snapshot, e.g. properties set directly.
+	 */
+	void MarkStateDirty() { bAnimStateDirty = true; }
+
+	/**
+	 * @returns true if the last update applied the current snapshot, the selector reached its target and no montage
+	 * is playing. Until the snapshot changes, further updates would produce the same pose.
+	 */
+	bool IsSettled() const;
 
 	virtual float GetSelectorTargetValue() const;
 	
@@ -63,6 +152,10 @@ public:
 
 	UPROPERTY(Category = "Gun", BlueprintReadOnly, EditDefaultsOnly)
 	float SelectorLerpSpeed;
+
+	/** Time the graph keeps updating after the last change, so blends inside of the graph can finish */
+	UPROPERTY(Category = "Gun", BlueprintReadOnly, EditDefaultsOnly)
+	float SettleTime;
 	
 	bool bSelectorInitialized;
 
@@ -79,4 +172,25 @@ public:
 	
 	UPROPERTY(Category = "Gun", BlueprintReadOnly, EditDefaultsOnly)
 	ETVRLeftRight ChargingHandleGrabType;
+
+protected:
+	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override;
+	virtual void DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy) override;
+
+	/**
+	 * Copies the pushed gun state into the properties read by the anim graph
+	 */
+	void ApplyAnimState();
+
+	/** Last state pushed by the gun */
+	FTVRGunAnimState AnimState;
+
+	/** true if the pushed state was not applied yet */
+	bool bAnimStateDirty;
+
+	/** true once the gun pushed its first state, the selector starts at the fire mode of that state */
+	bool bHasAnimState;
+
+	/** Written by the proxy after each update, see IsSettled */
+	bool bSettled;
 };
@@ -5,8 +5,10 @@
 #include "CoreMinimal.h"
 
 #include "Interfaces/TVRHandSocketInterface.h"
+#include "Interfaces/TVRPoolableInterface.h"
 #include "Grippables/GrippableStaticMeshActor.h"
 
+#include "Net/TVRNetRelevancyPolicy.h"
 #include "TVRGunBase.generated.h"
 
 UENUM(BlueprintType)
@@ -33,11 +35,20 @@ enum class ETVRGunClass : uint8
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnGunSecondaryUsedDelegate);
 
+/** Steps of the time sliced initialization of a gun, see UTVRGunWarmupSubsystem */
+enum class ETVRGunWarmupStage : uint8
+{
+	Attachments,
+	Magazine,
+	CartridgePool,
+	Done
+};
+
 /**
  * 
  */
 UCLASS(Abstract)
-class TACTICALVRCORE_API ATVRGunBase : public AGrippableStaticMeshActor, public ITVRHandSocketInterface
+class TACTICALVRCORE_API ATVRGunBase : public AGrippableStaticMeshActor, public ITVRHandSocketInterface, public ITVRPoolableInterface
 {
 	GENERATED_BODY()
 
@@ -52,14 +63,14 @@ class TACTICALVRCORE_API ATVRGunBase : public AGrippableStaticMeshActor, public
 	
 	UPROPERTY(Category="Gun", BlueprintReadOnly, EditDefaultsOnly, meta=(AllowPrivateAccess=true))
 	class UAudioComponent* GunManipulationAudioComponent;
+
+	/** Audio emitter for the sounds of the firing, magazine and ejection components */
+	UPROPERTY(Category="Gun", BlueprintReadOnly, EditDefaultsOnly, meta=(AllowPrivateAccess=true))
+	class UTVRGunAudioComponent* GunAudio;
 	
 	UPROPERTY(Category="Gun", BlueprintReadOnly, EditDefaultsOnly, meta=(AllowPrivateAccess=true))
 	class USkeletalMeshComponent* MovablePartsMesh;
 
-	
-	UPROPERTY()
-	class UAudioComponent* SelectorAudio;
-	
 public:
 
 	static FName PrimarySlotName;
@@ -108,18 +119,68 @@ protected:
 	float TwoHandAngularStiffness;
 	UPROPERTY(Category="Gun|Grip|TwoHand", EditDefaultsOnly)
 	float TwoHandAngularDamping;
+
+	/** Relevancy and dormancy policy of this gun */
+	UPROPERTY(Category="Replication", EditDefaultsOnly)
+	FTVRNetRelevancyPolicy NetRelevancyPolicy;
+
+	/**
+	 * Replaces the placed gun by a lightweight proxy on BeginPlay (see UTVRWeaponProxySubsystem).
+	 * The gun is spawned again as soon as a hand comes into grip range.
+	 */
+	UPROPERTY(Category="Gun", EditInstanceOnly)
+	bool bStartAsProxy;
 	
 public:
 	ATVRGunBase(const FObjectInitializer& OI);
 
 	virtual void OnConstruction(const FTransform& Transform) override;
 	virtual void InitAttachmentPoints();
+
+	/**
+	 * Decides if the heavy part of the initialization is deferred to the warm-up subsystem.
+	 * Called before the components BeginPlay.
+	 */
+	virtual void PostInitializeComponents() override;
 	
 	/**
 	 * Usually called when the actor is finished spawning
 	 */
 	virtual void BeginPlay() override;
 
+	/** True if the gun is not fully initialized yet (no starting magazine, casing pool not filled, ...) */
+	bool IsWarmupPending() const { return WarmupStage != ETVRGunWarmupStage::Done; }
+
+	/**
+	 * Runs the next step of the warm-up
+	 * @returns true if the warm-up is complete
+	 */
+	virtual bool WarmupStep();
+
+	/**
+	 * Runs all remaining warm-up steps right away, e.g. when the gun is gripped
+	 */
+	UFUNCTION(Category="Gun", BlueprintCallable)
+	void CompleteWarmup();
+
+	/**
+	 * Drops the gun, resets it to its spawn state and hides it. Only call on the authority, usually through
+	 * UTVRGunPoolSubsystem::ReleaseGun.
+	 */
+	virtual void ReturnToPool();
+
+	/**
+	 * Shows a pooled gun again. Only call on the authority, usually through UTVRGunPoolSubsystem::AcquireGun.
+	 * @param NewTransform World transform of the reissued gun
+	 */
+	virtual void IssueFromPool(const FTransform& NewTransform);
+
+	/** True while the gun is in a pool */
+	bool IsPooled() const { return bIsPooled; }
+
+	// PoolableInterface
+	virtual void ResetForPool_Implementation() override;
+
 	/**
 	 * Called every tick
 	 * @param DeltaSeconds Time between the last frame in seconds
@@ -131,9 +192,27 @@ public:
 	 */
 	virtual void BeginDestroy() override;
 
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	/** Pooled guns stay relevant while hidden, otherwise clients would destroy them and respawn them on issue */
+	virtual bool IsNetRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation) const override;
+
+	/** Called when the physics body of the gun went to sleep. Puts a loose gun to net dormancy. */
+	UFUNCTION()
+	virtual void OnRootBodySleep(UPrimitiveComponent* SleepingComponent, FName BoneName);
+	
+	/** Called when the physics body of the gun woke up (e.g. due to an impact). Wakes the gun from net dormancy. */
+	UFUNCTION()
+	virtual void OnRootBodyWake(UPrimitiveComponent* WakingComponent, FName BoneName);
+
 	virtual void TickBolt(float DeltaSeconds);
 	virtual void TickHammer(float DeltaSeconds);
 
+	/**
+	 * Pushes a snapshot of the gun state to the anim instance of the movable parts mesh
+	 */
+	virtual void UpdateAnimState();
+
 	virtual void CheckBoltEvents(float PreviousBoltProgress);
 	
 	UFUNCTION()
@@ -144,6 +223,8 @@ public:
 	
 	UFUNCTION(Category="Gun", BlueprintCallable)
 	class UTVRGunFireComponent* GetFiringComponent() const {return FiringComponent;}
+
+	class UTVRGunAudioComponent* GetGunAudio() const {return GunAudio;}
 	
 	// VRGripInterface
 	virtual void OnGrip_Implementation(UGripMotionControllerComponent* GrippingHand, const FBPActorGripInformation& GripInfo) override;
@@ -470,6 +551,9 @@ public:
 	
 	UFUNCTION(Category="Gun", BlueprintCallable)
 	void SetColorVariant(uint8 newVariant);
+
+	UFUNCTION(Category="Gun", BlueprintPure)
+	uint8 GetColorVariant() const {return ColorVariant;}
 	
 	UFUNCTION(Category="Gun", BlueprintImplementableEvent)
 	void OnColorVariantChanged(uint8 newVariant);	
@@ -509,6 +593,22 @@ protected:
 	UGS_GunTools* GripScript;
 	
     bool bSkipHandSwap;
+
+	/** Next step of the time sliced initialization */
+	ETVRGunWarmupStage WarmupStage;
+
+	/** True while the gun is in a pool */
+	UPROPERTY(ReplicatedUsing=OnRep_IsPooled)
+	bool bIsPooled;
+
+	/** Sets the pooled state on the server, clients follow through replication */
+	void SetPooled(bool bNewPooled);
+
+	UFUNCTION()
+	void OnRep_IsPooled();
+
+	/** Resets or reactivates the gun locally, the gun state is simulated on every machine */
+	void ApplyPooledState();
     
 	bool bIsSocketed;
 	bool bIsFiring;
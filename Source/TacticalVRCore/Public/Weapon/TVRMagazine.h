@@ -6,6 +6,8 @@
 #include "Components/BoxComponent.h"
 #include "Grippables/GrippableStaticMeshActor.h"
 #include "Interfaces/TVRHandSocketInterface.h"
+#include "Interfaces/TVRPoolableInterface.h"
+#include "Net/TVRNetRelevancyPolicy.h"
 #include "TVRMagazine.generated.h"
 
 
@@ -13,7 +15,7 @@
  * Gripable Magazine Actor base class. Only children shall be spawned.
  */
 UCLASS(Abstract)
-class TACTICALVRCORE_API ATVRMagazine : public AGrippableStaticMeshActor, public ITVRHandSocketInterface
+class TACTICALVRCORE_API ATVRMagazine : public AGrippableStaticMeshActor, public ITVRHandSocketInterface, public ITVRPoolableInterface
 {
     GENERATED_BODY()
 
@@ -33,6 +35,23 @@ public:
     virtual void BeginPlay() override;
 	virtual void Destroyed() override;
 	virtual void OnConstruction(const FTransform& Transform) override;
+	virtual void PostInitProperties() override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	/** Recycled magazines stay relevant while hidden, so clients keep the actor for reuse */
+	virtual bool IsNetRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation) const override;
+
+#if WITH_EDITOR
+	virtual void PreSave(const class ITargetPlatform* TargetPlatform) override;
+#endif
+
+	/** Called when the physics body of the magazine went to sleep. Puts a loose magazine to net dormancy. */
+	UFUNCTION()
+	virtual void OnRootBodySleep(UPrimitiveComponent* SleepingComponent, FName BoneName);
+	
+	/** Called when the physics body of the magazine woke up. Wakes the magazine from net dormancy. */
+	UFUNCTION()
+	virtual void OnRootBodyWake(UPrimitiveComponent* WakingComponent, FName BoneName);
 
     virtual void ClosestGripSlotInRange_Implementation(
         FVector WorldLocation,
@@ -144,6 +163,21 @@ public:
 
 	int32 GetAmmo() const {return CurrentAmmo;}
 
+	int32 GetAmmoCapacity() const {return AmmoCapacity;}
+
+	/**
+	 * Hides a magazine that was evicted by UTVRMagazineSubsystem, or shows it again when it is reused.
+	 * Only call on the authority, usually through the subsystem. Clients follow through replication.
+	 * @param bNewRecycled true to hide the magazine and reset it to its spawn state
+	 */
+	void SetRecycled(bool bNewRecycled);
+
+	/** True while the magazine waits for reuse in UTVRMagazineSubsystem */
+	bool IsRecycled() const { return bIsRecycled; }
+
+	// PoolableInterface
+	virtual void ResetForPool_Implementation() override;
+
     /**
      * Blueprint Event that is fired whenever the amount of ammo in the magazine has changed.
      */
@@ -195,6 +229,14 @@ public:
 	FTransform GetRoundTransform(int32 Index) const;
 	virtual FTransform GetRoundTransform_Implementation(int32 Index) const;
 
+	/**
+	 * Looks up the transform of a round in the data baked into the class on save.
+	 * Falls back to GetRoundTransform if the class has no baked data, e.g. because it overrides GetRoundTransform.
+	 * @param Index Index of the round
+	 * @return The transform of the round.
+	 */
+	FTransform GetBakedRoundTransform(int32 Index) const;
+
 	/**
 	 * Updates the transform of the follower
 	 */
@@ -272,6 +314,14 @@ public:
 	UPROPERTY(Category = "Magazine", EditDefaultsOnly)
 	FTransform FollowerRelativeTransform;
 
+	/**
+	 * Round transforms for 0 to AmmoCapacity rounds, baked into the class default object when it is saved or cooked.
+	 * Double stack magazines store a second set for an odd number of rounds. Only read from the default object,
+	 * instances drop their copy.
+	 */
+	UPROPERTY()
+	TArray<FTransform> BakedRoundTransforms;
+
 	/** NYI start index for the magazine taper, for tapered pistol mags */
 	UPROPERTY(Category = "Magazine", EditDefaultsOnly)
 	int32 TaperStartIdx;
@@ -286,6 +336,14 @@ public:
 protected:
 	UPROPERTY()
 	class UHandSocketComponent* HandSocket;
+
+	/** Relevancy and dormancy policy of this magazine */
+	UPROPERTY(Category="Replication", EditDefaultsOnly)
+	FTVRNetRelevancyPolicy NetRelevancyPolicy;
+
+	/** Replaces the placed magazine by a lightweight proxy on BeginPlay (see UTVRWeaponProxySubsystem) */
+	UPROPERTY(Category="Magazine", EditInstanceOnly)
+	bool bStartAsProxy;
 	
     /** Event Called on the magazine is fully ejected and is a physics body */
     UFUNCTION(Category = "Magazine", BlueprintImplementableEvent)
@@ -333,4 +391,14 @@ protected:
 	/** Array of mesh components of this magazine. Used when the collision of the entire magazine needs to be modified */
 	UPROPERTY()
 	TArray<UStaticMeshComponent*> MagazineMeshes;
+
+	/** True while the magazine waits for reuse */
+	UPROPERTY(ReplicatedUsing=OnRep_IsRecycled)
+	bool bIsRecycled;
+
+	UFUNCTION()
+	void OnRep_IsRecycled();
+
+	/** Hides and resets the magazine or shows it again locally */
+	void ApplyRecycledState();
 };
@@ -6,7 +6,13 @@
 #include "GameFramework/Actor.h"
 #include "TVRProjectile.generated.h"
 
-UCLASS()
+/**
+ * Describes the flight behaviour of a projectile fired from a cartridge with bIsProjectile set.
+ * Projectiles are simulated as plain data by the UTVRBallisticsSubsystem, so only the default object of this class
+ * is used and no instances are spawned. Slow projectiles like underbarrel grenades are set up the same way with a
+ * low muzzle velocity.
+ */
+UCLASS(Blueprintable)
 class TACTICALVRCORE_API ATVRProjectile : public AActor
 {
 	GENERATED_BODY()
@@ -15,12 +21,32 @@ public:
 	// Sets default values for this actor's properties
 	ATVRProjectile();
 
+	UFUNCTION(Category="Projectile", BlueprintCallable)
+	float GetMuzzleVelocity() const {return MuzzleVelocity;}
+	
+	UFUNCTION(Category="Projectile", BlueprintCallable)
+	float GetDragCoefficient() const {return DragCoefficient;}
+	
+	UFUNCTION(Category="Projectile", BlueprintCallable)
+	float GetGravityScale() const {return GravityScale;}
+	
+	UFUNCTION(Category="Projectile", BlueprintCallable)
+	float GetMaxLifeTime() const {return MaxLifeTime;}
+
 protected:
-	// Called when the game starts or when spawned
-	virtual void BeginPlay() override;
+	/** Initial speed of the projectile in cm/s. Will be scaled by the muzzle velocity modifier of attachments */
+	UPROPERTY(Category="Projectile", EditDefaultsOnly, meta=(ClampMin=0.f))
+	float MuzzleVelocity;
 
-public:	
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
+	/** Quadratic drag. The deceleration in cm/s^2 is DragCoefficient * Speed^2 */
+	UPROPERTY(Category="Projectile", EditDefaultsOnly, meta=(ClampMin=0.f))
+	float DragCoefficient;
+
+	/** Multiplier for the world gravity */
+	UPROPERTY(Category="Projectile", EditDefaultsOnly)
+	float GravityScale;
 
+	/** Time in s after which the projectile is removed if it has not hit anything */
+	UPROPERTY(Category="Projectile", EditDefaultsOnly, meta=(ClampMin=0.f))
+	float MaxLifeTime;
 };
@@ -0,0 +1,64 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TVRTrajectoryTable.generated.h"
+
+/**
+ * Precomputed flat fire trajectory of a cartridge. Stores the drop for equidistant samples
+ * along the bore axis, so that a shot can follow a ballistic curve without simulating a projectile.
+ */
+USTRUCT()
+struct TACTICALVRCORE_API FTVRTrajectoryTable
+{
+	GENERATED_BODY()
+
+	FTVRTrajectoryTable()
+	{
+		DistanceStep = 0.f;
+		GravityZ = 0.f;
+		bIsBuilt = false;
+	}
+
+	/** Distance in cm between two samples */
+	UPROPERTY()
+	float DistanceStep;
+
+	/** Gravity the table was built with */
+	UPROPERTY()
+	float GravityZ;
+
+	/** True once Build was called, even if the result is not valid */
+	bool bIsBuilt;
+
+	/** Drop in cm (positive values are downwards) for each sample */
+	UPROPERTY()
+	TArray<float> Drop;
+
+	/**
+	 * Integrates the trajectory of a horizontal shot and fills the table.
+	 * The table ends at the last sample the bullet reaches, so it can be shorter than MaxDistance.
+	 * @param MuzzleVelocity Start velocity in cm/s
+	 * @param DragCoefficient Quadratic drag coefficient (deceleration = DragCoefficient * Speed^2)
+	 * @param GravityZ Gravity in cm/s^2 (negative is downwards)
+	 * @param MaxDistance Distance covered by the table in cm
+	 * @param NumSamples Number of samples of the table
+	 */
+	void Build(float MuzzleVelocity, float DragCoefficient, float InGravityZ, float MaxDistance, int32 NumSamples);
+
+	/** @returns true if the table was built with the given gravity */
+	bool IsBuiltFor(float InGravityZ) const { return bIsBuilt && GravityZ == InGravityZ; }
+
+	/** @returns true if the table contains data */
+	bool IsValid() const { return Drop.Num() > 1 && DistanceStep > 0.f; }
+
+	/** @returns the distance in cm covered by the table */
+	float GetMaxDistance() const { return IsValid() ? DistanceStep * (Drop.Num() - 1) : 0.f; }
+
+	/** @returns the interpolated drop at the given distance in cm */
+	float GetDrop(float Distance) const { return Sample(Drop, Distance); }
+
+private:
+	float Sample(const TArray<float>& Values, float Distance) const;
+};
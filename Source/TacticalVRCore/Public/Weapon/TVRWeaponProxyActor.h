@@ -0,0 +1,123 @@
+// This file is covered by the LICENSE file in the root of this plugin.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "TVRWeaponProxyActor.generated.h"
+
+/**
+ * Visual representation of one dehydrated weapon
+ */
+USTRUCT()
+struct FTVRWeaponProxyInstance
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	class UStaticMesh* Mesh;
+
+	UPROPERTY()
+	FTransform Transform;
+
+	FTVRWeaponProxyInstance() : Mesh(nullptr) {}
+	FTVRWeaponProxyInstance(class UStaticMesh* InMesh, const FTransform& InTransform) : Mesh(InMesh), Transform(InTransform) {}
+};
+
+/**
+ * Local render state of one proxy instance, same index as the replicated instance
+ */
+struct FTVRWeaponProxyRenderInstance
+{
+	FTVRWeaponProxyRenderInstance() : Mesh(nullptr), MeshCompIdx(INDEX_NONE), MeshInstanceIdx(INDEX_NONE) {}
+
+	/** Mesh and transform the instance is currently rendered with */
+	class UStaticMesh* Mesh;
+	FTransform Transform;
+
+	/** Index into MeshComponents */
+	int32 MeshCompIdx;
+
+	/** Index of the instance in the instanced mesh component */
+	int32 MeshInstanceIdx;
+};
+
+/**
+ * Renders all dehydrated weapons of a level as instanced static meshes without collision.
+ * Spawned and filled on the authority by UTVRWeaponProxySubsystem. Instances are added and removed one at a time, and
+ * clients only update the instances that changed on replication.
+ */
+UCLASS(NotPlaceable, NotBlueprintable)
+class TACTICALVRCORE_API ATVRWeaponProxyActor : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ATVRWeaponProxyActor(const FObjectInitializer& OI);
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	/**
+	 * Adds a proxy instance. Only call on the authority.
+	 * @param Mesh Static mesh of the weapon
+	 * @param Transform World transform of the weapon
+	 */
+	void AddInstance(class UStaticMesh* Mesh, const FTransform& Transform);
+
+	/**
+	 * Removes a proxy instance, the last instance takes its index. Only call on the authority.
+	 * @param Idx Index of the instance
+	 */
+	void RemoveInstanceAtSwap(int32 Idx);
+
+	int32 GetNumInstances() const { return Instances.Num(); }
+
+protected:
+	UFUNCTION()
+	void OnRep_Instances();
+
+	/**
+	 * Appends a render instance for the last entry of the instance list
+	 */
+	void AddRenderInstance();
+
+	/**
+	 * Removes a render instance, the last render instance takes its index like in the instance list
+	 * @param Idx Index of the instance
+	 */
+	void RemoveRenderInstanceAtSwap(int32 Idx);
+
+	/**
+	 * Renders an instance with a mesh and transform, only touches the instanced mesh components when they changed
+	 * @param Idx Index of the instance
+	 * @param Mesh Static mesh of the weapon
+	 * @param Transform World transform of the weapon
+	 */
+	void SetRenderInstance(int32 Idx, class UStaticMesh* Mesh, const FTransform& Transform);
+
+	/**
+	 * Removes the instance from its instanced mesh component. The last instance of the component is moved into
+	 * the freed slot, so no other instance changes its index.
+	 * @param Idx Index of the instance
+	 */
+	void ReleaseMeshInstance(int32 Idx);
+
+	/**
+	 * @param Mesh Static mesh of a weapon
+	 * @returns index into MeshComponents of the component rendering the mesh, creates it if needed
+	 */
+	int32 FindOrAddMeshComponent(class UStaticMesh* Mesh);
+
+	UPROPERTY(ReplicatedUsing=OnRep_Instances)
+	TArray<FTVRWeaponProxyInstance> Instances;
+
+	/** One instanced mesh component per weapon mesh */
+	UPROPERTY(Transient)
+	TArray<class UInstancedStaticMeshComponent*> MeshComponents;
+
+	/** For each mesh component, the index in Instances of each of its instances */
+	TArray<TArray<int32>> MeshInstanceOwners;
+
+	/** What is rendered locally for each entry of Instances, empty on dedicated servers */
+	TArray<FTVRWeaponProxyRenderInstance> RenderInstances;
+};
@@ -36,6 +36,7 @@ public class TacticalVRCore : ModuleRules
 				"HeadMountedDisplay",
 				"VRExpansionPlugin",
 				"OpenXRExpansionPlugin",
+				"ReplicationGraph",
 			});
 			
 		